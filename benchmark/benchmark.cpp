@@ -1,9 +1,13 @@
 // Copyright (c) Michael G. Kazakov. All rights reserved. Distributed under the MIT License.
 #include <cstddef>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <algorithm>
+#include <atomic>
 #include <chrono>
-#include <execution>
+#include <new>
 #include <vector>
 #include <array>
 #include <iostream>
@@ -14,6 +18,56 @@ static constexpr size_t g_Iterations = 10;
 static constexpr size_t g_IterationsDiscard = 1;
 static constexpr size_t g_Sizes[] = {1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000};
 
+// Heap allocations made by all threads of the process, reported with --allocations
+static std::atomic<size_t> g_Allocations{0};
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    g_Allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new(size_t size)
+{
+    if( void *ptr = operator new(size, std::nothrow) )
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void *operator new(size_t size, std::align_val_t align, const std::nothrow_t &) noexcept
+{
+    g_Allocations.fetch_add(1, std::memory_order_relaxed);
+    const size_t alignment = static_cast<size_t>(align);
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+void *operator new(size_t size, std::align_val_t align)
+{
+    if( void *ptr = operator new(size, align, std::nothrow) )
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
 template <class Tp>
 inline void noopt(Tp const &value)
 {
@@ -26,26 +80,45 @@ inline void noopt(Tp &value)
     asm volatile("" : "+r,m"(value) : : "memory");
 }
 
+// Wall time, CPU time and heap allocations of all threads of the process
+struct Measurement {
+    std::chrono::steady_clock::duration wall{};
+    std::chrono::duration<double> cpu{};
+    size_t allocations{};
+};
+
 template <class Setup, class Work, class Cleanup>
-std::chrono::steady_clock::duration measure(Setup setup, Work work, Cleanup cleanup)
+Measurement measure(Setup setup, Work work, Cleanup cleanup)
 {
-    std::array<std::chrono::steady_clock::duration, g_Iterations> runs;
+    std::array<Measurement, g_Iterations> runs;
     for( size_t i = 0; i != g_Iterations; ++i ) {
         setup();
+        const auto allocations_start = g_Allocations.load();
+        const auto cpu_start = std::clock();
         const auto start = std::chrono::steady_clock::now();
         work();
         const auto end = std::chrono::steady_clock::now();
+        const auto cpu_end = std::clock();
+        const auto allocations_end = g_Allocations.load();
         cleanup();
-        runs[i] = end - start;
+        runs[i].wall = end - start;
+        runs[i].cpu = std::chrono::duration<double>(double(cpu_end - cpu_start) / CLOCKS_PER_SEC);
+        runs[i].allocations = allocations_end - allocations_start;
     }
-    std::sort(runs.begin(), runs.end());
+    std::sort(runs.begin(), runs.end(), [](auto &a, auto &b) { return a.wall < b.wall; });
     return std::accumulate(runs.begin() + g_IterationsDiscard,
                            runs.end() - g_IterationsDiscard,
-                           std::chrono::steady_clock::duration{});
+                           Measurement{},
+                           [](Measurement a, const Measurement &b) {
+                               a.wall += b.wall;
+                               a.cpu += b.cpu;
+                               a.allocations += b.allocations;
+                               return a;
+                           });
 }
 
 template <class Setup, class Work>
-std::chrono::steady_clock::duration measure(Setup setup, Work work)
+Measurement measure(Setup setup, Work work)
 {
     return measure(setup, work, [] {});
 }
@@ -208,6 +281,42 @@ struct copy { // 25.7.1
     }
 };
 
+// Keeps about 'percent' per cent of semi-random input
+template <class ExPo>
+auto measure_copy_if(size_t size, double percent)
+{
+    std::vector<double> v1, v2;
+    return measure(
+        [&] {
+            std::mt19937 mt{42};
+            std::uniform_real_distribution<double> dist{0., 100.};
+            v1 = std::vector<double>(size);
+            v2 = std::vector<double>(size);
+            std::generate(std::begin(v1), std::end(v1), [&dist, &mt] { return dist(mt); });
+        },
+        [&] {
+            std::copy_if(ExPo{}, v1.begin(), v1.end(), v2.begin(), [percent](double d) {
+                return d < percent;
+            });
+            noopt(v2);
+        });
+}
+
+template <class ExPo>
+struct copy_if_Low { // 25.7.1, 1% selectivity
+    auto operator()(size_t size) { return measure_copy_if<ExPo>(size, 1.); }
+};
+
+template <class ExPo>
+struct copy_if_Med { // 25.7.1, 50% selectivity
+    auto operator()(size_t size) { return measure_copy_if<ExPo>(size, 50.); }
+};
+
+template <class ExPo>
+struct copy_if_High { // 25.7.1, 99% selectivity
+    auto operator()(size_t size) { return measure_copy_if<ExPo>(size, 99.); }
+};
+
 template <class ExPo>
 struct move { // 25.7.2
     auto operator()(size_t size)
@@ -695,6 +804,8 @@ static std::string demangle()
 struct Result {
     std::string name;
     std::array<double, std::size(g_Sizes)> speedups;
+    std::array<double, std::size(g_Sizes)> cpu_costs;
+    std::array<double, std::size(g_Sizes)> allocations;
 };
 
 template <template <class> class Benchmark>
@@ -707,13 +818,26 @@ Result record()
     using Par = Benchmark<std::execution::parallel_policy>;
     Result r;
     r.name = benchmarks::demangle<Seq>();
-    for( size_t i = 0; i != std::size(g_Sizes); ++i )
-        r.speedups[i] = micro(Seq{}(g_Sizes[i])) / micro(Par{}(g_Sizes[i]));
+    for( size_t i = 0; i != std::size(g_Sizes); ++i ) {
+        const Measurement seq = Seq{}(g_Sizes[i]);
+        const Measurement par = Par{}(g_Sizes[i]);
+        r.speedups[i] = micro(seq.wall) / micro(par.wall);
+        r.cpu_costs[i] = micro(par.cpu) / std::max(micro(seq.cpu), 1.);
+        r.allocations[i] = double(par.allocations) / (g_Iterations - 2 * g_IterationsDiscard);
+    }
     return r;
 }
 
-int main()
+int main(int argc, char **argv)
 {
+    bool print_allocations = false;
+    for( int i = 1; i < argc; ++i ) {
+        if( std::strcmp(argv[i], "--allocations") == 0 )
+            print_allocations = true;
+        else if( std::strcmp(argv[i], "--no-huge-pages") == 0 )
+            pstld::set_huge_pages(false);
+    }
+
     std::vector<Result> results;
     results.emplace_back(record<benchmarks::all_of>());
     results.emplace_back(record<benchmarks::any_of>());
@@ -728,6 +852,9 @@ int main()
     results.emplace_back(record<benchmarks::equal>());
     results.emplace_back(record<benchmarks::search>());
     results.emplace_back(record<benchmarks::copy>());
+    results.emplace_back(record<benchmarks::copy_if_Low>());
+    results.emplace_back(record<benchmarks::copy_if_Med>());
+    results.emplace_back(record<benchmarks::copy_if_High>());
     results.emplace_back(record<benchmarks::move>());
     results.emplace_back(record<benchmarks::swap_ranges>());
     results.emplace_back(record<benchmarks::transform>());
@@ -762,19 +889,45 @@ int main()
             return a.name.length() < b.name.length();
         })->name.length();
 
-    printf("%*s", int(max_name_len + 1), "");
-    for( auto s : g_Sizes ) {
-        if( s >= 1'000'000 )
-            printf("%4luM ", s / 1'000'000);
-        else if( s >= 1'000 )
-            printf("%4luK ", s / 1'000);
-    }
-    printf("\n");
+    auto print_header = [&](const char *title) {
+        printf("%-*s", int(max_name_len + 1), title);
+        for( auto s : g_Sizes ) {
+            if( s >= 1'000'000 )
+                printf("%4luM ", s / 1'000'000);
+            else if( s >= 1'000 )
+                printf("%4luK ", s / 1'000);
+        }
+        printf("\n");
+    };
 
+    // wall time of the sequential version divided by the wall time of the parallel version
+    print_header("Speedup");
     for( auto &r : results ) {
         printf("%-*s ", int(max_name_len), r.name.c_str());
         for( auto v : r.speedups )
             printf("%5.2f ", v);
         printf("\n");
     }
+
+    // CPU time of the parallel version divided by the CPU time of the sequential version
+    printf("\n");
+    print_header("CPU cost");
+    for( auto &r : results ) {
+        printf("%-*s ", int(max_name_len), r.name.c_str());
+        for( auto v : r.cpu_costs )
+            printf("%5.2f ", v);
+        printf("\n");
+    }
+
+    // heap allocations per call of the parallel version, which should be zero in a steady state
+    if( print_allocations ) {
+        printf("\n");
+        print_header("Allocations");
+        for( auto &r : results ) {
+            printf("%-*s ", int(max_name_len), r.name.c_str());
+            for( auto v : r.allocations )
+                printf("%5.1f ", v);
+            printf("\n");
+        }
+    }
 }
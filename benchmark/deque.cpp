@@ -0,0 +1,249 @@
+// Copyright (c) Michael G. Kazakov. All rights reserved. Distributed under the MIT License.
+// A steal-heavy microbenchmark of the work-stealing deque: the owner pushes work items and
+// occasionally pops one back while a number of thieves keep stealing from the top.
+#include <pstld/pstld.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static constexpr size_t g_Items = 2'000'000;
+static constexpr size_t g_Iterations = 5;
+static constexpr size_t g_PopEvery = 4;
+
+// The previous deque implementation, kept as the baseline: thieves take a mutex and retain the
+// array for every steal attempt, all atomics are sequentially consistent.
+namespace legacy {
+
+template <class T>
+struct CircularArray {
+    static_assert(std::is_trivial_v<T>);
+    static constexpr size_t default_log_size = 6;
+
+    size_t m_log_size;
+    std::atomic_int64_t m_ref_count;
+
+    static CircularArray *alloc(size_t log_size = default_log_size)
+    {
+        static_assert(sizeof(T) >= sizeof(CircularArray));
+
+        size_t count = static_cast<size_t>(1) << log_size;
+        size_t bytes = sizeof(T) * (count + 1);
+
+        auto buffer = static_cast<CircularArray *>(::operator new(bytes));
+        buffer->m_log_size = log_size;
+        buffer->m_ref_count = 1;
+        return buffer;
+    }
+
+    void retain() noexcept { ++m_ref_count; }
+
+    void release() noexcept
+    {
+        if( --m_ref_count == 0 )
+            ::operator delete(this);
+    }
+
+    T &operator[](size_t ind) noexcept
+    {
+        auto elements = reinterpret_cast<T *>(this) + 1;
+        auto mask = (static_cast<size_t>(1) << m_log_size) - 1;
+        return elements[ind & mask];
+    }
+
+    constexpr size_t size() noexcept { return static_cast<size_t>(1) << m_log_size; }
+
+    CircularArray *grow(size_t bottom, size_t top)
+    {
+        auto grown = alloc(m_log_size + 1);
+        for( size_t ind = top; ind != bottom; ++ind )
+            (*grown)[ind] = (*this)[ind];
+        return grown;
+    }
+};
+
+template <class T>
+struct alignas(pstld::internal::hardware_destructive_interference_size)
+    CircularWorkStealingDeque {
+    std::atomic<size_t> m_bottom{0};
+    std::atomic<size_t> m_top{0};
+    CircularArray<T> *m_array{CircularArray<T>::alloc()};
+    std::mutex m_mut;
+
+    CircularWorkStealingDeque() = default;
+    CircularWorkStealingDeque(const CircularWorkStealingDeque &) = delete;
+    CircularWorkStealingDeque &operator=(const CircularWorkStealingDeque &) = delete;
+    ~CircularWorkStealingDeque() { m_array->release(); }
+
+    void push_bottom(const T &val)
+    {
+        size_t bottom = m_bottom.load();
+        size_t top = m_top.load();
+        size_t size = bottom - top;
+        if( size >= m_array->size() ) {
+            CircularArray<T> *grown = m_array->grow(bottom, top);
+            CircularArray<T> *current;
+            {
+                std::lock_guard lock{m_mut};
+                current = std::exchange(m_array, grown);
+            }
+            current->release();
+        }
+        (*m_array)[bottom] = val;
+        m_bottom.store(bottom + 1);
+    }
+
+    bool pop_bottom(T &val) noexcept
+    {
+        size_t bottom = m_bottom.load();
+        if( bottom == 0 )
+            return false;
+        --bottom;
+        m_bottom.store(bottom);
+        size_t top = m_top.load();
+        if( bottom < top ) {
+            m_bottom.store(top);
+            return false;
+        }
+
+        val = (*m_array)[bottom];
+
+        if( bottom > top )
+            return true;
+
+        if( m_top.compare_exchange_strong(top, top + 1) ) {
+            m_bottom.store(top + 1);
+            return true;
+        }
+        else {
+            m_bottom.store(top);
+            return false;
+        }
+    }
+
+    bool steal_top(T &val) noexcept
+    {
+        size_t top = m_top.load();
+        while( true ) {
+            if( m_bottom.load() <= top )
+                return false;
+            CircularArray<T> *current;
+            {
+                std::lock_guard lock{m_mut};
+                current = m_array;
+                current->retain();
+            }
+            val = (*current)[top];
+            current->release();
+            if( m_top.compare_exchange_strong(top, top + 1) )
+                return true;
+        }
+    }
+};
+
+} // namespace legacy
+
+// Same layout as the work items of Sort
+struct Work {
+    size_t first;
+    size_t last;
+    size_t depth;
+};
+
+template <class Deque>
+double run(size_t thieves) // returns millions of items per second
+{
+    Deque deque;
+    std::atomic<bool> done{false};
+    std::atomic<size_t> started{0};
+    std::vector<size_t> taken(thieves + 1, 0);
+    std::vector<size_t> sums(thieves + 1, 0);
+
+    std::vector<std::thread> threads;
+    for( size_t t = 0; t != thieves; ++t )
+        threads.emplace_back([&, t] {
+            started.fetch_add(1);
+            size_t count = 0;
+            size_t sum = 0;
+            Work work;
+            while( true ) {
+                if( deque.steal_top(work) ) {
+                    ++count;
+                    sum += work.first;
+                }
+                else if( done.load(std::memory_order_acquire) ) {
+                    break;
+                }
+            }
+            taken[t] = count;
+            sums[t] = sum;
+        });
+    while( started.load() != thieves )
+        std::this_thread::yield();
+
+    const auto start = std::chrono::steady_clock::now();
+    size_t count = 0;
+    size_t sum = 0;
+    Work work;
+    for( size_t i = 0; i != g_Items; ++i ) {
+        deque.push_bottom(Work{i, i + 1, 0});
+        if( i % g_PopEvery == 0 && deque.pop_bottom(work) ) {
+            ++count;
+            sum += work.first;
+        }
+    }
+    while( deque.pop_bottom(work) ) {
+        ++count;
+        sum += work.first;
+    }
+    done.store(true, std::memory_order_release);
+    for( auto &thread : threads )
+        thread.join();
+    const auto end = std::chrono::steady_clock::now();
+    taken[thieves] = count;
+    sums[thieves] = sum;
+
+    size_t total = 0;
+    size_t total_sum = 0;
+    for( size_t t = 0; t <= thieves; ++t ) {
+        total += taken[t];
+        total_sum += sums[t];
+    }
+    if( total != g_Items || total_sum != g_Items * (g_Items - 1) / 2 ) {
+        std::fprintf(stderr, "lost or duplicated work items\n");
+        std::exit(1);
+    }
+
+    return double(g_Items) / std::chrono::duration<double>(end - start).count() / 1'000'000.;
+}
+
+template <class Deque>
+double best_of(size_t thieves)
+{
+    double best = 0.;
+    for( size_t i = 0; i != g_Iterations; ++i )
+        best = std::max(best, run<Deque>(thieves));
+    return best;
+}
+
+int main()
+{
+    const size_t hw = std::max(std::thread::hardware_concurrency(), 2u);
+    std::vector<size_t> thieves;
+    for( size_t t = 1; t < hw; t *= 2 )
+        thieves.push_back(t);
+    if( thieves.back() != hw - 1 )
+        thieves.push_back(hw - 1);
+
+    std::printf("%-8s %14s %14s %8s\n", "Thieves", "Mutex, Mit/s", "Lock-free", "Speedup");
+    for( size_t t : thieves ) {
+        const double old_rate = best_of<legacy::CircularWorkStealingDeque<Work>>(t);
+        const double new_rate = best_of<pstld::internal::CircularWorkStealingDeque<Work>>(t);
+        std::printf("%-8zu %14.2f %14.2f %8.2f\n", t, old_rate, new_rate, new_rate / old_rate);
+    }
+}
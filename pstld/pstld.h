@@ -2,8 +2,26 @@
 #pragma once
 
 #if defined(PSTLD_INTERNAL_DO_HACK_INTO_STD) || defined(PSTLD_INTERNAL_HEADER_ONLY) ||             \
-    defined(PSTLD_INTERNAL_IMPL) || defined(PSTLD_INTERNAL_ARC)
-    #error internal settings can't be defined manually
+    defined(PSTLD_INTERNAL_IMPL) || defined(PSTLD_INTERNAL_ARC) ||                                 \
+    defined(PSTLD_INTERNAL_BACKEND_DISPATCH) || defined(PSTLD_INTERNAL_BACKEND_THREADS)
+    #error internal settings cannot be defined manually
+#endif
+
+#if defined(PSTLD_BACKEND_DISPATCH) && defined(PSTLD_BACKEND_THREADS)
+    #error PSTLD_BACKEND_DISPATCH and PSTLD_BACKEND_THREADS are mutually exclusive
+#endif
+
+// libdispatch is the default scheduler on Apple platforms, everywhere else pstld falls back to its
+// own pool of std::thread workers. Either can be forced via PSTLD_BACKEND_DISPATCH or
+// PSTLD_BACKEND_THREADS.
+#if defined(PSTLD_BACKEND_DISPATCH)
+    #define PSTLD_INTERNAL_BACKEND_DISPATCH
+#elif defined(PSTLD_BACKEND_THREADS)
+    #define PSTLD_INTERNAL_BACKEND_THREADS
+#elif defined(__APPLE__)
+    #define PSTLD_INTERNAL_BACKEND_DISPATCH
+#else
+    #define PSTLD_INTERNAL_BACKEND_THREADS
 #endif
 
 #if defined(PSTLD_HACK_INTO_STD)
@@ -20,11 +38,13 @@
     #define PSTLD_INTERNAL_IMPL
 #endif
 
-#if defined(PSTLD_INTERNAL_HEADER_ONLY) && __has_feature(objc_arc)
-    #define PSTLD_INTERNAL_ARC
+#if defined(PSTLD_INTERNAL_HEADER_ONLY) && defined(__has_feature)
+    #if __has_feature(objc_arc)
+        #define PSTLD_INTERNAL_ARC
+    #endif
 #endif
 
-#if defined(PSTLD_INTERNAL_HEADER_ONLY)
+#if defined(PSTLD_INTERNAL_HEADER_ONLY) && defined(PSTLD_INTERNAL_BACKEND_DISPATCH)
     #include <dispatch/dispatch.h>
 #endif
 
@@ -33,11 +53,20 @@
 #include <iterator>
 #include <vector>
 #include <limits>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <thread>
 #include <type_traits>
 #include <atomic>
+#include <utility>
+#include <tuple>
+#include <condition_variable>
+#include <optional>
+#include <chrono>
 
 namespace pstld {
 
@@ -49,3743 +78,9799 @@ inline namespace arc {
 
 //--------------------------------------------------------------------------------------------------
 //
-// Common facilities
+// Executors
 //
 //--------------------------------------------------------------------------------------------------
 
-namespace internal {
+// An external scheduler which pstld can run its work on instead of the built-in backend, e.g. a
+// thread pool already owned by the application. The functions receive 'context' as their first
+// argument:
+// - bulk_execute must invoke fn(ctx, i) for every i in [0, n) and return once all of them are done;
+// - async must eventually invoke fn(ctx) even if the submitting thread blocks meanwhile;
+// - concurrency reports how many threads the executor can run simultaneously.
+struct executor {
+    void *context = nullptr;
+    void (*bulk_execute)(void *context,
+                         size_t n,
+                         void *ctx,
+                         void (*fn)(void *ctx, size_t ind)) noexcept = nullptr;
+    void (*async)(void *context, void *ctx, void (*fn)(void *ctx)) noexcept = nullptr;
+    size_t (*concurrency)(void *context) noexcept = nullptr;
+};
 
-inline constexpr size_t chunks_per_cpu = 8;
-inline constexpr size_t insertion_sort_limit = 32;
-inline constexpr size_t merge_parallel_limit = 8192;
-inline constexpr size_t hardware_destructive_interference_size = 128; // or 64 on x86
+// Wraps any object providing the following member functions:
+// - void bulk_execute(size_t n, void *ctx, void (*fn)(void *, size_t)) noexcept;
+// - void async(void *ctx, void (*fn)(void *)) noexcept;
+// - size_t concurrency() const noexcept;
+// The object must outlive the returned executor.
+template <class Pool>
+executor make_executor(Pool &pool) noexcept
+{
+    executor e;
+    e.context = static_cast<void *>(&pool);
+    e.bulk_execute = [](void *context, size_t n, void *ctx, void (*fn)(void *, size_t)) noexcept {
+        static_cast<Pool *>(context)->bulk_execute(n, ctx, fn);
+    };
+    e.async = [](void *context, void *ctx, void (*fn)(void *)) noexcept {
+        static_cast<Pool *>(context)->async(ctx, fn);
+    };
+    e.concurrency = [](void *context) noexcept -> size_t {
+        return static_cast<Pool *>(context)->concurrency();
+    };
+    return e;
+}
 
-size_t max_hw_threads() noexcept;
+// Installs an executor used by all parallel calls which don't specify one explicitly. nullptr
+// restores the built-in backend. The executor is not copied and must stay alive while installed.
+void set_default_executor(const executor *e) noexcept;
+const executor *default_executor() noexcept;
 
-void dispatch_apply(size_t iterations, void *ctx, void (*function)(void *, size_t)) noexcept;
-void dispatch_async(void *ctx, void (*function)(void *)) noexcept;
+//--------------------------------------------------------------------------------------------------
+//
+// CPU topology
+//
+//--------------------------------------------------------------------------------------------------
 
-class DispatchGroup
-{
-public:
-    DispatchGroup() noexcept;
-    DispatchGroup(const DispatchGroup &) = delete;
-    ~DispatchGroup();
+// The hardware resources available to the process, as discovered by pstld. On Linux the affinity
+// mask and the cgroup CPU bandwidth limit are taken into account, so the numbers reflect what a
+// container is actually allowed to use rather than what the host has.
+struct cpu_topology {
+    size_t logical_cpus = 1;   // logical CPUs configured in the system
+    size_t usable_cpus = 1;    // logical CPUs the process may run on
+    size_t physical_cores = 1; // distinct physical cores among the usable CPUs
+    size_t smt_per_core = 1;   // hardware threads per physical core
+    size_t numa_nodes = 1;     // online NUMA nodes
+    double cpu_quota = 0.;     // CPUs granted by the cgroup bandwidth limit, 0 means unlimited
+    size_t workers = 1;        // the number of workers the parallel calls are sized for
+};
 
-    void dispatch(void *ctx, void (*function)(void *)) noexcept;
-    void wait() noexcept;
+// Returns the topology discovered on the first use of pstld.
+cpu_topology topology() noexcept;
 
-private:
-#if defined(PSTLD_INTERNAL_ARC)
-    __strong dispatch_group_t m_group;
-    __strong dispatch_queue_global_t m_queue;
-#else
-    void *m_group;
-    void *m_queue;
-#endif
-};
+// Discovers the topology again, e.g. after the affinity mask or the container limits were changed.
+// Subsequent calls size their chunks and workers according to the new numbers. The built-in thread
+// pool doesn't grow beyond the size it was created with though.
+cpu_topology refresh_topology() noexcept;
 
-template <class It>
-using iterator_category_t = typename std::iterator_traits<It>::iterator_category;
+//--------------------------------------------------------------------------------------------------
+//
+// Cost model
+//
+//--------------------------------------------------------------------------------------------------
 
-template <class It>
-inline constexpr bool is_random_iterator_v =
-    std::is_convertible_v<iterator_category_t<It>, std::random_access_iterator_tag>;
+// The measured properties of the host which decide whether a call is worth being parallelized. A
+// call runs serially unless its estimated serial time, derived from the number of elements and a
+// per-algorithm cost of an element, exceeds the overhead of going parallel with a safe margin.
+// Calls running on an application's executor or with the serial_below property bypass the model.
+struct cost_profile {
+    double fork_join_ns = 0.; // the duration of an empty parallel call on the built-in backend
+};
 
-template <class It>
-inline constexpr bool is_bidirectional_iterator_v =
-    std::is_convertible_v<iterator_category_t<It>, std::bidirectional_iterator_tag>;
+// Returns the profile in use. On the first use a worker of the built-in backend reads the profile
+// from the file named by the PSTLD_COST_PROFILE environment variable. If the variable isn't set or
+// the file can't be read, the worker measures the overhead by a short probe and saves the result
+// into that file if it's named and doesn't exist yet. Until then the profile holds a pessimistic
+// overhead, so the calls made meanwhile lean towards running serially.
+cost_profile current_cost_profile() noexcept;
 
-template <class It>
-using iterator_value_t = typename std::iterator_traits<It>::value_type;
+// Replaces the profile in use, e.g. with one measured by a previous run.
+void set_cost_profile(const cost_profile &profile) noexcept;
 
-template <class It>
-using iterator_diff_t = typename std::iterator_traits<It>::difference_type;
+// Runs the probe again, installs its result and returns it.
+cost_profile calibrate_cost_profile() noexcept;
 
-template <class T>
-inline constexpr bool can_be_atomic_v = std::conjunction_v<std::is_trivially_copyable<T>,
-                                                           std::is_copy_constructible<T>,
-                                                           std::is_move_constructible<T>,
-                                                           std::is_copy_assignable<T>,
-                                                           std::is_move_assignable<T>>;
+// Writes the profile in use into a file. Returns false if the file can't be written.
+bool save_cost_profile(const char *path) noexcept;
 
-struct no_op {
-    template <typename T>
-    T &&operator()(T &&v) const
-    {
-        return std::forward<T>(v);
-    }
-};
+// Reads a profile from a file and installs it. Returns false if the file can't be read or parsed.
+bool load_cost_profile(const char *path) noexcept;
 
-struct parallelism_exception : std::exception {
-    const char *what() const noexcept override;
-    [[noreturn]] static void raise();
-};
+//--------------------------------------------------------------------------------------------------
+//
+// Execution policy properties
+//
+//--------------------------------------------------------------------------------------------------
 
-template <class T>
-struct parallelism_allocator {
-    using value_type = T;
-    using size_type = size_t;
-    using difference_type = ptrdiff_t;
+namespace execution {
 
-    T *allocate(size_t count)
-    {
-        if( void *ptr = ::operator new(count * sizeof(T), std::nothrow) )
-            return static_cast<T *>(ptr);
-        else
-            parallelism_exception::raise();
-    }
+// Controls how the idle workers of sort, merge and task groups wait for more work to appear. A
+// worker which found nothing to do first spins with an exponential backoff for 'spins' rounds, then
+// yields its time slice for 'yields' rounds and after that parks until new work is forked or the
+// whole computation completes. With 'park' set to false the worker keeps on yielding instead.
+struct idle_strategy {
+    size_t spins = 6;
+    size_t yields = 16;
+    bool park = true;
+};
 
-    void deallocate(T *ptr, size_t count) noexcept { ::operator delete(ptr, count * sizeof(T)); }
+// The minimal number of elements a chunk of work should contain. A larger grain reduces the
+// scheduling overhead for cheap per-element operations.
+struct grain {
+    size_t elements = 1;
+};
 
-    template <class Other>
-    bool operator==(const parallelism_allocator<Other> &) const noexcept
-    {
-        return true;
-    }
+// How many chunks per worker the input is split into. More chunks balance expensive or uneven
+// per-element operations better, fewer chunks reduce the overhead for cheap ones.
+struct chunks_per_cpu {
+    size_t chunks = 8;
+};
 
-    template <class Other>
-    bool operator!=(const parallelism_allocator<Other> &) const noexcept
-    {
-        return false;
-    }
+// The priority class the work of a call is executed with. The dispatch backend maps it onto the QoS
+// classes of the global queues. The built-in thread pool runs the background and utility classes on
+// separate workers with a lowered scheduling priority, so that batch work doesn't steal CPU from
+// latency-critical work, and gives the other classes their own queues in a shared pool, drained
+// most urgent first, so that urgent work doesn't queue behind the rest. The part of the work
+// executed by the calling thread runs at the caller's own priority.
+enum class priority {
+    background,
+    utility,
+    normal,
+    user_initiated,
+    user_interactive
 };
 
-template <class T>
-using parallelism_vector = std::vector<T, parallelism_allocator<T>>;
+// Inputs with fewer elements than this are processed serially. Overrides the cost model, so
+// serial_below{0} makes every call go parallel regardless of its size.
+struct serial_below {
+    size_t elements = 0;
+};
 
-template <class T>
-struct unitialized_array : parallelism_allocator<T> {
-    using allocator = parallelism_allocator<T>;
-    T *m_data;
-    size_t m_size;
-    unitialized_array(size_t size) : m_data(allocator::allocate(size)), m_size(size) {}
+} // namespace execution
 
-    ~unitialized_array()
-    {
-        std::destroy(m_data, m_data + m_size);
-        allocator::deallocate(m_data, m_size);
-    }
+//--------------------------------------------------------------------------------------------------
+//
+// Arenas
+//
+//--------------------------------------------------------------------------------------------------
 
-    template <class... Args>
-    void put(size_t ind, Args &&...vals) noexcept
-    {
-        ::new(m_data + ind) T(std::forward<Args>(vals)...);
-    }
+// Caps the number of workers the parallel calls may occupy, so that several tenants of a process
+// get a predictable share of the machine instead of every call competing for all of it. Both the
+// number of chunks and the number of threads executing them are limited. An arena applies either
+// to a single call via a policy property, e.g. par.with(arena), or to all calls made by a thread
+// within an arena::scope. When both are present the tighter limit wins.
+class arena
+{
+public:
+    constexpr explicit arena(size_t workers) noexcept : m_workers(workers != 0 ? workers : 1) {}
 
-    T *begin() noexcept { return m_data; }
+    constexpr size_t workers() const noexcept { return m_workers; }
 
-    T *end() noexcept { return m_data + m_size; }
+    class scope;
 
-    T &operator[](size_t ind) noexcept { return m_data[ind]; }
+private:
+    size_t m_workers;
 };
 
-template <class T>
-constexpr size_t work_chunks_min_fraction_1(T count)
+// Enters an arena on the calling thread for the lifetime of the object. A scope nested into another
+// one can only tighten the limit.
+class arena::scope
 {
-    return std::min(max_hw_threads() * chunks_per_cpu, static_cast<size_t>(count));
-}
+public:
+    explicit scope(const arena &a) noexcept;
+    scope(const scope &) = delete;
+    scope &operator=(const scope &) = delete;
+    ~scope();
 
-template <class T>
-constexpr size_t work_chunks_min_fraction_2(T count)
-{
-    return std::min(max_hw_threads() * chunks_per_cpu, static_cast<size_t>(count / 2));
+private:
+    size_t m_previous;
+};
+
+//--------------------------------------------------------------------------------------------------
+//
+// Cancellation
+//
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+struct StopFlag;
 }
 
-template <class It>
-struct ItRange {
-    It first;
-    It last;
-};
+class stop_token;
 
-template <class It, bool Forward = true, bool IsRandomAccess = is_random_iterator_v<It>>
-struct Partition;
+// Requests the calls carrying its tokens to stop, e.g. a call made with
+// par.with(source.get_token()) which has to be abandoned on a timeout. The workers check the token
+// before each chunk of work and at the fork points of sort and merge, skip the work they haven't
+// started yet and the call returns promptly. The results of a stopped call are unspecified: output
+// ranges are partially written, a range being sorted holds its elements in an unspecified order
+// and the returned values must not be used. stable_sort stops sorting its chunks, but still merges
+// them. Calls executed serially, e.g. because they were too small to go parallel, run to
+// completion.
+class stop_source
+{
+public:
+    stop_source() : m_state(std::make_shared<std::atomic<bool>>(false)) {}
 
-template <class It, bool Forward>
-struct Partition<It, Forward, true> {
-    It base;
-    size_t fraction;
-    size_t leftover;
-    size_t count;
-    Partition(It first, size_t count, size_t chunks) noexcept
-        : base(first), fraction(count / chunks), leftover(count % chunks), count(count)
-    {
-    }
+    // Returns true if this call made the request, false if it was made before.
+    bool request_stop() noexcept { return !m_state->exchange(true); }
 
-    ItRange<It> at(size_t chunk_no) const noexcept
-    {
-        if( leftover ) {
-            if( chunk_no >= leftover ) {
-                const auto first =
-                    advance(base, (fraction + 1) * leftover + fraction * (chunk_no - leftover));
-                const auto last = advance(first, fraction);
-                return {first, last};
-            }
-            else {
-                const auto first = advance(base, (fraction + 1) * chunk_no);
-                const auto last = advance(first, fraction + 1);
-                return {first, last};
-            }
-        }
-        else {
-            const auto first = advance(base, fraction * chunk_no);
-            const auto last = advance(first, fraction);
-            return {first, last};
-        }
-    }
+    bool stop_requested() const noexcept { return m_state->load(); }
 
-    It end() const noexcept { return base + count; }
+    stop_token get_token() const noexcept;
 
-    static It advance(It it, size_t distance) noexcept
-    {
-        if constexpr( Forward )
-            return it + distance;
-        else
-            return it - distance;
-    }
+private:
+    std::shared_ptr<std::atomic<bool>> m_state;
 };
 
-template <class It, bool Forward>
-struct Partition<It, Forward, false> {
-    parallelism_vector<ItRange<It>> segments;
-    Partition(It first, size_t count, size_t chunks) : segments(chunks)
-    {
-        size_t fraction = count / chunks;
-        size_t leftover = count % chunks;
-        It it = first;
-        for( size_t i = 0; i != chunks; ++i ) {
-            auto diff = fraction;
-            if( leftover != 0 ) {
-                ++diff;
-                --leftover;
-            }
-            auto last = advance(it, diff);
-            segments[i] = {it, last};
-            it = last;
-        }
-    }
+class stop_token
+{
+public:
+    stop_token() noexcept = default;
 
-    ItRange<It> at(size_t chunk_no) const noexcept { return segments[chunk_no]; }
+    bool stop_requested() const noexcept { return m_state != nullptr && m_state->load(); }
 
-    It end() const noexcept { return segments.back().last; }
+    // Whether the token is associated with a stop_source at all.
+    bool stop_possible() const noexcept { return m_state != nullptr; }
 
-    static It advance(It it, size_t distance) noexcept
+private:
+    friend class stop_source;
+    friend struct internal::StopFlag;
+    explicit stop_token(std::shared_ptr<const std::atomic<bool>> state) noexcept
+        : m_state(std::move(state))
     {
-        if constexpr( Forward )
-            return std::next(it, distance);
-        else
-            return std::prev(it, distance);
     }
+
+    std::shared_ptr<const std::atomic<bool>> m_state;
 };
 
-template <class It, bool = is_random_iterator_v<It> &&can_be_atomic_v<It>>
-struct MinIteratorResult;
+inline stop_token stop_source::get_token() const noexcept
+{
+    return stop_token{m_state};
+}
 
-template <class It>
-struct MinIteratorResult<It, true> {
-    std::atomic<size_t> min_chunk;
-    std::atomic<It> min;
-    MinIteratorResult(It last) : min_chunk{std::numeric_limits<size_t>::max()}, min{last} {}
+//--------------------------------------------------------------------------------------------------
+//
+// Affinity
+//
+//--------------------------------------------------------------------------------------------------
 
-    void put(size_t chunk, It it)
-    {
-        It prev_it = min;
-        while( prev_it > it && !min.compare_exchange_weak(prev_it, it) )
-            ;
+namespace internal {
+struct AffinityMap;
+struct AffinityOf;
+}
 
-        size_t prev_chunk = min_chunk;
-        while( prev_chunk > chunk && !min_chunk.compare_exchange_weak(prev_chunk, chunk) )
-            ;
-    }
-};
+// Remembers which thread processed which part of a range and hands the same parts to the same
+// threads on the later calls made with it, e.g. par.with(partitioner). A thread first takes the
+// chunks it processed before and only then helps with the rest, so the chunks of a thread that
+// doesn't take part are still processed by others. Pages are placed on the NUMA node of the thread
+// which first touches them, so a range initialized by fill or uninitialized_value_construct under a
+// partitioner is later read by transform_reduce under the same partitioner from the memory local
+// to each thread. The parts are matched by their position within the range, the calls don't have
+// to split it into the same number of chunks, but they should be made over the same range.
+// Copies share the recorded mapping. A partitioner must not be used by concurrent calls.
+class affinity_partitioner
+{
+public:
+    affinity_partitioner();
 
-template <class It>
-struct MinIteratorResult<It, false> {
-    std::atomic<size_t> min_chunk;
-    It min;
-    std::mutex mutex;
+    // Forgets the recorded mapping, e.g. once the range was reallocated.
+    void clear() noexcept;
 
-    MinIteratorResult(It last) : min_chunk{std::numeric_limits<size_t>::max()}, min{last} {}
+private:
+    friend struct internal::AffinityOf;
+    std::shared_ptr<internal::AffinityMap> m_map;
+};
 
-    void put(size_t chunk, It it)
-    {
-        size_t prev = std::numeric_limits<size_t>::max();
-        while( !min_chunk.compare_exchange_weak(prev, chunk) )
-            if( prev < chunk )
-                return;
+//--------------------------------------------------------------------------------------------------
+//
+// Admission control
+//
+//--------------------------------------------------------------------------------------------------
 
-        std::lock_guard lock{mutex};
-        if( min_chunk == chunk )
-            min = it;
-    }
+// The parallel calls share a process-wide budget of helper threads, one less than the number of
+// workers in the topology. A call occupies its calling thread plus the helpers it was granted, so
+// when many threads call pstld at the same time the late ones get fewer helpers or run inline
+// instead of oversubscribing the machine. Calls running on an application's executor don't take
+// part, the executor is in charge of its own threads. These counters show how the budget is doing.
+struct admission_counters {
+    size_t requests = 0;     // requests for helpers made by the parallel calls
+    size_t granted = 0;      // requests granted in full
+    size_t reduced = 0;      // requests granted fewer helpers than asked for
+    size_t serialized = 0;   // requests granted no helpers at all, the calls ran inline
+    size_t busy_helpers = 0; // helpers occupied at the moment
+    size_t budget = 0;       // helpers available in total
 };
 
-template <class It, bool = is_random_iterator_v<It> &&can_be_atomic_v<It>>
-struct MaxIteratorResult;
-
-template <class It>
-struct MaxIteratorResult<It, true> {
-    std::atomic<size_t> max_chunk;
-    std::atomic<It> max;
-    It last;
+// Returns a snapshot of the counters accumulated since the process started.
+admission_counters admission_stats() noexcept;
 
-    MaxIteratorResult(It last)
-        : max_chunk{std::numeric_limits<size_t>::max()}, max{last}, last(last)
-    {
-    }
+//--------------------------------------------------------------------------------------------------
+//
+// Scratch memory
+//
+//--------------------------------------------------------------------------------------------------
 
-    void put(size_t chunk, It it)
-    {
-        It prev_it = max;
-        while( (prev_it == last || prev_it < it) && !max.compare_exchange_weak(prev_it, it) )
-            ;
+// The temporary buffers of the parallel calls, e.g. the per-chunk results of a reduction, the
+// work-stealing queues of sort or the merge buffer of stable_sort, are taken from a cache kept by
+// the thread which needs them and are put back there once released. Repeated calls of the same
+// shape don't touch the heap once the cache is warm. A thread caches up to this many bytes:
+inline constexpr size_t scratch_cache_limit = size_t(64) << 20;
 
-        size_t prev_chunk = max_chunk;
-        while( static_cast<ptrdiff_t>(prev_chunk) < static_cast<ptrdiff_t>(chunk) &&
-               !max_chunk.compare_exchange_weak(prev_chunk, chunk) )
-            ;
-    }
+struct scratch_counters {
+    size_t hits = 0;         // buffers taken from the cache
+    size_t misses = 0;       // buffers allocated from the heap
+    size_t cached_bytes = 0; // bytes held by the cache at the moment
 };
 
-template <class It>
-struct MaxIteratorResult<It, false> {
-    std::atomic<size_t> max_chunk;
-    It max;
-    std::mutex mutex;
+// Returns the counters of the calling thread.
+scratch_counters scratch_stats() noexcept;
 
-    MaxIteratorResult(It last) : max_chunk{std::numeric_limits<size_t>::max()}, max{last} {}
+// Frees the memory cached by the calling thread, e.g. after a one-off call on a huge input.
+void release_scratch() noexcept;
 
-    void put(size_t chunk, It it)
-    {
-        size_t prev = std::numeric_limits<size_t>::max();
-        while( !max_chunk.compare_exchange_weak(prev, chunk) )
-            if( prev > chunk )
-                return;
+// Scratch blocks of this many bytes and more are mapped from the OS directly, in multiples of 2MB
+// and aligned to them, so that on Linux they can be backed by transparent huge pages. They aren't
+// cached, each one goes back to the OS once released. A freshly mapped block is faulted in by the
+// workers in parallel, each touching its own share of the requested bytes, instead of being
+// faulted in page by page by whichever worker happens to reach it first.
+inline constexpr size_t huge_page_threshold = size_t(4) << 20;
 
-        std::lock_guard lock{mutex};
-        if( max_chunk == chunk )
-            max = it;
-    }
-};
+// Turns the huge page advice and the parallel prefaulting of the large blocks on or off, e.g. to
+// measure their effect. They're on by default.
+void set_huge_pages(bool enabled) noexcept;
 
+// A caller-owned array of constructed objects which an algorithm can use as its O(n) temporary
+// storage instead of allocating one, e.g. a std::vector kept between the calls of stable_sort on
+// inputs of the same size. An array smaller than the algorithm needs is ignored. The contents of
+// the array are unspecified afterwards.
 template <class T>
-struct Dispatchable {
-    static void dispatch(void *ctx, size_t ind) noexcept { static_cast<T *>(ctx)->run(ind); }
-    void dispatch_apply(size_t count) noexcept { internal::dispatch_apply(count, this, dispatch); }
-};
+struct scratch_span {
+    T *data = nullptr;
+    size_t size = 0;
 
-template <class T>
-struct Dispatchable2 {
-    static void dispatch_first(void *ctx, size_t ind) noexcept
-    {
-        static_cast<T *>(ctx)->run_first(ind);
-    }
-    void dispatch_apply_first(size_t count) noexcept
-    {
-        internal::dispatch_apply(count, this, dispatch_first);
-    }
-    static void dispatch_second(void *ctx, size_t ind) noexcept
-    {
-        static_cast<T *>(ctx)->run_second(ind);
-    }
-    void dispatch_apply_second(size_t count) noexcept
+    scratch_span() noexcept = default;
+    scratch_span(T *first, size_t count) noexcept : data(first), size(count) {}
+
+    template <class Alloc>
+    scratch_span(std::vector<T, Alloc> &buffer) noexcept : data(buffer.data()), size(buffer.size())
     {
-        internal::dispatch_apply(count, this, dispatch_second);
     }
 };
 
-template <class T>
-struct CircularArray {
-    static_assert(std::is_trivial_v<T>);
-    static constexpr size_t default_log_size = 6;
+//--------------------------------------------------------------------------------------------------
+//
+// Statistics
+//
+//--------------------------------------------------------------------------------------------------
 
-    size_t m_log_size;
-    std::atomic_int64_t m_ref_count;
+// The algorithms implementing the calls, as told apart by the statistics and the plans. The
+// overloads and the algorithms built on top of another one share its entry, e.g. reduce is counted
+// as transform_reduce and count as count_if.
+enum class algorithm : unsigned char {
+    adjacent_difference,
+    adjacent_find,
+    all_of,
+    any_of,
+    bounded_count_if,
+    bounded_find_if,
+    bounded_transform_reduce,
+    copy,
+    copy_n,
+    copy_if,
+    count_if,
+    destroy,
+    destroy_n,
+    equal,
+    fill,
+    fill_n,
+    find_end,
+    find_if,
+    for_each,
+    for_each_n,
+    generate,
+    generate_n,
+    is_partitioned,
+    is_sorted,
+    is_sorted_until,
+    lexicographical_compare,
+    max_element,
+    merge,
+    min_element,
+    minmax_element,
+    mismatch,
+    move,
+    none_of,
+    reverse,
+    search,
+    search_n,
+    sort,
+    stable_sort,
+    swap_ranges,
+    transform,
+    transform_exclusive_scan,
+    transform_inclusive_scan,
+    transform_reduce,
+    uninitialized_copy,
+    uninitialized_copy_n,
+    uninitialized_default_construct,
+    uninitialized_default_construct_n,
+    uninitialized_fill,
+    uninitialized_fill_n,
+    uninitialized_move,
+    uninitialized_move_n,
+    uninitialized_value_construct,
+    uninitialized_value_construct_n,
+};
 
-    static CircularArray *alloc(size_t log_size = default_log_size)
-    {
-        static_assert(sizeof(T) >= sizeof(CircularArray));
+namespace internal {
+
+inline constexpr const char *algorithm_names[] = {
+    "adjacent_difference",
+    "adjacent_find",
+    "all_of",
+    "any_of",
+    "bounded_count_if",
+    "bounded_find_if",
+    "bounded_transform_reduce",
+    "copy",
+    "copy_n",
+    "copy_if",
+    "count_if",
+    "destroy",
+    "destroy_n",
+    "equal",
+    "fill",
+    "fill_n",
+    "find_end",
+    "find_if",
+    "for_each",
+    "for_each_n",
+    "generate",
+    "generate_n",
+    "is_partitioned",
+    "is_sorted",
+    "is_sorted_until",
+    "lexicographical_compare",
+    "max_element",
+    "merge",
+    "min_element",
+    "minmax_element",
+    "mismatch",
+    "move",
+    "none_of",
+    "reverse",
+    "search",
+    "search_n",
+    "sort",
+    "stable_sort",
+    "swap_ranges",
+    "transform",
+    "transform_exclusive_scan",
+    "transform_inclusive_scan",
+    "transform_reduce",
+    "uninitialized_copy",
+    "uninitialized_copy_n",
+    "uninitialized_default_construct",
+    "uninitialized_default_construct_n",
+    "uninitialized_fill",
+    "uninitialized_fill_n",
+    "uninitialized_move",
+    "uninitialized_move_n",
+    "uninitialized_value_construct",
+    "uninitialized_value_construct_n",
+};
 
-        size_t count = static_cast<size_t>(1) << log_size;
-        size_t bytes = sizeof(T) * (count + 1);
+inline constexpr size_t algorithms_count = std::size(algorithm_names);
 
-        auto buffer = static_cast<CircularArray *>(::operator new(bytes, std::nothrow));
-        if( buffer == nullptr )
-            parallelism_exception::raise();
+static_assert(size_t(algorithm::uninitialized_value_construct_n) + 1 == algorithms_count);
 
-        buffer->m_log_size = log_size;
-        buffer->m_ref_count = 1;
-        return buffer;
-    }
+} // namespace internal
 
-    void retain() noexcept { ++m_ref_count; }
+// The latency histograms have this many buckets: bucket i counts the parallel calls whose parallel
+// part took from 2^i up to 2^(i+1) nanoseconds, the first and the last ones also count the shorter
+// and the longer calls. The serial calls aren't timed, which keeps their counting cheap.
+inline constexpr size_t latency_buckets = 36;
+
+struct algorithm_counters {
+    const char *algorithm = nullptr; // e.g. "transform_reduce"
+    size_t parallel = 0;             // calls which ran in parallel
+    size_t serial = 0;               // calls which took the serial path, including the fallbacks
+    size_t fallbacks = 0;            // calls which fell back to the serial path because the
+                                     // resources of the parallel one couldn't be allocated
+    size_t latency[latency_buckets] = {}; // of the parallel calls
+};
 
-    void release() noexcept
-    {
-        if( --m_ref_count == 0 )
-            ::operator delete(this);
-    }
+struct runtime_counters {
+    algorithm_counters algorithms[internal::algorithms_count];
+    size_t steals = 0;        // work items of sort and merge and pool tasks taken from another
+                              // thread's queue
+    size_t failed_steals = 0; // attempts to steal which found the queue empty or lost the race
+    size_t yields = 0;        // times an idle worker gave up its time slice
+    admission_counters admission;
+};
 
-    T &operator[](size_t ind) noexcept
-    {
-        auto elements = reinterpret_cast<T *>(this) + 1;
-        auto mask = (static_cast<size_t>(1) << m_log_size) - 1;
-        return elements[ind & mask];
-    }
+// Returns a snapshot of the counters of all threads accumulated since the process started. The
+// counters are always on: each thread bumps its own ones, which are only added up by the snapshot.
+runtime_counters stats() noexcept;
 
-    constexpr size_t size() noexcept { return static_cast<size_t>(1) << m_log_size; }
+//--------------------------------------------------------------------------------------------------
+//
+// Plans
+//
+//--------------------------------------------------------------------------------------------------
 
-    CircularArray *grow(size_t bottom, size_t top)
-    {
-        auto grown = alloc(m_log_size + 1);
-        for( size_t ind = top; ind != bottom; ++ind )
-            (*grown)[ind] = (*this)[ind];
-        return grown;
-    }
+// How a call would be carried out, as reported by explain(). The plan assumes that the whole budget
+// of helper threads is available, a call made while others are running may get fewer workers.
+struct plan {
+    bool parallel = false;    // whether the call would go parallel
+    size_t chunks = 0;        // the chunks the range would be split into, 0 for a serial call
+                              // and for sort and merge which split the range as they go
+    size_t chunk_min = 0;     // the lengths of the shortest and the longest chunks
+    size_t chunk_max = 0;     //
+    size_t workers = 1;       // the threads the call would run on, including the calling one
+    size_t tree_height = 0;   // the height of the merge tree of stable_sort
+    size_t scratch_bytes = 0; // the temporary memory the call would allocate
 };
 
-template <class T>
-struct alignas(hardware_destructive_interference_size) CircularWorkStealingDeque {
-    std::atomic<size_t> m_bottom{0};
-    std::atomic<size_t> m_top{0};
-    CircularArray<T> *m_array{CircularArray<T>::alloc()};
-    std::mutex m_mut;
-
-    CircularWorkStealingDeque() = default;
-    CircularWorkStealingDeque(const CircularWorkStealingDeque &) = delete;
-    CircularWorkStealingDeque &operator=(const CircularWorkStealingDeque &) = delete;
-    ~CircularWorkStealingDeque() { m_array->release(); }
+namespace internal {
 
-    void push_bottom(const T &val)
-    {
-        size_t bottom = m_bottom.load();
-        size_t top = m_top.load();
-        size_t size = bottom - top;
-        if( size >= m_array->size() ) {
-            CircularArray<T> *grown = m_array->grow(bottom, top);
-            CircularArray<T> *current;
-            {
-                std::lock_guard lock{m_mut};
-                current = std::exchange(m_array, grown);
-            }
-            current->release();
-        }
-        (*m_array)[bottom] = val;
-        m_bottom.store(bottom + 1);
-    }
+plan explain_call(algorithm a, size_t count, size_t value_size, size_t value_align) noexcept;
 
-    bool pop_bottom(T &val) noexcept
-    {
-        size_t bottom = m_bottom.load();
-        if( bottom == 0 )
-            return false;
-        --bottom;
-        m_bottom.store(bottom);
-        size_t top = m_top.load();
-        if( bottom < top ) {
-            m_bottom.store(top);
-            return false;
-        }
+} // namespace internal
 
-        val = (*m_array)[bottom];
+//--------------------------------------------------------------------------------------------------
+//
+// Tracing
+//
+//--------------------------------------------------------------------------------------------------
 
-        if( bottom > top )
-            return true;
+#if defined(PSTLD_TRACING)
 
-        if( m_top.compare_exchange_strong(top, top + 1) ) {
-            m_bottom.store(top + 1);
-            return true;
-        }
-        else {
-            m_bottom.store(top);
-            return false;
-        }
-    }
+// The hooks are compiled in only when PSTLD_TRACING is defined, otherwise the calls don't pay for
+// them at all.
+namespace trace {
 
-    bool steal_top(T &val) noexcept
-    {
-        size_t top = m_top.load();
-        while( true ) {
-            if( m_bottom.load() <= top )
-                return false;
-            CircularArray<T> *current;
-            {
-                std::lock_guard lock{m_mut};
-                current = m_array;
-                current->retain();
-            }
-            val = (*current)[top];
-            current->release();
-            if( m_top.compare_exchange_strong(top, top + 1) )
-                return true;
-        }
-    }
+struct call {
+    const char *algorithm = nullptr; // the algorithm implementing the call, e.g. "transform_reduce"
+    size_t elements = 0;             // the length of the input
+    size_t chunks = 0;               // the chunks planned, 0 if decided as the call goes
+    size_t workers = 0;              // the threads the call ran on, 0 if it took the serial path
 };
 
-struct alignas(hardware_destructive_interference_size) WorkCounter {
-    std::atomic<size_t> m_done{0};
-    void commit_relaxed(size_t newly_done) noexcept
-    {
-        size_t done = m_done.load(std::memory_order_relaxed);
-        m_done.store(done + newly_done, std::memory_order_relaxed);
-    }
-    size_t load_relaxed() noexcept { return m_done.load(std::memory_order_relaxed); }
+// The events of the traced calls, any of the functions can be left empty. The call events are
+// fired on the calling thread, the workers are known only by the end of the call. The chunk events
+// are fired on the thread executing the chunk, which is identified by its index or, in sort and
+// merge which split the work as they go, by the offset of its first element.
+struct hooks {
+    void *context = nullptr;
+    void (*call_begin)(void *context, const call &c) noexcept = nullptr;
+    void (*call_end)(void *context, const call &c) noexcept = nullptr;
+    void (*chunk_begin)(void *context, const call &c, size_t chunk) noexcept = nullptr;
+    void (*chunk_end)(void *context, const call &c, size_t chunk) noexcept = nullptr;
 };
 
-} // namespace internal
+// Installs the hooks for the calls started afterwards, nullptr removes them. The hooks must stay
+// alive until the calls made with them have completed.
+void set_hooks(const hooks *h) noexcept;
+
+// The built-in recorder of the threads' timelines: the calls and their chunks, the steals and the
+// idle spells of the workers of sort and merge, and the merge levels of stable_sort. Each thread
+// appends the events to a ring buffer of its own without any locking, the events which don't fit
+// until the next flush are dropped. The recorder works alongside the hooks.
+void start_recording() noexcept;
+void stop_recording() noexcept;
+
+// Moves the events recorded so far into a file in the Chrome trace event format, which
+// chrome://tracing and ui.perfetto.dev show as a timeline per thread. Repeated flushes into the
+// same file append to it. Returns false if the file couldn't be written.
+bool flush_recording(const char *path) noexcept;
+
+} // namespace trace
+
+#endif
 
 //--------------------------------------------------------------------------------------------------
 //
-// Algorithms implementation
+// Fork-join tasks
 //
 //--------------------------------------------------------------------------------------------------
 
+namespace internal {
+struct TaskTeam;
+}
+
+// A group of tasks executed by the same work-stealing engine as the parallel sort and merge. The
+// tasks run concurrently with the thread that spawned them, which executes pending tasks itself
+// once it calls wait(). A group created inside a task joins the team executing that task, so
+// recursive divide-and-conquer code spreads over the same workers instead of spawning new ones.
+// run() and wait() are expected to be called by the thread which created the group or by the
+// group's own tasks. The tasks must not throw.
+class task_group
+{
+public:
+    task_group() noexcept = default;
+    task_group(const task_group &) = delete;
+    task_group &operator=(const task_group &) = delete;
+    ~task_group();
+
+    template <class F>
+    void run(F &&f) noexcept;
+
+    // Returns once all tasks run in the group, including those run from within its own tasks,
+    // have completed.
+    void wait() noexcept;
+
+private:
+    friend struct internal::TaskTeam;
+
+    void spawn(void *ctx, void (*function)(void *)) noexcept;
+    bool start_team() noexcept;
+
+    internal::TaskTeam *m_team = nullptr;     // the team executing the tasks until wait()
+    internal::TaskTeam *m_own_team = nullptr; // allocated when the group isn't nested in a team
+    std::atomic<size_t> m_pending{0};
+};
+
+template <class F>
+void task_group::run(F &&f) noexcept
+{
+    using Fn = std::decay_t<F>;
+    auto fn = new(std::nothrow) Fn(std::forward<F>(f));
+    if( fn == nullptr ) {
+        // can't allocate the task - execute in-place instead
+        f();
+        return;
+    }
+    spawn(fn, [](void *ctx) noexcept {
+        auto fn = static_cast<Fn *>(ctx);
+        (*fn)();
+        delete fn;
+    });
+}
+
+// Invokes all functions, potentially in parallel, and returns once all of them have completed.
+// The first one is executed by the calling thread.
+template <class F1, class F2, class... Fs>
+void parallel_invoke(F1 &&f1, F2 &&f2, Fs &&...fs) noexcept
+{
+    task_group group;
+    group.run([&f2] { std::forward<F2>(f2)(); });
+    (group.run([&fs] { std::forward<Fs>(fs)(); }), ...);
+    std::forward<F1>(f1)();
+    group.wait();
+}
+
 //--------------------------------------------------------------------------------------------------
-// reduce, transform_reduce
+//
+// Common facilities
+//
 //--------------------------------------------------------------------------------------------------
 
 namespace internal {
 
-template <class It, class T, class BinOp, class UnOp>
-struct TransformReduce : Dispatchable<TransformReduce<It, T, BinOp, UnOp>> {
-    Partition<It> m_partition;
-    unitialized_array<T> m_results;
-    BinOp m_reduce;
-    UnOp m_transform;
+inline constexpr size_t chunks_per_cpu = 8;
+inline constexpr size_t insertion_sort_limit = 32;
+inline constexpr size_t merge_parallel_limit = 8192;
+inline constexpr size_t hardware_destructive_interference_size = 128; // or 64 on x86
+inline constexpr size_t serial_below_auto = std::numeric_limits<size_t>::max();
+
+// Rough serial costs of processing one element, in picoseconds. They only have to be right within
+// a factor of two, the cost model leaves a margin for that.
+inline constexpr size_t cost_copy = 250;       // fills, copies, moves and alike
+inline constexpr size_t cost_compare = 500;    // searches and counts, mostly with std predicates
+inline constexpr size_t cost_invoke = 1000;    // a call of a user-provided function, the default
+inline constexpr size_t cost_sort_level = 750; // per element and per level of the recursion
+
+// Options of the current parallel call, installed by the policy-taking overloads for the duration
+// of the call on the calling thread.
+struct CallOptions {
+    const executor *exec = nullptr;
+    execution::idle_strategy idle;
+    size_t grain = 1;
+    size_t chunks_per_cpu = internal::chunks_per_cpu;
+    size_t serial_below = serial_below_auto;
+    size_t worker_limit = std::numeric_limits<size_t>::max();
+    execution::priority priority = execution::priority::normal;
+    const std::atomic<bool> *stop = nullptr;
+    AffinityMap *affinity = nullptr;
+};
 
-    TransformReduce(size_t count, size_t chunks, It first, BinOp reduce_op, UnOp transform_op)
-        : m_partition(first, count, chunks), m_results(chunks), m_reduce(reduce_op),
-          m_transform(transform_op)
-    {
-    }
+const CallOptions *&call_options() noexcept;
 
-    void run(size_t ind) noexcept
-    {
-        auto p = m_partition.at(ind);
-        m_results.put(ind, transform_reduce_at_least_2(p.first, p.last));
-    }
+// How many parallel calls the current thread is executing a part of. Calls made from within run
+// inline, since the outer call already keeps the workers busy.
+size_t &nesting_depth() noexcept;
 
-    T transform_reduce_at_least_2(It first, It last)
-    {
-        auto next = first;
-        T val = m_reduce(m_transform(*first), m_transform(*++next));
-        while( ++next != last )
-            val = m_reduce(std::move(val), m_transform(*next));
-        return val;
-    }
+// Marks the current thread as executing a part of a parallel call for the lifetime of the object.
+class NestedScope
+{
+public:
+    NestedScope() noexcept { ++nesting_depth(); }
+    NestedScope(const NestedScope &) = delete;
+    NestedScope &operator=(const NestedScope &) = delete;
+    ~NestedScope() { --nesting_depth(); }
 };
 
-template <class It, class T, class BinOp>
-T move_reduce(It first, It last, T val, BinOp reduce)
+// Whether the cost model expects 'count' elements costing 'cost' picoseconds each to be processed
+// faster in parallel than serially.
+bool cost_model_allows(size_t count, size_t cost) noexcept;
+
+size_t max_hw_threads() noexcept;
+
+// The executor the current call runs on, nullptr if it's the built-in backend.
+const executor *current_executor() noexcept;
+
+// The number of workers the current call may occupy, respects the executor's concurrency and the
+// arena the call runs in.
+size_t max_workers() noexcept;
+
+inline execution::priority current_priority() noexcept
 {
-    for( ; first != last; ++first )
-        val = reduce(std::move(val), std::move(*first));
-    return val;
+    const CallOptions *options = call_options();
+    return options != nullptr ? options->priority : execution::priority::normal;
 }
 
-template <class It, class T, class BinOp, class UnOp>
-T move_transform_reduce(It first, It last, T val, BinOp reduce, UnOp transform)
+// The flag of the stop token carried by the current call, nullptr if there's none.
+inline const std::atomic<bool> *current_stop_flag() noexcept
 {
-    for( ; first != last; ++first )
-        val = reduce(std::move(val), transform(std::move(*first)));
-    return val;
+    const CallOptions *options = call_options();
+    return options != nullptr ? options->stop : nullptr;
 }
 
-} // namespace internal
+inline bool stop_requested(const std::atomic<bool> *stop) noexcept
+{
+    return stop != nullptr && stop->load(std::memory_order_relaxed);
+}
 
-template <class FwdIt, class T, class BinOp, class UnOp>
-T transform_reduce(FwdIt first, FwdIt last, T val, BinOp reduce_op, UnOp transform_op) noexcept
+// When the current call has gone parallel, set on the calling thread once the call dispatches
+// its work. Stays at the epoch while the call runs serially.
+std::chrono::steady_clock::time_point &parallel_since() noexcept;
+
+inline void mark_parallel() noexcept
 {
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_2(count);
-    if( chunks > 1 ) {
-        try {
-            internal::TransformReduce<FwdIt, T, BinOp, UnOp> op{
-                static_cast<size_t>(count), chunks, first, reduce_op, transform_op};
-            op.dispatch_apply(chunks);
-            return internal::move_reduce(
-                op.m_results.begin(), op.m_results.end(), std::move(val), reduce_op);
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return internal::move_transform_reduce(first, last, std::move(val), reduce_op, transform_op);
-}
-
-template <class It>
-internal::iterator_value_t<It> reduce(It first, It last) noexcept
-{
-    using T = internal::iterator_value_t<It>;
-    return ::pstld::transform_reduce(first, last, T{}, std::plus<>{}, ::pstld::internal::no_op{});
+    auto &since = parallel_since();
+    if( since == std::chrono::steady_clock::time_point{} )
+        since = std::chrono::steady_clock::now();
 }
 
-template <class It, class T>
-T reduce(It first, It last, T val) noexcept
-{
-    return ::pstld::transform_reduce(
-        first, last, std::move(val), std::plus<>{}, ::pstld::internal::no_op{});
-}
+void count_parallel_call(algorithm a, std::chrono::steady_clock::duration latency) noexcept;
+void count_serial_call(algorithm a, bool fallback) noexcept;
+void count_steal(bool stolen) noexcept;
+void count_yield() noexcept;
 
-template <class It, class T, class BinOp>
-T reduce(It first, It last, T val, BinOp op) noexcept
+// Counts a call in the statistics for the lifetime of the object. Only the calls which went
+// parallel read the clock, from the moment they did.
+class CallCounter
 {
-    return ::pstld::transform_reduce(first, last, std::move(val), op, ::pstld::internal::no_op{});
-}
-
-namespace internal {
-
-template <class It1, class It2, class T, class BinRedOp, class BinTrOp>
-struct TransformReduce2 : Dispatchable<TransformReduce2<It1, It2, T, BinRedOp, BinTrOp>> {
-    Partition<It1> m_partition1;
-    Partition<It2> m_partition2;
-    unitialized_array<T> m_results;
-    BinRedOp m_reduce;
-    BinTrOp m_transform;
-
-    TransformReduce2(size_t count,
-                     size_t chunks,
-                     It1 first1,
-                     It2 first2,
-                     BinRedOp reduce_op,
-                     BinTrOp transform_op)
-        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks),
-          m_results(chunks), m_reduce(reduce_op), m_transform(transform_op)
+public:
+    explicit CallCounter(algorithm a) noexcept
+        : m_algorithm(a), m_outer(std::exchange(parallel_since(), {}))
     {
     }
-
-    void run(size_t ind) noexcept
+    CallCounter(const CallCounter &) = delete;
+    CallCounter &operator=(const CallCounter &) = delete;
+    ~CallCounter()
     {
-        auto p1 = m_partition1.at(ind);
-        auto p2 = m_partition2.at(ind);
-        m_results.put(ind, transform_reduce_at_least_2(p1.first, p1.last, p2.first));
+        const auto since = std::exchange(parallel_since(), m_outer);
+        if( since != std::chrono::steady_clock::time_point{} && !m_fallback )
+            count_parallel_call(m_algorithm, std::chrono::steady_clock::now() - since);
+        else
+            count_serial_call(m_algorithm, m_fallback);
     }
 
-    T transform_reduce_at_least_2(It1 first1, It1 last1, It2 first2)
-    {
-        auto next1 = first1;
-        auto next2 = first2;
-        T val = m_reduce(m_transform(*first1, *first2), m_transform(*++next1, *++next2));
-        while( ++next1 != last1 )
-            val = m_reduce(std::move(val), m_transform(*next1, *++next2));
-        return val;
-    }
+    // Marks the call as fallen back to the serial path after a parallelism_exception.
+    void fallback() noexcept { m_fallback = true; }
+
+private:
+    algorithm m_algorithm;
+    bool m_fallback = false;
+    std::chrono::steady_clock::time_point m_outer; // parallel_since() of the enclosing call
 };
 
-template <class It1, class It2, class T, class BinOp, class UnOp>
-T move_transform_reduce(It1 first1, It1 last1, It2 first2, T val, BinOp reduce, UnOp transform)
-{
-    for( ; first1 != last1; ++first1, ++first2 )
-        val = reduce(std::move(val), transform(std::move(*first1), std::move(*first2)));
-    return val;
-}
+#if defined(PSTLD_TRACING)
 
-} // namespace internal
+struct TracedCall {
+    trace::call call;
+    const trace::hooks *hooks;
+    bool recorded; // whether the recorder was on when the call began
+};
 
-template <class FwdIt1, class FwdIt2, class T, class BinRedOp, class BinTrOp>
-T transform_reduce(FwdIt1 first1,
-                   FwdIt1 last1,
-                   FwdIt2 first2,
-                   T val,
-                   BinRedOp reduce_op,
-                   BinTrOp transform_op) noexcept
+const trace::hooks *trace_hooks() noexcept;
+
+bool trace_recording() noexcept;
+
+// Appends an event to the calling thread's buffer of the recorder, if it's on. 'phase' is one of
+// the Chrome trace event phases, 'B' and 'E' for the beginning and the end of a span, 'i' for an
+// instant. The strings must be literals.
+void trace_record(char phase, const char *name, const char *arg_name, size_t arg) noexcept;
+
+// The call traced on the current thread, nullptr if there's none.
+TracedCall *&current_trace_call() noexcept;
+
+// Counts a call and fires its events for the lifetime of the object, if any hooks are installed or
+// the recorder is on.
+class TraceCall
 {
-    const auto count = std::distance(first1, last1);
-    const auto chunks = internal::work_chunks_min_fraction_2(count);
-    if( chunks > 1 ) {
-        try {
-            internal::TransformReduce2<FwdIt1, FwdIt2, T, BinRedOp, BinTrOp> op{
-                static_cast<size_t>(count), chunks, first1, first2, reduce_op, transform_op};
-            op.dispatch_apply(chunks);
-            return internal::move_reduce(
-                op.m_results.begin(), op.m_results.end(), std::move(val), reduce_op);
-        } catch( const internal::parallelism_exception & ) {
-        }
+public:
+    TraceCall(algorithm a, size_t elements, size_t chunks) noexcept
+        : m_counter(a),
+          m_traced{{algorithm_names[size_t(a)], elements, chunks, 0},
+                   trace_hooks(),
+                   trace_recording()},
+          m_prev(std::exchange(current_trace_call(), active() ? &m_traced : nullptr))
+    {
+        if( m_traced.recorded )
+            trace_record('B', m_traced.call.algorithm, "elements", elements);
+        if( m_traced.hooks && m_traced.hooks->call_begin )
+            m_traced.hooks->call_begin(m_traced.hooks->context, m_traced.call);
+    }
+    TraceCall(const TraceCall &) = delete;
+    TraceCall &operator=(const TraceCall &) = delete;
+    ~TraceCall()
+    {
+        current_trace_call() = m_prev;
+        if( m_traced.hooks && m_traced.hooks->call_end )
+            m_traced.hooks->call_end(m_traced.hooks->context, m_traced.call);
+        if( m_traced.recorded )
+            trace_record('E', m_traced.call.algorithm, "workers", m_traced.call.workers);
     }
-    return internal::move_transform_reduce(
-        first1, last1, first2, std::move(val), reduce_op, transform_op);
-}
 
-template <class It1, class It2, class T>
-T transform_reduce(It1 first1, It1 last1, It2 first2, T val) noexcept
-{
-    return ::pstld::transform_reduce(
-        first1, last1, first2, std::move(val), std::plus<>{}, std::multiplies<>{});
-}
+    // Sets the chunks of a call which decides on them only after some checks.
+    void planned(size_t chunks) noexcept { m_traced.call.chunks = chunks; }
 
-//--------------------------------------------------------------------------------------------------
-// all_of, none_of, any_of
-//--------------------------------------------------------------------------------------------------
+    void fallback() noexcept { m_counter.fallback(); }
 
-namespace internal {
+private:
+    bool active() const noexcept { return m_traced.hooks != nullptr || m_traced.recorded; }
 
-template <class It, class UnPred, bool Expected, bool Init>
-struct AllOf : Dispatchable<AllOf<It, UnPred, Expected, Init>> {
-    Partition<It> m_partition;
-    UnPred m_pred;
-    std::atomic_bool m_done{false};
-    bool m_result = Init;
+    CallCounter m_counter;
+    TracedCall m_traced;
+    TracedCall *m_prev;
+};
 
-    AllOf(size_t count, size_t chunks, It first, UnPred pred)
-        : m_partition(first, count, chunks), m_pred(pred)
+// Fires the events of a chunk of the traced call for the lifetime of the object.
+class TraceChunk
+{
+public:
+    TraceChunk(TracedCall *traced, size_t chunk) noexcept : m_traced(traced), m_chunk(chunk)
     {
-    }
-
-    void run(size_t ind) noexcept
+        if( m_traced == nullptr )
+            return;
+        if( m_traced->recorded )
+            trace_record('B', "chunk", "chunk", m_chunk);
+        if( m_traced->hooks && m_traced->hooks->chunk_begin )
+            m_traced->hooks->chunk_begin(m_traced->hooks->context, m_traced->call, m_chunk);
+    }
+    TraceChunk(const TraceChunk &) = delete;
+    TraceChunk &operator=(const TraceChunk &) = delete;
+    ~TraceChunk()
     {
-        if( m_done )
+        if( m_traced == nullptr )
             return;
-        for( auto p = m_partition.at(ind); p.first != p.last; ++p.first )
-            if( static_cast<bool>(m_pred(*p.first)) == !Expected ) {
-                m_done = true;
-                m_result = !Init;
-                return;
-            }
+        if( m_traced->hooks && m_traced->hooks->chunk_end )
+            m_traced->hooks->chunk_end(m_traced->hooks->context, m_traced->call, m_chunk);
+        if( m_traced->recorded )
+            trace_record('E', "chunk", "chunk", m_chunk);
     }
-};
 
-} // namespace internal
+private:
+    TracedCall *m_traced;
+    size_t m_chunk;
+};
 
-template <class FwdIt, class UnPred>
-bool all_of(FwdIt first, FwdIt last, UnPred pred) noexcept
+// Records the number of threads executing a part of the current call, called on the calling
+// thread.
+inline void trace_workers(TracedCall *traced, size_t workers) noexcept
 {
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::AllOf<FwdIt, UnPred, true, true> op{
-                static_cast<size_t>(count), chunks, first, pred};
-            op.dispatch_apply(chunks);
-            return op.m_result;
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::all_of(first, last, pred);
+    if( traced != nullptr )
+        traced->call.workers = std::max(traced->call.workers, workers);
 }
 
-template <class FwdIt, class UnPred>
-bool none_of(FwdIt first, FwdIt last, UnPred pred) noexcept
-{
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::AllOf<FwdIt, UnPred, false, true> op{
-                static_cast<size_t>(count), chunks, first, pred};
-            op.dispatch_apply(chunks);
-            return op.m_result;
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::none_of(first, last, pred);
-}
+#else
 
-template <class FwdIt, class UnPred>
-bool any_of(FwdIt first, FwdIt last, UnPred pred) noexcept
+class TraceCall
 {
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::AllOf<FwdIt, UnPred, false, false> op{
-                static_cast<size_t>(count), chunks, first, pred};
-            op.dispatch_apply(chunks);
-            return op.m_result;
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::any_of(first, last, pred);
-}
+public:
+    TraceCall(algorithm a, size_t, size_t) noexcept : m_counter(a) {}
+    void planned(size_t) noexcept {}
+    void fallback() noexcept { m_counter.fallback(); }
 
-//--------------------------------------------------------------------------------------------------
-// for_each, for_each_n
-//--------------------------------------------------------------------------------------------------
+private:
+    CallCounter m_counter;
+};
 
-namespace internal {
+#endif
 
-template <class It, class Func>
-struct ForEach : Dispatchable<ForEach<It, Func>> {
-    Partition<It> m_partition;
-    Func m_func;
+void dispatch_apply(size_t iterations, void *ctx, void (*function)(void *, size_t)) noexcept;
+void dispatch_async(void *ctx, void (*function)(void *)) noexcept;
 
-    ForEach(size_t count, size_t chunks, It first, Func func)
-        : m_partition(first, count, chunks), m_func(func)
-    {
-    }
+// Takes up to 'helpers' helpers from the process-wide budget, returns how many were granted.
+size_t admit(size_t helpers) noexcept;
 
-    void run(size_t ind) noexcept
-    {
-        for( auto p = m_partition.at(ind); p.first != p.last; ++p.first )
-            m_func(*p.first);
-    }
-};
+// Returns helpers taken by admit() to the budget.
+void dismiss(size_t helpers) noexcept;
 
-} // namespace internal
+// Caps 'workers' by the helpers currently left in the budget plus the calling thread, without
+// taking any. Counts the request as serialized if nothing is left. Calls running on an
+// application's executor aren't capped.
+size_t admissible_workers(size_t workers) noexcept;
 
-template <class FwdIt, class Func>
-void for_each(FwdIt first, FwdIt last, Func func) noexcept
+// Occupies helpers from the budget for its lifetime.
+// Calls running on an application's executor get all the helpers they ask for.
+class Admission
 {
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::ForEach<FwdIt, Func> op{static_cast<size_t>(count), chunks, first, func};
-            op.dispatch_apply(chunks);
-            return;
-        } catch( const internal::parallelism_exception & ) {
-        }
+public:
+    explicit Admission(size_t helpers) noexcept
+        : m_counted(current_executor() == nullptr), m_granted(m_counted ? admit(helpers) : helpers)
+    {
     }
-    std::for_each(first, last, func);
-}
-
-template <class FwdIt, class Size, class Func>
-FwdIt for_each_n(FwdIt first, Size count, Func func) noexcept
-{
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::ForEach<FwdIt, Func> op{static_cast<size_t>(count), chunks, first, func};
-            op.dispatch_apply(chunks);
-            return op.m_partition.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
+    Admission(const Admission &) = delete;
+    Admission &operator=(const Admission &) = delete;
+    ~Admission()
+    {
+        if( m_counted )
+            dismiss(m_granted);
     }
-    return std::for_each_n(first, count, func);
-}
 
-//--------------------------------------------------------------------------------------------------
-// count, count_if
-//--------------------------------------------------------------------------------------------------
+    size_t granted() const noexcept { return m_granted; }
 
-namespace internal {
+private:
+    bool m_counted;
+    size_t m_granted;
+};
 
-template <class It, class Pred>
-struct Count : Dispatchable<Count<It, Pred>> {
-    Partition<It> m_partition;
-    Pred m_pred;
-    std::atomic<iterator_diff_t<It>> m_result{};
+class DispatchGroup
+{
+public:
+    DispatchGroup() noexcept;
+    DispatchGroup(const DispatchGroup &) = delete;
+    ~DispatchGroup();
 
-    Count(size_t count, size_t chunks, It first, Pred pred)
-        : m_partition(first, count, chunks), m_pred(pred)
-    {
-    }
+    void dispatch(void *ctx, void (*function)(void *)) noexcept;
+    void wait() noexcept;
 
-    void run(size_t ind) noexcept
+private:
+    struct ExecutorTask;
+    void dispatch_executor(void *ctx, void (*function)(void *)) noexcept;
+    void wait_executor() noexcept;
+
+    const executor *m_executor;
+    execution::priority m_priority;
+    std::atomic<size_t> m_pending{0};
+    std::mutex m_executor_mut;
+    std::condition_variable m_executor_cv;
+#if defined(PSTLD_INTERNAL_BACKEND_DISPATCH)
+    #if defined(PSTLD_INTERNAL_ARC)
+    __strong dispatch_group_t m_group;
+    __strong dispatch_queue_global_t m_queue;
+    #else
+    void *m_group;
+    void *m_queue;
+    #endif
+#endif
+};
+
+template <class It>
+using iterator_category_t = typename std::iterator_traits<It>::iterator_category;
+
+template <class It>
+inline constexpr bool is_random_iterator_v =
+    std::is_convertible_v<iterator_category_t<It>, std::random_access_iterator_tag>;
+
+template <class It>
+inline constexpr bool is_bidirectional_iterator_v =
+    std::is_convertible_v<iterator_category_t<It>, std::bidirectional_iterator_tag>;
+
+template <class It>
+using iterator_value_t = typename std::iterator_traits<It>::value_type;
+
+template <class It>
+using iterator_diff_t = typename std::iterator_traits<It>::difference_type;
+
+template <class T>
+inline constexpr bool can_be_atomic_v = std::conjunction_v<std::is_trivially_copyable<T>,
+                                                           std::is_copy_constructible<T>,
+                                                           std::is_move_constructible<T>,
+                                                           std::is_copy_assignable<T>,
+                                                           std::is_move_assignable<T>>;
+
+struct no_op {
+    template <typename T>
+    T &&operator()(T &&v) const
     {
-        auto p = m_partition.at(ind);
-        m_result += std::count_if(p.first, p.last, m_pred);
+        return std::forward<T>(v);
     }
 };
 
-} // namespace internal
+struct parallelism_exception : std::exception {
+    const char *what() const noexcept override;
+    [[noreturn]] static void raise();
+};
 
-template <class FwdIt, class Pred>
-typename std::iterator_traits<FwdIt>::difference_type
-count_if(FwdIt first, FwdIt last, Pred pred) noexcept
-{
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Count<FwdIt, Pred> op{static_cast<size_t>(count), chunks, first, pred};
-            op.dispatch_apply(chunks);
-            return op.m_result;
-        } catch( const internal::parallelism_exception & ) {
-        }
+// Blocks from the scratch cache of the calling thread, aligned for a cache line. Returns nullptr if
+// the memory can't be allocated. A block can be released by any thread.
+void *scratch_allocate(size_t bytes) noexcept;
+void scratch_deallocate(void *ptr, size_t bytes) noexcept;
+
+template <class T>
+struct parallelism_allocator {
+    static_assert(alignof(T) <= hardware_destructive_interference_size);
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    parallelism_allocator() noexcept = default;
+
+    template <class Other>
+    parallelism_allocator(const parallelism_allocator<Other> &) noexcept
+    {
     }
-    return std::count_if(first, last, pred);
-}
 
-template <class FwdIt, class T>
-typename std::iterator_traits<FwdIt>::difference_type
-count(FwdIt first, FwdIt last, const T &value) noexcept
-{
-    return ::pstld::count_if(
-        first, last, [&value](const auto &iter_value) { return iter_value == value; });
-}
+    T *allocate(size_t count)
+    {
+        if( void *ptr = scratch_allocate(count * sizeof(T)) )
+            return static_cast<T *>(ptr);
+        else
+            parallelism_exception::raise();
+    }
 
-//--------------------------------------------------------------------------------------------------
-// find, find_if, find_if_not, find_first_of
-//--------------------------------------------------------------------------------------------------
+    void deallocate(T *ptr, size_t count) noexcept { scratch_deallocate(ptr, count * sizeof(T)); }
 
-namespace internal {
+    template <class Other>
+    bool operator==(const parallelism_allocator<Other> &) const noexcept
+    {
+        return true;
+    }
 
-template <class It, class Pred>
-struct Find : Dispatchable<Find<It, Pred>> {
-    Partition<It> m_partition;
-    MinIteratorResult<It> m_result;
-    Pred m_pred;
+    template <class Other>
+    bool operator!=(const parallelism_allocator<Other> &) const noexcept
+    {
+        return false;
+    }
+};
 
-    Find(size_t count, size_t chunks, It first, It last, Pred pred)
-        : m_partition(first, count, chunks), m_result{last}, m_pred(pred)
+template <class T>
+using parallelism_vector = std::vector<T, parallelism_allocator<T>>;
+
+template <class T>
+struct unitialized_array : parallelism_allocator<T> {
+    using allocator = parallelism_allocator<T>;
+    T *m_data;
+    size_t m_size;
+    unitialized_array(size_t size) : m_data(allocator::allocate(size)), m_size(size) {}
+
+    ~unitialized_array()
     {
+        std::destroy(m_data, m_data + m_size);
+        allocator::deallocate(m_data, m_size);
     }
 
-    void run(size_t ind) noexcept
+    template <class... Args>
+    void put(size_t ind, Args &&...vals) noexcept
     {
-        if( ind < m_result.min_chunk ) {
-            auto p = m_partition.at(ind);
-            auto it = std::find_if(p.first, p.last, m_pred);
-            if( it != p.last )
-                m_result.put(ind, it);
-        }
+        ::new(m_data + ind) T(std::forward<Args>(vals)...);
     }
+
+    T *begin() noexcept { return m_data; }
+
+    T *end() noexcept { return m_data + m_size; }
+
+    T &operator[](size_t ind) noexcept { return m_data[ind]; }
 };
 
-} // namespace internal
+// Decides whether 'count' elements costing about 'cost' picoseconds each are worth a parallel
+// call. Calls nested into other parallel calls run inline. An explicit serial_below property takes
+// precedence over both this and the cost model.
+inline bool worth_parallel(size_t count, size_t cost) noexcept
+{
+    const CallOptions *options = call_options();
+    if( options != nullptr && options->serial_below != serial_below_auto )
+        return count >= options->serial_below;
+    if( nesting_depth() != 0 )
+        return false;
+    return cost_model_allows(count, cost);
+}
 
-template <class FwdIt, class Pred>
-FwdIt find_if(FwdIt first, FwdIt last, Pred pred) noexcept
+// The number of chunks to split 'count' elements among 'workers' threads into, so that each chunk
+// gets at least 'min_chunk' elements. Calls made without tuning properties use the constants above.
+inline size_t split_chunks(size_t count, size_t min_chunk, size_t workers) noexcept
 {
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Find<FwdIt, Pred> op{static_cast<size_t>(count), chunks, first, last, pred};
-            op.dispatch_apply(chunks);
-            return op.m_result.min;
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::find_if(first, last, pred);
+    if( workers < 2 )
+        return 0;
+    const CallOptions *options = call_options();
+    if( options == nullptr )
+        return std::min(workers * chunks_per_cpu, count / min_chunk);
+    return std::min(workers * std::max(options->chunks_per_cpu, size_t(1)),
+                    count / std::max(options->grain, min_chunk));
 }
 
-template <class FwdIt, class T>
-FwdIt find(FwdIt first, FwdIt last, const T &value) noexcept
+// The number of chunks to split 'count' elements into for the workers available at the moment.
+// Less than 2 chunks means that the input should be processed serially.
+inline size_t work_chunks(size_t count, size_t min_chunk, size_t cost) noexcept
 {
-    return ::pstld::find_if(
-        first, last, [&value](const auto &iter_value) { return iter_value == value; });
+    if( !worth_parallel(count, cost) )
+        return 0;
+    return split_chunks(count, min_chunk, admissible_workers(max_workers()));
 }
 
-template <class FwdIt, class Pred>
-FwdIt find_if_not(FwdIt first, FwdIt last, Pred pred) noexcept
+template <size_t Cost = cost_invoke, class T>
+size_t work_chunks_min_fraction_1(T count)
 {
-    return ::pstld::find_if(
-        first, last, [&pred](const auto &value) { return !static_cast<bool>(pred(value)); });
+    return work_chunks(static_cast<size_t>(count), 1, Cost);
 }
 
-template <class FwdIt1, class FwdIt2>
-FwdIt1 find_first_of(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2) noexcept
+template <size_t Cost = cost_invoke, class T>
+size_t work_chunks_min_fraction_2(T count)
 {
-    return ::pstld::find_if(first1, last1, [first2, last2](const auto &value) {
-        return std::find(first2, last2, value) != last2;
-    });
+    return work_chunks(static_cast<size_t>(count), 2, Cost);
 }
 
-template <class FwdIt1, class FwdIt2, class Pred>
-FwdIt1 find_first_of(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2, Pred pred) noexcept
+inline size_t tuned_grain() noexcept
 {
-    return ::pstld::find_if(first1, last1, [first2, last2, &pred](const auto &value1) {
-        return std::find_if(first2, last2, [&value1, &pred](const auto &value2) {
-                   return static_cast<bool>(pred(value1, value2));
-               }) != last2;
-    });
+    const CallOptions *options = call_options();
+    return options != nullptr ? options->grain : 1;
 }
 
-//--------------------------------------------------------------------------------------------------
-// adjacent_find
-//--------------------------------------------------------------------------------------------------
+inline size_t tuned_chunks_per_cpu() noexcept
+{
+    const CallOptions *options = call_options();
+    return options != nullptr ? std::max(options->chunks_per_cpu, size_t(1)) : chunks_per_cpu;
+}
 
-namespace internal {
+template <class It>
+struct ItRange {
+    It first;
+    It last;
+};
 
-template <class It, class Pred>
-struct AdjacentFind : Dispatchable<AdjacentFind<It, Pred>> {
-    Partition<It> m_partition;
-    MinIteratorResult<It> m_result;
-    Pred m_pred;
+template <class It, bool Forward = true, bool IsRandomAccess = is_random_iterator_v<It>>
+struct Partition;
 
-    AdjacentFind(size_t count, size_t chunks, It first, It last, Pred pred)
-        : m_partition(first, count, chunks), m_result{last}, m_pred(pred)
+template <class It, bool Forward>
+struct Partition<It, Forward, true> {
+    It base;
+    size_t fraction;
+    size_t leftover;
+    size_t count;
+    Partition(It first, size_t count, size_t chunks) noexcept
+        : base(first), fraction(count / chunks), leftover(count % chunks), count(count)
     {
     }
 
-    void run(size_t ind) noexcept
+    ItRange<It> at(size_t chunk_no) const noexcept
     {
-        if( ind < m_result.min_chunk ) {
-            auto p = m_partition.at(ind);
-            for( auto it1 = p.first, it2 = p.first; it1 != p.last; it1 = it2 ) {
-                ++it2;
-                if( m_pred(*it1, *it2) ) {
-                    m_result.put(ind, it1);
-                    return;
-                }
+        if( leftover ) {
+            if( chunk_no >= leftover ) {
+                const auto first =
+                    advance(base, (fraction + 1) * leftover + fraction * (chunk_no - leftover));
+                const auto last = advance(first, fraction);
+                return {first, last};
+            }
+            else {
+                const auto first = advance(base, (fraction + 1) * chunk_no);
+                const auto last = advance(first, fraction + 1);
+                return {first, last};
             }
         }
+        else {
+            const auto first = advance(base, fraction * chunk_no);
+            const auto last = advance(first, fraction);
+            return {first, last};
+        }
     }
-};
 
-} // namespace internal
+    It end() const noexcept { return base + count; }
 
-template <class FwdIt, class Pred>
-FwdIt adjacent_find(FwdIt first, FwdIt last, Pred pred) noexcept
-{
-    const auto count = std::distance(first, last);
-    if( count > 1 ) {
-        const auto chunks = internal::work_chunks_min_fraction_1(count - 1);
-        if( chunks > 1 ) {
-            try {
-                internal::AdjacentFind<FwdIt, Pred> op{
-                    static_cast<size_t>(count - 1), chunks, first, last, pred};
-                op.dispatch_apply(chunks);
-                return op.m_result.min;
-            } catch( const internal::parallelism_exception & ) {
-            }
-        }
+    static It advance(It it, size_t distance) noexcept
+    {
+        if constexpr( Forward )
+            return it + distance;
+        else
+            return it - distance;
     }
-    return std::adjacent_find(first, last, pred);
-}
+};
+
+template <class It, bool Forward>
+struct Partition<It, Forward, false> {
+    parallelism_vector<ItRange<It>> segments;
+    Partition(It first, size_t count, size_t chunks) : segments(chunks)
+    {
+        size_t fraction = count / chunks;
+        size_t leftover = count % chunks;
+        It it = first;
+        for( size_t i = 0; i != chunks; ++i ) {
+            auto diff = fraction;
+            if( leftover != 0 ) {
+                ++diff;
+                --leftover;
+            }
+            auto last = advance(it, diff);
+            segments[i] = {it, last};
+            it = last;
+        }
+    }
+
+    ItRange<It> at(size_t chunk_no) const noexcept { return segments[chunk_no]; }
+
+    It end() const noexcept { return segments.back().last; }
+
+    static It advance(It it, size_t distance) noexcept
+    {
+        if constexpr( Forward )
+            return std::next(it, distance);
+        else
+            return std::prev(it, distance);
+    }
+};
+
+template <class It, bool = is_random_iterator_v<It> &&can_be_atomic_v<It>>
+struct MinIteratorResult;
+
+template <class It>
+struct MinIteratorResult<It, true> {
+    std::atomic<size_t> min_chunk;
+    std::atomic<It> min;
+    MinIteratorResult(It last) : min_chunk{std::numeric_limits<size_t>::max()}, min{last} {}
+
+    void put(size_t chunk, It it)
+    {
+        It prev_it = min;
+        while( prev_it > it && !min.compare_exchange_weak(prev_it, it) )
+            ;
+
+        size_t prev_chunk = min_chunk;
+        while( prev_chunk > chunk && !min_chunk.compare_exchange_weak(prev_chunk, chunk) )
+            ;
+    }
+};
+
+template <class It>
+struct MinIteratorResult<It, false> {
+    std::atomic<size_t> min_chunk;
+    It min;
+    std::mutex mutex;
+
+    MinIteratorResult(It last) : min_chunk{std::numeric_limits<size_t>::max()}, min{last} {}
+
+    void put(size_t chunk, It it)
+    {
+        size_t prev = std::numeric_limits<size_t>::max();
+        while( !min_chunk.compare_exchange_weak(prev, chunk) )
+            if( prev < chunk )
+                return;
+
+        std::lock_guard lock{mutex};
+        if( min_chunk == chunk )
+            min = it;
+    }
+};
+
+template <class It, bool = is_random_iterator_v<It> &&can_be_atomic_v<It>>
+struct MaxIteratorResult;
+
+template <class It>
+struct MaxIteratorResult<It, true> {
+    std::atomic<size_t> max_chunk;
+    std::atomic<It> max;
+    It last;
+
+    MaxIteratorResult(It last)
+        : max_chunk{std::numeric_limits<size_t>::max()}, max{last}, last(last)
+    {
+    }
+
+    void put(size_t chunk, It it)
+    {
+        It prev_it = max;
+        while( (prev_it == last || prev_it < it) && !max.compare_exchange_weak(prev_it, it) )
+            ;
+
+        size_t prev_chunk = max_chunk;
+        while( static_cast<ptrdiff_t>(prev_chunk) < static_cast<ptrdiff_t>(chunk) &&
+               !max_chunk.compare_exchange_weak(prev_chunk, chunk) )
+            ;
+    }
+};
+
+template <class It>
+struct MaxIteratorResult<It, false> {
+    std::atomic<size_t> max_chunk;
+    It max;
+    std::mutex mutex;
+
+    MaxIteratorResult(It last) : max_chunk{std::numeric_limits<size_t>::max()}, max{last} {}
+
+    void put(size_t chunk, It it)
+    {
+        size_t prev = std::numeric_limits<size_t>::max();
+        while( !max_chunk.compare_exchange_weak(prev, chunk) )
+            if( prev > chunk )
+                return;
+
+        std::lock_guard lock{mutex};
+        if( max_chunk == chunk )
+            max = it;
+    }
+};
+
+// Once the call is asked to stop, the chunks not started yet go to skip() instead of run(). The
+// algorithms which later read per-chunk results override it to put a cheap stand-in value.
+template <class T>
+struct Dispatchable {
+    const std::atomic<bool> *m_stop = current_stop_flag();
+#if defined(PSTLD_TRACING)
+    TracedCall *m_trace = current_trace_call();
+#endif
+
+    static void dispatch(void *ctx, size_t ind) noexcept
+    {
+        auto me = static_cast<T *>(ctx);
+#if defined(PSTLD_TRACING)
+        TraceChunk chunk{me->m_trace, ind};
+#endif
+        if( stop_requested(me->m_stop) )
+            me->skip(ind);
+        else
+            me->run(ind);
+    }
+    void dispatch_apply(size_t count) noexcept { internal::dispatch_apply(count, this, dispatch); }
+    void skip(size_t) noexcept {}
+};
+
+template <class T>
+struct Dispatchable2 {
+    const std::atomic<bool> *m_stop = current_stop_flag();
+#if defined(PSTLD_TRACING)
+    TracedCall *m_trace = current_trace_call();
+#endif
+
+    static void dispatch_first(void *ctx, size_t ind) noexcept
+    {
+        auto me = static_cast<T *>(ctx);
+#if defined(PSTLD_TRACING)
+        TraceChunk chunk{me->m_trace, ind};
+#endif
+        if( stop_requested(me->m_stop) )
+            me->skip_first(ind);
+        else
+            me->run_first(ind);
+    }
+    void dispatch_apply_first(size_t count) noexcept
+    {
+        internal::dispatch_apply(count, this, dispatch_first);
+    }
+    static void dispatch_second(void *ctx, size_t ind) noexcept
+    {
+        auto me = static_cast<T *>(ctx);
+#if defined(PSTLD_TRACING)
+        TraceChunk chunk{me->m_trace, ind};
+#endif
+        if( !stop_requested(me->m_stop) )
+            me->run_second(ind);
+    }
+    void skip_first(size_t) noexcept {}
+    void dispatch_apply_second(size_t count) noexcept
+    {
+        internal::dispatch_apply(count, this, dispatch_second);
+    }
+};
+
+// Objects retired via epoch_retire() are destroyed only after every thread that might have been
+// accessing them without a lock has left such access. Readers pin the current epoch for the
+// duration of the access with EpochPin, the global epoch advances once all pinned readers have
+// caught up with it, and a retired object is destroyed after two advances past its retirement.
+struct EpochRetired {
+    EpochRetired *retired_next = nullptr;
+    size_t retired_epoch = 0;
+    void (*deleter)(EpochRetired *) noexcept = nullptr;
+};
+
+struct EpochSlot;
+
+class EpochPin
+{
+public:
+    EpochPin() noexcept;
+    EpochPin(const EpochPin &) = delete;
+    EpochPin &operator=(const EpochPin &) = delete;
+    ~EpochPin();
+
+private:
+    EpochSlot *m_slot;
+};
+
+void epoch_retire(EpochRetired *retired) noexcept;
+
+// Destroys the retired objects which are no longer reachable, if there are any.
+void epoch_collect() noexcept;
+
+template <class T>
+struct CircularArray : EpochRetired {
+    static_assert(std::is_trivial_v<T>);
+    static constexpr size_t default_log_size = 6;
+
+    // Elements are stored as words accessed via relaxed atomics: a thief can read a slot which is
+    // being overwritten by the owner at the same time, such a read is discarded afterwards since
+    // the thief's CAS on top fails, but it must not be a data race.
+    static constexpr size_t words = (sizeof(T) + sizeof(uintptr_t) - 1) / sizeof(uintptr_t);
+    using Word = std::atomic<uintptr_t>;
+
+    size_t m_log_size;
+
+    static size_t bytes(size_t log_size) noexcept
+    {
+        return sizeof(CircularArray) + sizeof(Word) * words * (static_cast<size_t>(1) << log_size);
+    }
+
+    static CircularArray *alloc(size_t log_size = default_log_size)
+    {
+        void *buffer = scratch_allocate(bytes(log_size));
+        if( buffer == nullptr )
+            parallelism_exception::raise();
+
+        auto array = ::new(buffer) CircularArray;
+        array->deleter = destroy;
+        array->m_log_size = log_size;
+        std::uninitialized_default_construct_n(array->data(), words * array->size());
+        return array;
+    }
+
+    static void destroy(EpochRetired *retired) noexcept
+    {
+        auto array = static_cast<CircularArray *>(retired);
+        scratch_deallocate(array, bytes(array->m_log_size));
+    }
+
+    constexpr size_t size() noexcept { return static_cast<size_t>(1) << m_log_size; }
+
+    T load(int64_t ind) noexcept
+    {
+        uintptr_t buffer[words];
+        Word *slot = at(ind);
+        for( size_t i = 0; i != words; ++i )
+            buffer[i] = slot[i].load(std::memory_order_relaxed);
+        T val;
+        std::memcpy(&val, buffer, sizeof(T));
+        return val;
+    }
+
+    void store(int64_t ind, const T &val) noexcept
+    {
+        uintptr_t buffer[words] = {};
+        std::memcpy(buffer, &val, sizeof(T));
+        Word *slot = at(ind);
+        for( size_t i = 0; i != words; ++i )
+            slot[i].store(buffer[i], std::memory_order_relaxed);
+    }
+
+    CircularArray *grow(int64_t bottom, int64_t top)
+    {
+        auto grown = alloc(m_log_size + 1);
+        for( int64_t ind = top; ind != bottom; ++ind )
+            grown->store(ind, load(ind));
+        return grown;
+    }
+
+private:
+    Word *data() noexcept { return reinterpret_cast<Word *>(this + 1); }
+
+    Word *at(int64_t ind) noexcept
+    {
+        const size_t mask = size() - 1;
+        return data() + (static_cast<size_t>(ind) & mask) * words;
+    }
+};
+
+// Chase-Lev work-stealing deque with the memory orderings from "Correct and Efficient Work-Stealing
+// for Weak Memory Models" (Lê, Pop, Cohen, Zappa Nardelli). Only the owner pushes and pops at the
+// bottom, any thread can steal from the top. Arrays replaced by growth are reclaimed via epochs.
+template <class T>
+struct alignas(hardware_destructive_interference_size) CircularWorkStealingDeque {
+    std::atomic<int64_t> m_bottom{0};
+    std::atomic<CircularArray<T> *> m_array{CircularArray<T>::alloc()};
+    alignas(hardware_destructive_interference_size) std::atomic<int64_t> m_top{0};
+
+    CircularWorkStealingDeque() = default;
+    CircularWorkStealingDeque(const CircularWorkStealingDeque &) = delete;
+    CircularWorkStealingDeque &operator=(const CircularWorkStealingDeque &) = delete;
+    ~CircularWorkStealingDeque()
+    {
+        CircularArray<T>::destroy(m_array.load(std::memory_order_relaxed));
+        epoch_collect();
+    }
+
+    void push_bottom(const T &val)
+    {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const int64_t top = m_top.load(std::memory_order_acquire);
+        CircularArray<T> *array = m_array.load(std::memory_order_relaxed);
+        if( bottom - top > static_cast<int64_t>(array->size()) - 1 ) {
+            CircularArray<T> *grown = array->grow(bottom, top);
+            m_array.store(grown, std::memory_order_release);
+            epoch_retire(array);
+            array = grown;
+        }
+        array->store(bottom, val);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    bool pop_bottom(T &val) noexcept
+    {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        CircularArray<T> *array = m_array.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_relaxed);
+        if( top > bottom ) {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        val = array->load(bottom);
+        if( top < bottom )
+            return true;
+
+        // the last element, race against the thieves for it
+        const bool taken = m_top.compare_exchange_strong(
+            top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return taken;
+    }
+
+    bool steal_top(T &val) noexcept
+    {
+        // cheap check which lets idle workers poll empty deques without pinning an epoch
+        if( m_top.load(std::memory_order_acquire) >= m_bottom.load(std::memory_order_acquire) )
+            return false;
+
+        EpochPin pin;
+        int64_t top = m_top.load(std::memory_order_acquire);
+        while( true ) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+            if( top >= bottom )
+                return false;
+            CircularArray<T> *array = m_array.load(std::memory_order_acquire);
+            const T stolen = array->load(top);
+            if( m_top.compare_exchange_strong(
+                    top, top + 1, std::memory_order_seq_cst, std::memory_order_acquire) ) {
+                val = stolen;
+                return true;
+            }
+        }
+    }
+};
+
+struct alignas(hardware_destructive_interference_size) WorkCounter {
+    std::atomic<size_t> m_done{0};
+    void commit_relaxed(size_t newly_done) noexcept
+    {
+        size_t done = m_done.load(std::memory_order_relaxed);
+        m_done.store(done + newly_done, std::memory_order_relaxed);
+    }
+    size_t load_relaxed() noexcept { return m_done.load(std::memory_order_relaxed); }
+};
+
+inline void cpu_relax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+// Lets the idle workers of a fork-join computation back off and eventually sleep instead of
+// burning CPU while the last pieces of work are being finished by others. New work and the
+// completion are signalled by bumping an epoch, which a parked worker waits to change.
+class Parking
+{
+public:
+    explicit Parking(const execution::idle_strategy &strategy) noexcept : m_strategy(strategy) {}
+
+    size_t epoch() const noexcept { return m_epoch.load(); }
+
+    bool finished() const noexcept { return m_finished.load(); }
+
+    // 'round' counts the consecutive unsuccessful attempts of the calling worker to find work,
+    // 'epoch' must have been read before these attempts.
+    void idle(size_t &round, size_t epoch) noexcept
+    {
+        if( round < m_strategy.spins ) {
+            for( size_t i = 0, spins = size_t(1) << std::min(round, size_t(16)); i != spins; ++i )
+                cpu_relax();
+        }
+        else if( round < m_strategy.spins + m_strategy.yields || !m_strategy.park ) {
+            count_yield();
+            std::this_thread::yield();
+        }
+        else {
+            // pairs with the increment of m_epoch in notify(), both are sequentially consistent
+            m_sleepers.fetch_add(1);
+            {
+                std::unique_lock lock{m_mutex};
+                m_cv.wait(lock, [&] { return m_epoch.load() != epoch || m_finished.load(); });
+            }
+            m_sleepers.fetch_sub(1);
+            round = 0;
+            return;
+        }
+        ++round;
+    }
+
+    // Signals that new work was made available.
+    void notify() noexcept
+    {
+        m_epoch.fetch_add(1);
+        if( m_sleepers.load() != 0 ) {
+            {
+                std::lock_guard lock{m_mutex};
+            }
+            m_cv.notify_one();
+        }
+    }
+
+    // Wakes up all parked workers, e.g. when some of them wait for a particular event.
+    void notify_all() noexcept
+    {
+        m_epoch.fetch_add(1);
+        if( m_sleepers.load() != 0 ) {
+            {
+                std::lock_guard lock{m_mutex};
+            }
+            m_cv.notify_all();
+        }
+    }
+
+    // Signals that the computation is complete and releases all parked workers.
+    void finish() noexcept
+    {
+        m_finished.store(true);
+        m_epoch.fetch_add(1);
+        if( m_sleepers.load() != 0 ) {
+            {
+                std::lock_guard lock{m_mutex};
+            }
+            m_cv.notify_all();
+        }
+    }
+
+    // Prepares for another computation, must not be called while any worker is still running.
+    void reset() noexcept { m_finished.store(false); }
+
+private:
+    execution::idle_strategy m_strategy;
+    std::atomic<size_t> m_epoch{0};
+    std::atomic<size_t> m_sleepers{0};
+    std::atomic<bool> m_finished{false};
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
+inline execution::idle_strategy current_idle_strategy() noexcept
+{
+    const CallOptions *options = call_options();
+    return options != nullptr ? options->idle : execution::idle_strategy{};
+}
+
+// The engine of the fork-join computations: each worker owns a deque of pending work items, takes
+// its own items from the bottom and steals from the tops of the others' deques once it runs dry.
+// Workers that found nothing to do back off via Parking. Worker 0 is the thread which started the
+// computation, the others get their indices from next_worker_index() when they join.
+template <class Work>
+class WorkStealingTeam
+{
+public:
+    explicit WorkStealingTeam(size_t workers)
+        : m_workers(workers), m_queues(workers), m_parking(current_idle_strategy())
+    {
+    }
+
+    size_t workers() const noexcept { return m_workers; }
+
+    size_t next_worker_index() noexcept { return m_next_worker_index++; }
+
+    // Makes the work item available to the team. Returns false if it couldn't be queued, the
+    // caller has to execute it in-place then.
+    bool fork(size_t worker_index, const Work &work) noexcept
+    {
+        try {
+            m_queues[worker_index].push_bottom(work);
+        } catch( const parallelism_exception & ) {
+            return false;
+        }
+        m_parking.notify();
+        return true;
+    }
+
+    // Executes the local and the stolen work items until either 'done()' returns true or the team
+    // is finished. 'done' is checked only when the worker has found nothing to execute.
+    template <class Execute, class Done>
+    void work(size_t worker_index, Execute &&execute, Done &&done) noexcept
+    {
+        Work w;
+        size_t round = 0;
+#if defined(PSTLD_TRACING)
+        bool idle = false;
+        const auto busy = [&idle, worker_index] {
+            if( std::exchange(idle, false) )
+                trace_record('E', "idle", "worker", worker_index);
+        };
+#endif
+        while( true ) {
+            const size_t epoch = m_parking.epoch();
+            if( m_queues[worker_index].pop_bottom(w) ) {
+                // have a local work to do
+#if defined(PSTLD_TRACING)
+                busy();
+#endif
+                execute(w);
+                round = 0;
+                continue;
+            }
+
+            bool stolen = false;
+            for( size_t i = 1; i != m_workers && !stolen; ++i ) {
+                size_t steal_index = (i + worker_index) % m_workers;
+                stolen = m_queues[steal_index].steal_top(w);
+                count_steal(stolen);
+                if( stolen ) {
+                    // stolen from an other queue
+#if defined(PSTLD_TRACING)
+                    busy();
+                    trace_record('i', "steal", "victim", steal_index);
+#endif
+                    execute(w);
+                }
+            }
+            if( stolen ) {
+                round = 0;
+                continue;
+            }
+
+            // nothing to do - perhaps we are done?
+            if( m_parking.finished() || done() )
+                break;
+
+            // back off, give up execution or park until there's more work
+#if defined(PSTLD_TRACING)
+            if( !std::exchange(idle, true) )
+                trace_record('B', "idle", "worker", worker_index);
+#endif
+            m_parking.idle(round, epoch);
+        }
+#if defined(PSTLD_TRACING)
+        busy();
+#endif
+    }
+
+    // Makes all workers leave work().
+    void finish() noexcept { m_parking.finish(); }
+
+    // Wakes up the parked workers so they re-check their 'done' conditions.
+    void notify_all() noexcept { m_parking.notify_all(); }
+
+    // Prepares the team for another computation once all workers have left.
+    void reset() noexcept
+    {
+        m_parking.reset();
+        m_next_worker_index.store(1);
+    }
+
+private:
+    const size_t m_workers;
+    std::atomic<size_t> m_next_worker_index{1};
+    parallelism_vector<CircularWorkStealingDeque<Work>> m_queues;
+    Parking m_parking;
+};
+
+} // namespace internal
+
+//--------------------------------------------------------------------------------------------------
+//
+// Algorithms implementation
+//
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+// reduce, transform_reduce
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class T, class BinOp, class UnOp>
+struct TransformReduce : Dispatchable<TransformReduce<It, T, BinOp, UnOp>> {
+    Partition<It> m_partition;
+    unitialized_array<T> m_results;
+    BinOp m_reduce;
+    UnOp m_transform;
+
+    TransformReduce(size_t count, size_t chunks, It first, BinOp reduce_op, UnOp transform_op)
+        : m_partition(first, count, chunks), m_results(chunks), m_reduce(reduce_op),
+          m_transform(transform_op)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p = m_partition.at(ind);
+        m_results.put(ind, transform_reduce_at_least_2(p.first, p.last));
+    }
+
+    void skip(size_t ind) noexcept
+    {
+        auto p = m_partition.at(ind);
+        m_results.put(ind, transform_reduce_at_least_2(p.first, std::next(p.first, 2)));
+    }
+
+    T transform_reduce_at_least_2(It first, It last)
+    {
+        auto next = first;
+        T val = m_reduce(m_transform(*first), m_transform(*++next));
+        while( ++next != last )
+            val = m_reduce(std::move(val), m_transform(*next));
+        return val;
+    }
+};
+
+template <class It, class T, class BinOp>
+T move_reduce(It first, It last, T val, BinOp reduce)
+{
+    for( ; first != last; ++first )
+        val = reduce(std::move(val), std::move(*first));
+    return val;
+}
+
+template <class It, class T, class BinOp, class UnOp>
+T move_transform_reduce(It first, It last, T val, BinOp reduce, UnOp transform)
+{
+    for( ; first != last; ++first )
+        val = reduce(std::move(val), transform(std::move(*first)));
+    return val;
+}
+
+} // namespace internal
+
+template <class FwdIt, class T, class BinOp, class UnOp>
+T transform_reduce(FwdIt first, FwdIt last, T val, BinOp reduce_op, UnOp transform_op) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_2(count);
+    internal::TraceCall trace(algorithm::transform_reduce, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::TransformReduce<FwdIt, T, BinOp, UnOp> op{
+                static_cast<size_t>(count), chunks, first, reduce_op, transform_op};
+            op.dispatch_apply(chunks);
+            return internal::move_reduce(
+                op.m_results.begin(), op.m_results.end(), std::move(val), reduce_op);
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return internal::move_transform_reduce(first, last, std::move(val), reduce_op, transform_op);
+}
+
+template <class It>
+internal::iterator_value_t<It> reduce(It first, It last) noexcept
+{
+    using T = internal::iterator_value_t<It>;
+    return ::pstld::transform_reduce(first, last, T{}, std::plus<>{}, ::pstld::internal::no_op{});
+}
+
+template <class It, class T>
+T reduce(It first, It last, T val) noexcept
+{
+    return ::pstld::transform_reduce(
+        first, last, std::move(val), std::plus<>{}, ::pstld::internal::no_op{});
+}
+
+template <class It, class T, class BinOp>
+T reduce(It first, It last, T val, BinOp op) noexcept
+{
+    return ::pstld::transform_reduce(first, last, std::move(val), op, ::pstld::internal::no_op{});
+}
+
+namespace internal {
+
+template <class It1, class It2, class T, class BinRedOp, class BinTrOp>
+struct TransformReduce2 : Dispatchable<TransformReduce2<It1, It2, T, BinRedOp, BinTrOp>> {
+    Partition<It1> m_partition1;
+    Partition<It2> m_partition2;
+    unitialized_array<T> m_results;
+    BinRedOp m_reduce;
+    BinTrOp m_transform;
+
+    TransformReduce2(size_t count,
+                     size_t chunks,
+                     It1 first1,
+                     It2 first2,
+                     BinRedOp reduce_op,
+                     BinTrOp transform_op)
+        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks),
+          m_results(chunks), m_reduce(reduce_op), m_transform(transform_op)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p1 = m_partition1.at(ind);
+        auto p2 = m_partition2.at(ind);
+        m_results.put(ind, transform_reduce_at_least_2(p1.first, p1.last, p2.first));
+    }
+
+    void skip(size_t ind) noexcept
+    {
+        auto p1 = m_partition1.at(ind);
+        auto p2 = m_partition2.at(ind);
+        m_results.put(ind, transform_reduce_at_least_2(p1.first, std::next(p1.first, 2), p2.first));
+    }
+
+    T transform_reduce_at_least_2(It1 first1, It1 last1, It2 first2)
+    {
+        auto next1 = first1;
+        auto next2 = first2;
+        T val = m_reduce(m_transform(*first1, *first2), m_transform(*++next1, *++next2));
+        while( ++next1 != last1 )
+            val = m_reduce(std::move(val), m_transform(*next1, *++next2));
+        return val;
+    }
+};
+
+template <class It1, class It2, class T, class BinOp, class UnOp>
+T move_transform_reduce(It1 first1, It1 last1, It2 first2, T val, BinOp reduce, UnOp transform)
+{
+    for( ; first1 != last1; ++first1, ++first2 )
+        val = reduce(std::move(val), transform(std::move(*first1), std::move(*first2)));
+    return val;
+}
+
+} // namespace internal
+
+template <class FwdIt1, class FwdIt2, class T, class BinRedOp, class BinTrOp>
+T transform_reduce(FwdIt1 first1,
+                   FwdIt1 last1,
+                   FwdIt2 first2,
+                   T val,
+                   BinRedOp reduce_op,
+                   BinTrOp transform_op) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    const auto chunks = internal::work_chunks_min_fraction_2(count);
+    internal::TraceCall trace(algorithm::transform_reduce, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::TransformReduce2<FwdIt1, FwdIt2, T, BinRedOp, BinTrOp> op{
+                static_cast<size_t>(count), chunks, first1, first2, reduce_op, transform_op};
+            op.dispatch_apply(chunks);
+            return internal::move_reduce(
+                op.m_results.begin(), op.m_results.end(), std::move(val), reduce_op);
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return internal::move_transform_reduce(
+        first1, last1, first2, std::move(val), reduce_op, transform_op);
+}
+
+template <class It1, class It2, class T>
+T transform_reduce(It1 first1, It1 last1, It2 first2, T val) noexcept
+{
+    return ::pstld::transform_reduce(
+        first1, last1, first2, std::move(val), std::plus<>{}, std::multiplies<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// all_of, none_of, any_of
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class UnPred, bool Expected, bool Init>
+struct AllOf : Dispatchable<AllOf<It, UnPred, Expected, Init>> {
+    Partition<It> m_partition;
+    UnPred m_pred;
+    std::atomic_bool m_done{false};
+    bool m_result = Init;
+
+    AllOf(size_t count, size_t chunks, It first, UnPred pred)
+        : m_partition(first, count, chunks), m_pred(pred)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        if( m_done )
+            return;
+        for( auto p = m_partition.at(ind); p.first != p.last; ++p.first )
+            if( static_cast<bool>(m_pred(*p.first)) == !Expected ) {
+                m_done = true;
+                m_result = !Init;
+                return;
+            }
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt, class UnPred>
+bool all_of(FwdIt first, FwdIt last, UnPred pred) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_1(count);
+    internal::TraceCall trace(algorithm::all_of, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::AllOf<FwdIt, UnPred, true, true> op{
+                static_cast<size_t>(count), chunks, first, pred};
+            op.dispatch_apply(chunks);
+            return op.m_result;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::all_of(first, last, pred);
+}
+
+template <class FwdIt, class UnPred>
+bool none_of(FwdIt first, FwdIt last, UnPred pred) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_1(count);
+    internal::TraceCall trace(algorithm::none_of, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::AllOf<FwdIt, UnPred, false, true> op{
+                static_cast<size_t>(count), chunks, first, pred};
+            op.dispatch_apply(chunks);
+            return op.m_result;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::none_of(first, last, pred);
+}
+
+template <class FwdIt, class UnPred>
+bool any_of(FwdIt first, FwdIt last, UnPred pred) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_1(count);
+    internal::TraceCall trace(algorithm::any_of, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::AllOf<FwdIt, UnPred, false, false> op{
+                static_cast<size_t>(count), chunks, first, pred};
+            op.dispatch_apply(chunks);
+            return op.m_result;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::any_of(first, last, pred);
+}
+
+//--------------------------------------------------------------------------------------------------
+// for_each, for_each_n
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class Func>
+struct ForEach : Dispatchable<ForEach<It, Func>> {
+    Partition<It> m_partition;
+    Func m_func;
+
+    ForEach(size_t count, size_t chunks, It first, Func func)
+        : m_partition(first, count, chunks), m_func(func)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        for( auto p = m_partition.at(ind); p.first != p.last; ++p.first )
+            m_func(*p.first);
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt, class Func>
+void for_each(FwdIt first, FwdIt last, Func func) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_1(count);
+    internal::TraceCall trace(algorithm::for_each, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::ForEach<FwdIt, Func> op{static_cast<size_t>(count), chunks, first, func};
+            op.dispatch_apply(chunks);
+            return;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    std::for_each(first, last, func);
+}
+
+template <class FwdIt, class Size, class Func>
+FwdIt for_each_n(FwdIt first, Size count, Func func) noexcept
+{
+    const auto chunks = internal::work_chunks_min_fraction_1(count);
+    internal::TraceCall trace(algorithm::for_each_n, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::ForEach<FwdIt, Func> op{static_cast<size_t>(count), chunks, first, func};
+            op.dispatch_apply(chunks);
+            return op.m_partition.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::for_each_n(first, count, func);
+}
+
+//--------------------------------------------------------------------------------------------------
+// count, count_if
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class Pred>
+struct Count : Dispatchable<Count<It, Pred>> {
+    Partition<It> m_partition;
+    Pred m_pred;
+    std::atomic<iterator_diff_t<It>> m_result{};
+
+    Count(size_t count, size_t chunks, It first, Pred pred)
+        : m_partition(first, count, chunks), m_pred(pred)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p = m_partition.at(ind);
+        m_result += std::count_if(p.first, p.last, m_pred);
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt, class Pred>
+typename std::iterator_traits<FwdIt>::difference_type
+count_if(FwdIt first, FwdIt last, Pred pred) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_1(count);
+    internal::TraceCall trace(algorithm::count_if, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Count<FwdIt, Pred> op{static_cast<size_t>(count), chunks, first, pred};
+            op.dispatch_apply(chunks);
+            return op.m_result;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::count_if(first, last, pred);
+}
+
+template <class FwdIt, class T>
+typename std::iterator_traits<FwdIt>::difference_type
+count(FwdIt first, FwdIt last, const T &value) noexcept
+{
+    return ::pstld::count_if(
+        first, last, [&value](const auto &iter_value) { return iter_value == value; });
+}
+
+//--------------------------------------------------------------------------------------------------
+// find, find_if, find_if_not, find_first_of
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class Pred>
+struct Find : Dispatchable<Find<It, Pred>> {
+    Partition<It> m_partition;
+    MinIteratorResult<It> m_result;
+    Pred m_pred;
+
+    Find(size_t count, size_t chunks, It first, It last, Pred pred)
+        : m_partition(first, count, chunks), m_result{last}, m_pred(pred)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        if( ind < m_result.min_chunk ) {
+            auto p = m_partition.at(ind);
+            auto it = std::find_if(p.first, p.last, m_pred);
+            if( it != p.last )
+                m_result.put(ind, it);
+        }
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt, class Pred>
+FwdIt find_if(FwdIt first, FwdIt last, Pred pred) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_1(count);
+    internal::TraceCall trace(algorithm::find_if, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Find<FwdIt, Pred> op{static_cast<size_t>(count), chunks, first, last, pred};
+            op.dispatch_apply(chunks);
+            return op.m_result.min;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::find_if(first, last, pred);
+}
+
+template <class FwdIt, class T>
+FwdIt find(FwdIt first, FwdIt last, const T &value) noexcept
+{
+    return ::pstld::find_if(
+        first, last, [&value](const auto &iter_value) { return iter_value == value; });
+}
+
+template <class FwdIt, class Pred>
+FwdIt find_if_not(FwdIt first, FwdIt last, Pred pred) noexcept
+{
+    return ::pstld::find_if(
+        first, last, [&pred](const auto &value) { return !static_cast<bool>(pred(value)); });
+}
+
+template <class FwdIt1, class FwdIt2>
+FwdIt1 find_first_of(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2) noexcept
+{
+    return ::pstld::find_if(first1, last1, [first2, last2](const auto &value) {
+        return std::find(first2, last2, value) != last2;
+    });
+}
+
+template <class FwdIt1, class FwdIt2, class Pred>
+FwdIt1 find_first_of(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2, Pred pred) noexcept
+{
+    return ::pstld::find_if(first1, last1, [first2, last2, &pred](const auto &value1) {
+        return std::find_if(first2, last2, [&value1, &pred](const auto &value2) {
+                   return static_cast<bool>(pred(value1, value2));
+               }) != last2;
+    });
+}
+
+//--------------------------------------------------------------------------------------------------
+// adjacent_find
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class Pred>
+struct AdjacentFind : Dispatchable<AdjacentFind<It, Pred>> {
+    Partition<It> m_partition;
+    MinIteratorResult<It> m_result;
+    Pred m_pred;
+
+    AdjacentFind(size_t count, size_t chunks, It first, It last, Pred pred)
+        : m_partition(first, count, chunks), m_result{last}, m_pred(pred)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        if( ind < m_result.min_chunk ) {
+            auto p = m_partition.at(ind);
+            for( auto it1 = p.first, it2 = p.first; it1 != p.last; it1 = it2 ) {
+                ++it2;
+                if( m_pred(*it1, *it2) ) {
+                    m_result.put(ind, it1);
+                    return;
+                }
+            }
+        }
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt, class Pred>
+FwdIt adjacent_find(FwdIt first, FwdIt last, Pred pred) noexcept
+{
+    const auto count = std::distance(first, last);
+    internal::TraceCall trace(algorithm::adjacent_find, count, 0);
+    if( count > 1 ) {
+        const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_compare>(count - 1);
+        trace.planned(chunks);
+        if( chunks > 1 ) {
+            try {
+                internal::AdjacentFind<FwdIt, Pred> op{
+                    static_cast<size_t>(count - 1), chunks, first, last, pred};
+                op.dispatch_apply(chunks);
+                return op.m_result.min;
+            } catch( const internal::parallelism_exception & ) {
+                trace.fallback();
+            }
+        }
+    }
+    return std::adjacent_find(first, last, pred);
+}
+
+template <class FwdIt>
+FwdIt adjacent_find(FwdIt first, FwdIt last) noexcept
+{
+    return ::pstld::adjacent_find(
+        first, last, [](const auto &v1, const auto &v2) { return v1 == v2; });
+}
+
+//--------------------------------------------------------------------------------------------------
+// search
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It1, class It2, class Pred>
+struct Search : Dispatchable<Search<It1, It2, Pred>> {
+    Partition<It1> m_partition;
+    MinIteratorResult<It1> m_result;
+    Pred m_pred;
+    It2 m_first2;
+    It2 m_last2;
+
+    Search(size_t count, size_t chunks, It1 first1, It1 last1, It2 first2, It2 last2, Pred pred)
+        : m_partition(first1, count, chunks), m_result{last1}, m_pred(pred), m_first2(first2),
+          m_last2(last2)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        if( ind < m_result.min_chunk ) {
+            for( auto p = m_partition.at(ind); p.first != p.last; ++p.first ) {
+                auto i1 = p.first;
+                auto i2 = m_first2;
+                for( ;; ++i1, ++i2 ) {
+                    if( i2 == m_last2 ) {
+                        m_result.put(ind, p.first);
+                        return;
+                    }
+                    if( !m_pred(*i1, *i2) )
+                        break;
+                }
+            }
+        }
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt1, class FwdIt2, class Pred>
+FwdIt1 search(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2, Pred pred) noexcept
+{
+    const auto count1 = std::distance(first1, last1);
+    internal::TraceCall trace(algorithm::search, count1, 0);
+    if( count1 == 0 || first2 == last2 )
+        return first1;
+
+    const auto count2 = std::distance(first2, last2);
+    if( count1 < count2 )
+        return last1;
+    if( count1 == count2 )
+        return std::equal(first1, last1, first2, last2, pred) ? first1 : last1;
+
+    const auto count = count1 - count2 + 1;
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_compare>(count);
+    trace.planned(chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Search<FwdIt1, FwdIt2, Pred> op{
+                static_cast<size_t>(count), chunks, first1, last1, first2, last2, pred};
+            op.dispatch_apply(chunks);
+            return op.m_result.min;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::search(first1, last1, first2, last2, pred);
+}
+
+template <class FwdIt1, class FwdIt2>
+FwdIt1 search(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2) noexcept
+{
+    return ::pstld::search(
+        first1, last1, first2, last2, [](const auto &v1, const auto &v2) { return v1 == v2; });
+}
+
+//--------------------------------------------------------------------------------------------------
+// search_n
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class T, class Pred>
+struct SearchN : Dispatchable<SearchN<It, T, Pred>> {
+    Partition<It> m_partition;
+    MinIteratorResult<It> m_result;
+    Pred m_pred;
+    const T &m_val;
+    size_t m_seq;
+
+    SearchN(size_t count, size_t chunks, It first, It last, Pred pred, const T &val, size_t seq)
+        : m_partition(first, count, chunks), m_result{last}, m_pred(pred), m_val(val), m_seq(seq)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        if( ind < m_result.min_chunk ) {
+            for( auto p = m_partition.at(ind); p.first != p.last; ++p.first ) {
+                auto it = p.first;
+                for( size_t s = 0;; ++it, ++s ) {
+                    if( s == m_seq ) {
+                        m_result.put(ind, p.first);
+                        return;
+                    }
+                    if( !m_pred(*it, m_val) )
+                        break;
+                }
+            }
+        }
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt, class Size, class T, class Pred>
+FwdIt search_n(FwdIt first, FwdIt last, Size count2, const T &value, Pred pred) noexcept
+{
+    const auto count1 = std::distance(first, last);
+    internal::TraceCall trace(algorithm::search_n, count1, 0);
+    if( count1 == 0 || count2 <= Size{} )
+        return first;
+
+    if( static_cast<Size>(count1) < count2 )
+        return last;
+    if( static_cast<Size>(count1) == count2 )
+        return std::all_of(first, last, [&](const auto &v) { return pred(v, value); }) ? first
+                                                                                       : last;
+
+    const auto count = count1 - count2 + 1;
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_compare>(count);
+    trace.planned(chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::SearchN<FwdIt, T, Pred> op{static_cast<size_t>(count),
+                                                 chunks,
+                                                 first,
+                                                 last,
+                                                 pred,
+                                                 value,
+                                                 static_cast<size_t>(count2)};
+            op.dispatch_apply(chunks);
+            return op.m_result.min;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::search_n(first, last, count2, value, pred);
+}
+
+template <class FwdIt, class Size, class T>
+FwdIt search_n(FwdIt first, FwdIt last, Size count2, const T &value) noexcept
+{
+    return ::pstld::search_n(first, last, count2, value, std::equal_to<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// find_end
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It1, class It2, class Pred>
+struct FindEnd : Dispatchable<FindEnd<It1, It2, Pred>> {
+    Partition<It1> m_partition;
+    MaxIteratorResult<It1> m_result;
+    Pred m_pred;
+    It2 m_first2;
+    It2 m_last2;
+
+    FindEnd(size_t count, size_t chunks, It1 first1, It1 last1, It2 first2, It2 last2, Pred pred)
+        : m_partition(first1, count, chunks), m_result{last1}, m_pred(pred), m_first2(first2),
+          m_last2(last2)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        if( static_cast<ptrdiff_t>(ind) < static_cast<ptrdiff_t>(m_result.max_chunk) )
+            return;
+
+        auto p = m_partition.at(ind);
+        if constexpr( is_bidirectional_iterator_v<It1> ) {
+            do {
+                --p.last;
+                auto i1 = p.last;
+                auto i2 = m_first2;
+                for( ;; ++i1, ++i2 ) {
+                    if( i2 == m_last2 ) {
+                        m_result.put(ind, p.last);
+                        return;
+                    }
+                    if( !m_pred(*i1, *i2) )
+                        break;
+                }
+            } while( p.first != p.last );
+        }
+        else {
+            auto result = p.last;
+            for( ; p.first != p.last; ++p.first ) {
+                auto i1 = p.first;
+                auto i2 = m_first2;
+                for( ;; ++i1, ++i2 ) {
+                    if( i2 == m_last2 ) {
+                        result = p.first;
+                        break;
+                    }
+                    if( !m_pred(*i1, *i2) )
+                        break;
+                }
+            }
+            if( result != p.last )
+                m_result.put(ind, result);
+        }
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt1, class FwdIt2, class Pred>
+FwdIt1 find_end(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2, Pred pred) noexcept
+{
+    const auto count1 = std::distance(first1, last1);
+    internal::TraceCall trace(algorithm::find_end, count1, 0);
+    if( count1 == 0 )
+        return first1;
+    if( first2 == last2 )
+        return last1;
+
+    const auto count2 = std::distance(first2, last2);
+    if( count1 < count2 )
+        return last1;
+    if( count1 == count2 )
+        return std::equal(first1, last1, first2, last2, pred) ? first1 : last1;
+
+    const auto count = count1 - count2 + 1;
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_compare>(count);
+    trace.planned(chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::FindEnd<FwdIt1, FwdIt2, Pred> op{
+                static_cast<size_t>(count), chunks, first1, last1, first2, last2, pred};
+            op.dispatch_apply(chunks);
+            return op.m_result.max;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::find_end(first1, last1, first2, last2, pred);
+}
+
+template <class FwdIt1, class FwdIt2>
+FwdIt1 find_end(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2) noexcept
+{
+    return ::pstld::find_end(
+        first1, last1, first2, last2, [](const auto &v1, const auto &v2) { return v1 == v2; });
+}
+
+//--------------------------------------------------------------------------------------------------
+// is_sorted
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class Cmp>
+struct IsSorted : Dispatchable<IsSorted<It, Cmp>> {
+    Partition<It> m_partition;
+    Cmp m_cmp;
+    std::atomic_bool m_done{false};
+    bool m_result = true;
+
+    IsSorted(size_t count, size_t chunks, It first, Cmp cmp)
+        : m_partition(first, count, chunks), m_cmp(cmp)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        if( m_done == false ) {
+            auto p = m_partition.at(ind);
+            for( auto it1 = p.first, it2 = p.first; it1 != p.last; it1 = it2 ) {
+                ++it2;
+                if( m_cmp(*it2, *it1) ) {
+                    m_done = true;
+                    m_result = false;
+                    return;
+                }
+            }
+        }
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt, class Cmp>
+bool is_sorted(FwdIt first, FwdIt last, Cmp cmp)
+{
+    const auto count = std::distance(first, last);
+    internal::TraceCall trace(algorithm::is_sorted, count, 0);
+    if( count > 2 ) {
+        const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_compare>(count - 1);
+        trace.planned(chunks);
+        if( chunks > 1 ) {
+            try {
+                internal::IsSorted<FwdIt, Cmp> op{
+                    static_cast<size_t>(count - 1), chunks, first, cmp};
+                op.dispatch_apply(chunks);
+                return op.m_result;
+            } catch( const internal::parallelism_exception & ) {
+                trace.fallback();
+            }
+        }
+    }
+    return std::is_sorted(first, last, cmp);
+}
+
+template <class FwdIt>
+bool is_sorted(FwdIt first, FwdIt last)
+{
+    return ::pstld::is_sorted(first, last, std::less<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// is_sorted_until
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class Cmp>
+struct IsSortedUntil : Dispatchable<IsSortedUntil<It, Cmp>> {
+    Partition<It> m_partition;
+    Cmp m_cmp;
+    MinIteratorResult<It> m_result;
+
+    IsSortedUntil(size_t count, size_t chunks, It first, It last, Cmp cmp)
+        : m_partition(first, count, chunks), m_cmp(cmp), m_result(last)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        if( ind < m_result.min_chunk ) {
+            auto p = m_partition.at(ind);
+            for( auto it1 = p.first, it2 = p.first; it1 != p.last; it1 = it2 ) {
+                ++it2;
+                if( m_cmp(*it2, *it1) ) {
+                    m_result.put(ind, it2);
+                    return;
+                }
+            }
+        }
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt, class Cmp>
+FwdIt is_sorted_until(FwdIt first, FwdIt last, Cmp cmp)
+{
+    const auto count = std::distance(first, last);
+    internal::TraceCall trace(algorithm::is_sorted_until, count, 0);
+    if( count > 2 ) {
+        const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_compare>(count - 1);
+        trace.planned(chunks);
+        if( chunks > 1 ) {
+            try {
+                internal::IsSortedUntil<FwdIt, Cmp> op{
+                    static_cast<size_t>(count - 1), chunks, first, last, cmp};
+                op.dispatch_apply(chunks);
+                return op.m_result.min;
+            } catch( const internal::parallelism_exception & ) {
+                trace.fallback();
+            }
+        }
+    }
+    return std::is_sorted_until(first, last, cmp);
+}
+
+template <class FwdIt>
+FwdIt is_sorted_until(FwdIt first, FwdIt last)
+{
+    return ::pstld::is_sorted_until(first, last, std::less<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// is_partitioned
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class Pred>
+struct IsPartitioned : Dispatchable<IsPartitioned<It, Pred>> {
+    enum Scan
+    {
+        broken,
+        all_true,
+        all_false,
+        true_false
+    };
+
+    Partition<It> m_partition;
+    Pred m_pred;
+    std::atomic<size_t> m_right_true{0};
+    std::atomic<size_t> m_left_false{std::numeric_limits<size_t>::max() - 1};
+
+    IsPartitioned(size_t count, size_t chunks, It first, Pred pred)
+        : m_partition(first, count, chunks), m_pred(pred)
+    {
+    }
+
+    Scan scan(It first, It last) noexcept
+    {
+        if( m_pred(*first) ) {
+            while( true ) {
+                ++first;
+                if( first == last )
+                    return all_true;
+                if( !m_pred(*first) )
+                    break;
+            }
+            while( true ) {
+                ++first;
+                if( first == last )
+                    return true_false;
+                if( m_pred(*first) )
+                    return broken;
+            }
+        }
+        else {
+            while( true ) {
+                ++first;
+                if( first == last )
+                    return all_false;
+                if( m_pred(*first) )
+                    return broken;
+            }
+        }
+    }
+
+    void run(size_t ind) noexcept
+    {
+        if( m_right_true.load() <= m_left_false.load() ) {
+            auto p = m_partition.at(ind);
+            auto s = scan(p.first, p.last);
+            if( s == all_true ) {
+                size_t was = m_right_true.load();
+                while( was < ind ) {
+                    if( m_right_true.compare_exchange_strong(was, ind) )
+                        break;
+                }
+            }
+            else if( s == all_false ) {
+                size_t was = m_left_false.load();
+                while( was > ind ) {
+                    if( m_left_false.compare_exchange_strong(was, ind) )
+                        break;
+                }
+            }
+            else if( s == true_false ) {
+                size_t was = m_right_true.load();
+                while( was < ind ) {
+                    if( m_right_true.compare_exchange_strong(was, ind) )
+                        break;
+                }
+                was = m_left_false.load();
+                while( was > ind ) {
+                    if( m_left_false.compare_exchange_strong(was, ind) )
+                        break;
+                }
+            }
+            else {
+                m_right_true.store(std::numeric_limits<size_t>::max());
+            }
+        }
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt, class Pred>
+bool is_partitioned(FwdIt first, FwdIt last, Pred pred)
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_1(count);
+    internal::TraceCall trace(algorithm::is_partitioned, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::IsPartitioned<FwdIt, Pred> op{
+                static_cast<size_t>(count), chunks, first, pred};
+            op.dispatch_apply(chunks);
+            return op.m_right_true.load() <= op.m_left_false.load();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::is_partitioned(first, last, pred);
+}
+
+//--------------------------------------------------------------------------------------------------
+// min_element
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class Cmp>
+struct MinElement : Dispatchable<MinElement<It, Cmp>> {
+    Partition<It> m_partition;
+    unitialized_array<It> m_results;
+    Cmp m_cmp;
+
+    MinElement(size_t count, size_t chunks, It first, Cmp cmp)
+        : m_partition(first, count, chunks), m_results(chunks), m_cmp(cmp)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p = m_partition.at(ind);
+        m_results.put(ind, std::min_element(p.first, p.last, m_cmp));
+    }
+
+    void skip(size_t ind) noexcept { m_results.put(ind, m_partition.at(ind).first); }
+};
+
+template <class It, class Cmp>
+iterator_value_t<It> min_iter_element(It first, It last, Cmp cmp)
+{
+    auto smallest = *first;
+    ++first;
+    for( ; first != last; ++first ) {
+        if( cmp(*(*first), *smallest) ) {
+            smallest = *first;
+        }
+    }
+    return smallest;
+}
+
+} // namespace internal
+
+template <class FwdIt, class Cmp>
+FwdIt min_element(FwdIt first, FwdIt last, Cmp cmp)
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_2<internal::cost_compare>(count);
+    internal::TraceCall trace(algorithm::min_element, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::MinElement<FwdIt, Cmp> op{static_cast<size_t>(count), chunks, first, cmp};
+            op.dispatch_apply(chunks);
+            return internal::min_iter_element(op.m_results.begin(), op.m_results.end(), cmp);
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::min_element(first, last, cmp);
+}
+
+template <class FwdIt>
+FwdIt min_element(FwdIt first, FwdIt last)
+{
+    return ::pstld::min_element(first, last, std::less<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// max_element
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class Cmp>
+struct MaxElement : Dispatchable<MaxElement<It, Cmp>> {
+    Partition<It> m_partition;
+    unitialized_array<It> m_results;
+    Cmp m_cmp;
+
+    MaxElement(size_t count, size_t chunks, It first, Cmp cmp)
+        : m_partition(first, count, chunks), m_results(chunks), m_cmp(cmp)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p = m_partition.at(ind);
+        m_results.put(ind, std::max_element(p.first, p.last, m_cmp));
+    }
+
+    void skip(size_t ind) noexcept { m_results.put(ind, m_partition.at(ind).first); }
+};
+
+template <class It, class Cmp>
+iterator_value_t<It> max_iter_element(It first, It last, Cmp cmp)
+{
+    auto biggest = *first;
+    ++first;
+    for( ; first != last; ++first ) {
+        if( cmp(*biggest, *(*first)) ) {
+            biggest = *first;
+        }
+    }
+    return biggest;
+}
+
+} // namespace internal
+
+template <class FwdIt, class Cmp>
+FwdIt max_element(FwdIt first, FwdIt last, Cmp cmp)
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_2<internal::cost_compare>(count);
+    internal::TraceCall trace(algorithm::max_element, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::MaxElement<FwdIt, Cmp> op{static_cast<size_t>(count), chunks, first, cmp};
+            op.dispatch_apply(chunks);
+            return internal::max_iter_element(op.m_results.begin(), op.m_results.end(), cmp);
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::max_element(first, last, cmp);
+}
+
+template <class FwdIt>
+FwdIt max_element(FwdIt first, FwdIt last)
+{
+    return ::pstld::max_element(first, last, std::less<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// minmax_element
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class Cmp>
+struct MinMaxElement : Dispatchable<MinMaxElement<It, Cmp>> {
+    Partition<It> m_partition;
+    unitialized_array<std::pair<It, It>> m_results;
+    Cmp m_cmp;
+
+    MinMaxElement(size_t count, size_t chunks, It first, Cmp cmp)
+        : m_partition(first, count, chunks), m_results(chunks), m_cmp(cmp)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p = m_partition.at(ind);
+        m_results.put(ind, std::minmax_element(p.first, p.last, m_cmp));
+    }
+
+    void skip(size_t ind) noexcept
+    {
+        auto first = m_partition.at(ind).first;
+        m_results.put(ind, first, first);
+    }
+};
+
+template <class It, class Cmp>
+iterator_value_t<It> minmax_iter_element(It first, It last, Cmp cmp)
+{
+    auto smallest = (*first).first;
+    auto biggest = (*first).second;
+    ++first;
+    for( ; first != last; ++first ) {
+        if( cmp(*((*first).first), *smallest) )
+            smallest = (*first).first;
+        if( !cmp(*((*first).second), *biggest) )
+            biggest = (*first).second;
+    }
+    return {smallest, biggest};
+}
+
+} // namespace internal
+
+template <class FwdIt, class Cmp>
+std::pair<FwdIt, FwdIt> minmax_element(FwdIt first, FwdIt last, Cmp cmp)
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_2<internal::cost_compare>(count);
+    internal::TraceCall trace(algorithm::minmax_element, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::MinMaxElement<FwdIt, Cmp> op{static_cast<size_t>(count), chunks, first, cmp};
+            op.dispatch_apply(chunks);
+            return internal::minmax_iter_element(op.m_results.begin(), op.m_results.end(), cmp);
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::minmax_element(first, last, cmp);
+}
+
+template <class FwdIt>
+std::pair<FwdIt, FwdIt> minmax_element(FwdIt first, FwdIt last)
+{
+    return ::pstld::minmax_element(first, last, std::less<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// transform
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It1, class It2, class UnOp>
+struct Transform2 : Dispatchable<Transform2<It1, It2, UnOp>> {
+    Partition<It1> m_partition1;
+    Partition<It2> m_partition2;
+    UnOp m_op;
+
+    Transform2(size_t count, size_t chunks, It1 first1, It2 first2, UnOp op)
+        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks), m_op(op)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p = m_partition1.at(ind);
+        std::transform(p.first, p.last, m_partition2.at(ind).first, m_op);
+    }
+};
+
+template <class It1, class It2, class It3, class BinOp>
+struct Transform3 : Dispatchable<Transform3<It1, It2, It3, BinOp>> {
+    Partition<It1> m_partition1;
+    Partition<It2> m_partition2;
+    Partition<It3> m_partition3;
+    BinOp m_op;
+
+    Transform3(size_t count, size_t chunks, It1 first1, It2 first2, It3 first3, BinOp op)
+        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks),
+          m_partition3(first3, count, chunks), m_op(op)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p = m_partition1.at(ind);
+        std::transform(
+            p.first, p.last, m_partition2.at(ind).first, m_partition3.at(ind).first, m_op);
+    }
+};
+
+} // namespace internal
+template <class FwdIt1, class FwdIt2, class UnOp>
+FwdIt2 transform(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, UnOp transform_op) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    const auto chunks = internal::work_chunks_min_fraction_1(count);
+    internal::TraceCall trace(algorithm::transform, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Transform2<FwdIt1, FwdIt2, UnOp> op{
+                static_cast<size_t>(count), chunks, first1, first2, transform_op};
+            op.dispatch_apply(chunks);
+            return op.m_partition2.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::transform(first1, last1, first2, transform_op);
+}
+
+template <class FwdIt1, class FwdIt2, class FwdIt3, class BinOp>
+FwdIt3
+transform(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt3 first3, BinOp transform_op) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    const auto chunks = internal::work_chunks_min_fraction_1(count);
+    internal::TraceCall trace(algorithm::transform, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Transform3<FwdIt1, FwdIt2, FwdIt3, BinOp> op{
+                static_cast<size_t>(count), chunks, first1, first2, first3, transform_op};
+            op.dispatch_apply(chunks);
+            return op.m_partition3.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::transform(first1, last1, first2, first3, transform_op);
+}
+
+//--------------------------------------------------------------------------------------------------
+// equal
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It1, class It2, class Cmp>
+struct Equal : Dispatchable<Equal<It1, It2, Cmp>> {
+    Partition<It1> m_partition1;
+    Partition<It2> m_partition2;
+    Cmp m_cmp;
+    std::atomic_bool m_done{false};
+    bool m_result = true;
+
+    Equal(size_t count, size_t chunks, It1 first1, It2 first2, Cmp cmp)
+        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks), m_cmp(cmp)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        if( m_done )
+            return;
+        auto p1 = m_partition1.at(ind);
+        auto p2 = m_partition2.at(ind);
+        if( !std::equal(p1.first, p1.last, p2.first, m_cmp) ) {
+            m_done = true;
+            m_result = false;
+        }
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt1, class FwdIt2, class Cmp>
+bool equal(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, Cmp cmp) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_compare>(count);
+    internal::TraceCall trace(algorithm::equal, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Equal<FwdIt1, FwdIt2, Cmp> op{
+                static_cast<size_t>(count), chunks, first1, first2, cmp};
+            op.dispatch_apply(chunks);
+            return op.m_result;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::equal(first1, last1, first2, cmp);
+}
+
+template <class FwdIt1, class FwdIt2>
+bool equal(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+{
+    return ::pstld::equal(first1, last1, first2, std::equal_to<>{});
+}
+
+template <class FwdIt1, class FwdIt2, class Cmp>
+bool equal(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2, Cmp cmp) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    internal::TraceCall trace(algorithm::equal, count, 0);
+    if( count != std::distance(first2, last2) )
+        return false;
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_compare>(count);
+    trace.planned(chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Equal<FwdIt1, FwdIt2, Cmp> op{
+                static_cast<size_t>(count), chunks, first1, first2, cmp};
+            op.dispatch_apply(chunks);
+            return op.m_result;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::equal(first1, last1, first2, cmp);
+}
+
+template <class FwdIt1, class FwdIt2>
+bool equal(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2) noexcept
+{
+    return ::pstld::equal(first1, last1, first2, last2, std::equal_to<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// mismatch
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It1, class It2, class Cmp>
+struct Mismatch : Dispatchable<Mismatch<It1, It2, Cmp>> {
+    Partition<It1> m_partition1;
+    Partition<It2> m_partition2;
+    Cmp m_cmp;
+    MinIteratorResult<It1> m_result1;
+    MinIteratorResult<It2> m_result2;
+
+    Mismatch(size_t count, size_t chunks, It1 first1, It2 first2, Cmp cmp)
+        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks), m_cmp(cmp),
+          m_result1(m_partition1.end()), m_result2(m_partition2.end())
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        if( ind < m_result1.min_chunk ) {
+            auto p1 = m_partition1.at(ind);
+            auto p2 = m_partition2.at(ind);
+            for( ; p1.first != p1.last; ++p1.first, ++p2.first )
+                if( !m_cmp(*p1.first, *p2.first) ) {
+                    m_result1.put(ind, p1.first);
+                    m_result2.put(ind, p2.first);
+                    return;
+                }
+        }
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt1, class FwdIt2, class Cmp>
+std::pair<FwdIt1, FwdIt2> mismatch(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, Cmp cmp) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_compare>(count);
+    internal::TraceCall trace(algorithm::mismatch, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Mismatch<FwdIt1, FwdIt2, Cmp> op{
+                static_cast<size_t>(count), chunks, first1, first2, cmp};
+            op.dispatch_apply(chunks);
+            return {op.m_result1.min, op.m_result2.min};
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::mismatch(first1, last1, first2, cmp);
+}
+
+template <class FwdIt1, class FwdIt2>
+std::pair<FwdIt1, FwdIt2> mismatch(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+{
+    return ::pstld::mismatch(first1, last1, first2, std::equal_to<>{});
+}
+
+template <class FwdIt1, class FwdIt2, class Cmp>
+std::pair<FwdIt1, FwdIt2>
+mismatch(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2, Cmp cmp) noexcept
+{
+    const auto count = std::min(std::distance(first1, last1), std::distance(first2, last2));
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_compare>(count);
+    internal::TraceCall trace(algorithm::mismatch, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Mismatch<FwdIt1, FwdIt2, Cmp> op{
+                static_cast<size_t>(count), chunks, first1, first2, cmp};
+            op.dispatch_apply(chunks);
+            return {op.m_result1.min, op.m_result2.min};
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::mismatch(first1, last1, first2, last2, cmp);
+}
+
+template <class FwdIt1, class FwdIt2>
+std::pair<FwdIt1, FwdIt2>
+mismatch(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2) noexcept
+{
+    return ::pstld::mismatch(first1, last1, first2, last2, std::equal_to<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// sort
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class Pred>
+void insertion_sort(It first, It last, Pred pred)
+{
+    if( first == last )
+        return;
+    auto it = first;
+    ++it;
+    for( ; it != last; ++it ) {
+        auto hole = it;
+        iterator_value_t<It> v = std::move(*hole);
+        if( pred(v, *first) ) {
+            while( true ) {
+                *hole = std::move(*(hole - 1));
+                --hole;
+                if( hole == first )
+                    break;
+            }
+            *first = std::move(v);
+        }
+        else {
+            auto prev = std::prev(it);
+            while( true ) {
+                if( !pred(v, *prev) )
+                    break;
+                *hole = std::move(*prev);
+                hole = prev;
+                --prev;
+            }
+            *hole = std::move(v);
+        }
+    }
+}
+
+template <class It, class Pred>
+void median_3(It it1, It it2, It it3, Pred pred)
+{
+    // orders elements at i1, it2, i3 by pred
+    if( pred(*it2, *it1) )
+        std::iter_swap(it1, it2);
+    if( pred(*it3, *it2) ) {
+        std::iter_swap(it2, it3);
+        if( pred(*it2, *it1) )
+            std::iter_swap(it1, it2);
+    }
+}
+
+template <class It, class Pred>
+void guess_median(It it1, It mid, It it2, Pred pred)
+{
+    const auto size = it2 - it1;
+    if( size > 40 ) {
+        const auto _1_8 = size / 8;
+        const auto _1_4 = size / 4;
+        median_3(it1, it1 + _1_8, it1 + _1_4, pred);
+        median_3(mid - _1_8, mid, mid + _1_8, pred);
+        median_3(it2 - _1_4, it2 - _1_8, it2, pred);
+        median_3(it1 + _1_8, mid, it2 - _1_8, pred);
+    }
+    else {
+        median_3(it1, mid, it2, pred);
+    }
+}
+
+template <class It, class Pred>
+std::pair<It, It> partition(It first, It last, Pred pred)
+{
+    auto mid = first + (last - first) / 2;
+    guess_median(first, mid, std::prev(last), pred);
+
+    auto pfirst = mid;
+    auto plast = std::next(mid);
+
+    while( first < pfirst && !pred(*(pfirst - 1), *pfirst) && !pred(*pfirst, *(pfirst - 1)) )
+        --pfirst;
+
+    while( plast < last && !pred(*plast, *pfirst) && !pred(*pfirst, *plast) )
+        ++plast;
+
+    auto gtfirst = plast;
+    auto lslast = pfirst;
+
+    while( true ) {
+        for( ; gtfirst < last; ++gtfirst ) {
+            if( pred(*pfirst, *gtfirst) )
+                continue;
+            if( pred(*gtfirst, *pfirst) )
+                break;
+            if( plast != gtfirst )
+                std::iter_swap(plast, gtfirst);
+            ++plast;
+        }
+        for( ; first < lslast; --lslast ) {
+            if( pred(*(lslast - 1), *pfirst) )
+                continue;
+            if( pred(*pfirst, *(lslast - 1)) )
+                break;
+            if( --pfirst != lslast - 1 )
+                std::iter_swap(pfirst, lslast - 1);
+        }
+        if( lslast == first && gtfirst == last )
+            return {pfirst, plast};
+        if( lslast == first ) {
+            if( plast != gtfirst )
+                std::iter_swap(pfirst, plast);
+            ++plast;
+            std::iter_swap(pfirst, gtfirst);
+            ++pfirst;
+            ++gtfirst;
+        }
+        else if( gtfirst == last ) {
+            if( --lslast != --pfirst )
+                std::iter_swap(lslast, pfirst);
+            std::iter_swap(pfirst, --plast);
+        }
+        else {
+            std::iter_swap(gtfirst, --lslast);
+            ++gtfirst;
+        }
+    }
+}
+
+inline constexpr size_t log2(size_t n) noexcept
+{
+    size_t log2n = 0;
+    while( n > 1 ) {
+        log2n++;
+        n >>= 1;
+    }
+    return log2n;
+}
+
+template <class It, class Cmp>
+struct Sort {
+    struct Work {
+        size_t first;
+        size_t last;
+        size_t depth;
+    };
+
+    It m_first;
+    It m_last;
+    size_t m_size;
+    Cmp m_cmp;
+    DispatchGroup m_dg;
+    WorkStealingTeam<Work> m_team;
+    parallelism_vector<WorkCounter> m_work_counters{m_team.workers()};
+    size_t m_grain{std::max(tuned_grain(), insertion_sort_limit)}; // not forked below this
+    const std::atomic<bool> *m_stop = current_stop_flag();
+#if defined(PSTLD_TRACING)
+    TracedCall *m_trace = current_trace_call();
+#endif
+
+    Sort(It first, It last, Cmp cmp, size_t workers)
+        : m_first(first), m_last(last), m_size(last - first), m_cmp(cmp), m_team(workers)
+    {
+    }
+
+    void start() noexcept
+    {
+        mark_parallel();
+#if defined(PSTLD_TRACING)
+        trace_workers(m_trace, m_team.workers());
+#endif
+        m_team.fork(0, Work{0, m_size, 2 * log2(m_size)}); // can't fail, the deque is empty
+        for( size_t i = 1; i != m_team.workers(); ++i )
+            m_dg.dispatch(static_cast<void *>(this), dispatch);
+        dispatch_worker(0);
+        m_dg.wait();
+    }
+
+    void dispatch_worker(size_t worker_index) noexcept
+    {
+        NestedScope nested;
+        m_team.work(
+            worker_index,
+            [&](const Work &w) { do_sort(w, worker_index); },
+            [&] {
+                // the work dropped after a stop request never gets committed
+                if( !is_done() && !stop_requested(m_stop) )
+                    return false;
+                m_team.finish();
+                return true;
+            });
+    }
+
+    void do_sort(const Work w, size_t worker_index) noexcept
+    {
+#if defined(PSTLD_TRACING)
+        TraceChunk chunk{m_trace, w.first};
+#endif
+        auto first = m_first + w.first;
+        auto last = m_first + w.last;
+        auto depth = w.depth;
+        while( first != last && !stop_requested(m_stop) ) {
+            const auto len = last - first;
+            if( static_cast<size_t>(len) <= insertion_sort_limit ) {
+                // small len - do an insertion sort
+                insertion_sort(first, last, m_cmp);
+                m_work_counters[worker_index].commit_relaxed(len);
+                break;
+            }
+            else if( static_cast<size_t>(len) <= m_grain ) {
+                // below the grain - not worth splitting any further
+                std::sort(first, last, m_cmp);
+                m_work_counters[worker_index].commit_relaxed(len);
+                break;
+            }
+            else if( depth == 0 ) {
+                std::make_heap(first, last, m_cmp);
+                std::sort_heap(first, last, m_cmp);
+                m_work_counters[worker_index].commit_relaxed(len);
+                break;
+            }
+            else {
+                // regular len - do a quicksort
+                --depth;
+                auto p = internal::partition(first, last, m_cmp);
+                const auto left_len = p.second - first;
+                const auto mid_len = p.second - p.first;
+                const auto right_len = last - p.second;
+                m_work_counters[worker_index].commit_relaxed(mid_len);
+                if( right_len != 0 ) {
+                    if( left_len != 0 ) {
+                        // fork the right unsorted side
+                        fork(worker_index,
+                             static_cast<size_t>(std::distance(m_first, p.second)),
+                             static_cast<size_t>(std::distance(m_first, last)),
+                             depth);
+
+                        // process locally the left unsorted side
+                        last = p.first;
+                    }
+                    else {
+                        // nothing to do on the left - process the right side locally
+                        first = p.second;
+                    }
+                }
+                else {
+                    // nothing to do on the right - process the left side locally
+                    last = p.first;
+                }
+            }
+        }
+    }
+
+    void fork(size_t worker_index, size_t first, size_t last, size_t depth) noexcept
+    {
+        if( !m_team.fork(worker_index, Work{first, last, depth}) ) {
+            ::std::sort(m_first + first, m_first + last, m_cmp);
+            m_work_counters[worker_index].commit_relaxed(last - first);
+        }
+    }
+
+    bool is_done() noexcept
+    {
+        // orders this worker's own commits before reading the others', so that out of the
+        // workers which committed last at least one is guaranteed to observe the completion
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        size_t done = 0;
+        for( auto &counter : m_work_counters )
+            done += counter.load_relaxed();
+        return done == m_size;
+    }
+
+    static void dispatch(void *ctx) noexcept
+    {
+        auto me = static_cast<Sort *>(ctx);
+        me->dispatch_worker(me->m_team.next_worker_index());
+    }
+};
+
+} // namespace internal
+
+template <class RanIt, class Cmp>
+void sort(RanIt first, RanIt last, Cmp cmp) noexcept
+{
+    const auto count = std::distance(first, last);
+    internal::TraceCall trace(algorithm::sort, count, 0);
+    if( static_cast<size_t>(count) > internal::insertion_sort_limit &&
+        internal::worth_parallel(count, internal::cost_sort_level * internal::log2(count)) ) {
+        // runs inline if no helpers are available at the moment
+        internal::Admission admission{internal::max_workers() - 1};
+        if( admission.granted() != 0 ) {
+            try {
+                internal::Sort<RanIt, Cmp> sort(first, last, cmp, admission.granted() + 1);
+                sort.start();
+                return;
+            } catch( const internal::parallelism_exception & ) {
+                trace.fallback();
+            }
+        }
+    }
+    std::sort(first, last, cmp);
+}
+
+template <class RanIt>
+void sort(RanIt first, RanIt last) noexcept
+{
+    return ::pstld::sort(first, last, std::less<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// stable_sort
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+inline size_t stable_sort_tree_height(size_t elems) noexcept
+{
+    size_t chunks_elems = elems / std::max(insertion_sort_limit, tuned_grain());
+    size_t log2_elems = log2(chunks_elems);
+
+    size_t chunks_oversubscr = max_workers() * tuned_chunks_per_cpu();
+    size_t log2_oversubscr = log2(chunks_oversubscr);
+
+    return std::min(log2_elems, log2_oversubscr) & ~size_t(1);
+}
+
+template <class It1, class It2, class Cmp>
+void merge_mid_move(It1 first, It1 mid, It1 last, It2 out, Cmp cmp)
+{
+    // TODO: should it move-construct in-place instead of moving into?
+    auto first1 = first;
+    auto first2 = mid;
+    for( ; first1 != mid; ++out ) {
+        if( first2 == last ) {
+            std::move(first1, mid, out);
+            return;
+        }
+        if( cmp(*first2, *first1) ) {
+            *out = std::move(*first2);
+            ++first2;
+        }
+        else {
+            *out = std::move(*first1);
+            ++first1;
+        }
+    }
+    std::move(first2, last, out);
+}
+
+template <class It, class Cmp>
+void insertion_sort_buf_assign_move(It first, It last, Cmp cmp, iterator_value_t<It> *buf)
+{
+    if( first == last )
+        return;
+
+    auto last2 = buf;
+    *(last2++) = std::move(*first);
+
+    for( ; ++first != last; ++last2 ) {
+        auto j2 = last2;
+        auto i2 = j2;
+        if( cmp(*first, *--i2) ) {
+            *j2 = std::move(*i2);
+            for( --j2; i2 != buf && cmp(*first, *--i2); --j2 )
+                *j2 = std::move(*i2);
+            *j2 = std::move(*first);
+        }
+        else {
+            *j2 = std::move(*first);
+        }
+    }
+}
+
+template <class It, class Cmp>
+void stable_sort(It first, It last, Cmp cmp, iterator_value_t<It> *buf);
+
+template <class It, class Cmp>
+void stable_sort_buf_assign_move(It first, It last, Cmp cmp, iterator_value_t<It> *buf)
+{
+    size_t len = last - first;
+    if( len == 0 ) {
+    }
+    else if( len == 1 ) {
+        *buf = std::move(*first);
+    }
+    else if( len == 2 ) {
+        auto second = first;
+        ++second;
+        if( cmp(*second, *first) ) {
+            *(buf++) = std::move(*second);
+            *buf = std::move(*first);
+        }
+        else {
+            *(buf++) = std::move(*first);
+            *buf = std::move(*second);
+        }
+    }
+    else if( len <= insertion_sort_limit ) {
+        insertion_sort_buf_assign_move(first, last, cmp, buf);
+    }
+    else {
+        size_t half = len / 2;
+        It mid = first + half;
+        stable_sort(first, mid, cmp, buf);
+        stable_sort(mid, last, cmp, buf + half);
+        merge_mid_move(first, mid, last, buf, cmp);
+    }
+}
+
+template <class It, class Cmp>
+void stable_sort(It first, It last, Cmp cmp, iterator_value_t<It> *buf)
+{
+    size_t len = last - first;
+    if( len <= insertion_sort_limit ) {
+        insertion_sort(first, last, cmp);
+    }
+    else {
+        size_t half = len / 2;
+        It mid = first + half;
+        stable_sort_buf_assign_move(first, mid, cmp, buf);
+        stable_sort_buf_assign_move(mid, last, cmp, buf + half);
+        merge_mid_move(buf, buf + half, buf + len, first, cmp);
+    }
+}
+
+template <class It, class Cmp>
+struct StableSort {
+    struct Work {
+        size_t first;
+        size_t last;
+        size_t depth;
+    };
+
+    It m_first;
+    It m_last;
+    Cmp m_cmp;
+    size_t m_size;
+    size_t m_height;
+    size_t m_chunks;
+    size_t m_workers;
+    std::atomic<size_t> m_next_chunk{0};
+    const std::atomic<bool> *m_stop = current_stop_flag();
+#if defined(PSTLD_TRACING)
+    TracedCall *m_trace = current_trace_call();
+#endif
+
+    Partition<It> m_partition;
+    parallelism_vector<iterator_value_t<It>> m_own_buf; // TODO: should be raw temp memory instead?
+    iterator_value_t<It> *m_buf;                        // either m_own_buf or the caller's scratch
+    parallelism_vector<std::atomic<bool>> m_flags;
+
+    DispatchGroup m_dg;
+
+    StableSort(It first,
+               It last,
+               Cmp cmp,
+               scratch_span<iterator_value_t<It>> scratch,
+               size_t workers)
+        : m_first(first), m_last(last), m_cmp(cmp), m_size(last - first),
+          m_height(stable_sort_tree_height(m_size)), m_chunks(size_t(1) << m_height),
+          m_workers(workers), m_partition(first, m_size, m_chunks),
+          m_own_buf(scratch.size < m_size ? m_size : 0),
+          m_buf(scratch.size < m_size ? m_own_buf.data() : scratch.data),
+          m_flags(size_t(1) << m_height)
+    {
+    }
+
+    void start() noexcept
+    {
+        mark_parallel();
+#if defined(PSTLD_TRACING)
+        trace_workers(m_trace, m_workers);
+        if( m_trace != nullptr )
+            m_trace->call.chunks = m_chunks;
+#endif
+        for( size_t i = 1; i != m_workers; ++i )
+            m_dg.dispatch(static_cast<void *>(this), dispatch);
+        dispatch_worker();
+        m_dg.wait();
+    }
+
+    static void dispatch(void *ctx) noexcept
+    {
+        auto me = static_cast<StableSort *>(ctx);
+        me->dispatch_worker();
+    }
+
+    void dispatch_worker() noexcept
+    {
+        NestedScope nested;
+        while( true ) {
+            size_t chunk = m_next_chunk.fetch_add(1);
+            if( chunk >= m_chunks )
+                break;
+            bottomup(chunk);
+        }
+    }
+
+    void bottomup(size_t ind) noexcept
+    {
+#if defined(PSTLD_TRACING)
+        TraceChunk chunk{m_trace, ind};
+#endif
+        auto p = m_partition.at(ind);
+
+        // the merges can't be skipped, the elements may be parked in the buffer midway
+        if( !stop_requested(m_stop) )
+            stable_sort(p.first, p.last, m_cmp, m_buf + std::distance(m_first, p.first));
+        std::atomic<bool> *flag_ptr = m_flags.data();
+        if( !flag_ptr[ind / 2].exchange(true) ) // try to give up merging
+            return;
+
+        auto buf = m_buf;
+        for( size_t lvl = 1, chunks = m_chunks / 2;; ++lvl, chunks >>= 1 ) {
+            bool odd = ind & 1;
+            ind >>= 1;
+
+            auto first = odd ? m_partition.at(ind << lvl).first : p.first;
+            auto mid = odd ? p.first : p.last;
+            auto last = odd ? p.last : m_partition.at(((ind + 1) << lvl) - 1).last;
+
+#if defined(PSTLD_TRACING)
+            trace_record('B', "merge level", "level", lvl);
+#endif
+            if( lvl % 2 ) {
+                // merge into tmp buf
+                merge_mid_move(first, mid, last, buf + (first - m_first), m_cmp);
+            }
+            else {
+                // merge back into orig buffer
+                merge_mid_move(buf + (first - m_first),
+                               buf + (mid - m_first),
+                               buf + (last - m_first),
+                               first,
+                               m_cmp);
+            }
+#if defined(PSTLD_TRACING)
+            trace_record('E', "merge level", "level", lvl);
+#endif
+
+            flag_ptr += chunks;
+            if( !flag_ptr[ind / 2].exchange(true) ) // try to give up merging
+                return;
+
+            p.first = first;
+            p.last = last;
+        }
+    }
+};
+
+} // namespace internal
+
+// Uses the caller's scratch array as the temporary storage if it holds at least last - first
+// elements, both in parallel and serially.
+template <class RanIt, class Cmp>
+void stable_sort(RanIt first,
+                 RanIt last,
+                 Cmp cmp,
+                 scratch_span<typename std::iterator_traits<RanIt>::value_type> scratch) noexcept
+{
+    const auto count = std::distance(first, last);
+    internal::TraceCall trace(algorithm::stable_sort, count, 0);
+    if( static_cast<size_t>(count) > internal::insertion_sort_limit * 4 &&
+        internal::worth_parallel(count, internal::cost_sort_level * internal::log2(count)) ) {
+        // runs inline if no helpers are available at the moment
+        internal::Admission admission{internal::max_workers() - 1};
+        if( admission.granted() != 0 ) {
+            try {
+                internal::StableSort<RanIt, Cmp> op(
+                    first, last, cmp, scratch, admission.granted() + 1);
+                op.start();
+                return;
+            } catch( const internal::parallelism_exception & ) {
+                trace.fallback();
+            }
+        }
+    }
+    if( scratch.size >= static_cast<size_t>(count) )
+        internal::stable_sort(first, last, cmp, scratch.data);
+    else
+        std::stable_sort(first, last, cmp);
+}
+
+template <class RanIt, class Cmp>
+void stable_sort(RanIt first, RanIt last, Cmp cmp) noexcept
+{
+    ::pstld::stable_sort(
+        first, last, cmp, scratch_span<typename std::iterator_traits<RanIt>::value_type>{});
+}
+
+template <class RanIt>
+void stable_sort(RanIt first, RanIt last) noexcept
+{
+    return ::pstld::stable_sort(first, last, std::less<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// merge
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It1, class It2, class It3, class Cmp>
+struct Merge {
+    struct Work {
+        size_t first1;
+        size_t last1;
+        size_t first2;
+        size_t last2;
+        size_t first3;
+    };
+
+    It1 m_first1;
+    It1 m_last1;
+    size_t m_size1;
+    It2 m_first2;
+    It2 m_last2;
+    size_t m_size2;
+    It3 m_first3;
+    It3 m_last3;
+    size_t m_size3; // = m_size1 + m_size2
+    Cmp m_cmp;
+    DispatchGroup m_dg;
+    WorkStealingTeam<Work> m_team;
+    parallelism_vector<WorkCounter> m_work_counters{m_team.workers()};
+    size_t m_grain{std::max(tuned_grain(), merge_parallel_limit)}; // not forked below this
+    const std::atomic<bool> *m_stop = current_stop_flag();
+#if defined(PSTLD_TRACING)
+    TracedCall *m_trace = current_trace_call();
+#endif
+
+    Merge(It1 first1, It1 last1, It2 first2, It2 last2, It3 first3, Cmp cmp, size_t workers)
+        : m_first1(first1), m_last1(last1), m_size1(last1 - first1), m_first2(first2),
+          m_last2(last2), m_size2(last2 - first2), m_first3(first3),
+          m_last3(std::next(first3, m_size1 + m_size2)), m_size3(m_size1 + m_size2), m_cmp(cmp),
+          m_team(workers)
+    {
+    }
+
+    void start() noexcept
+    {
+        mark_parallel();
+#if defined(PSTLD_TRACING)
+        trace_workers(m_trace, m_team.workers());
+#endif
+        m_team.fork(0, Work{0, m_size1, 0, m_size2, 0}); // can't fail, the deque is empty
+        for( size_t i = 1; i != m_team.workers(); ++i )
+            m_dg.dispatch(static_cast<void *>(this), dispatch);
+        dispatch_worker(0);
+        m_dg.wait();
+    }
+
+    void dispatch_worker(size_t worker_index) noexcept
+    {
+        NestedScope nested;
+        m_team.work(
+            worker_index,
+            [&](const Work &w) { do_merge(w, worker_index); },
+            [&] {
+                // the work dropped after a stop request never gets committed
+                if( !is_done() && !stop_requested(m_stop) )
+                    return false;
+                m_team.finish();
+                return true;
+            });
+    }
+
+    void do_merge(const Work w, size_t worker_index) noexcept
+    {
+#if defined(PSTLD_TRACING)
+        TraceChunk chunk{m_trace, w.first3};
+#endif
+        size_t first1 = w.first1;
+        size_t last1 = w.last1;
+        size_t first2 = w.first2;
+        size_t last2 = w.last2;
+        size_t first3 = w.first3;
+
+        if( stop_requested(m_stop) )
+            return;
+
+        while( (last1 - first1) + (last2 - first2) > m_grain ) {
+            // chop the input in roughly halves while it's big enough
+            size_t mid1;
+            size_t mid2;
+            if( last1 - first1 < last2 - first2 ) {
+                mid2 = first2 + (last2 - first2) / 2;
+                mid1 = std::distance(
+                    m_first1,
+                    std::lower_bound(
+                        m_first1 + first1, m_first1 + last1, *(m_first2 + mid2), m_cmp));
+            }
+            else {
+                mid1 = first1 + (last1 - first1) / 2;
+                mid2 = std::distance(
+                    m_first2,
+                    std::lower_bound(
+                        m_first2 + first2, m_first2 + last2, *(m_first1 + mid1), m_cmp));
+            }
+
+            fork(
+                worker_index, mid1, last1, mid2, last2, first3 + (mid1 - first1) + (mid2 - first2));
+            last1 = mid1;
+            last2 = mid2;
+        }
+
+        std::merge(m_first1 + first1,
+                   m_first1 + last1,
+                   m_first2 + first2,
+                   m_first2 + last2,
+                   m_first3 + first3,
+                   m_cmp);
+        m_work_counters[worker_index].commit_relaxed((last1 - first1) + (last2 - first2));
+    }
+
+    void fork(size_t worker_index,
+              size_t first1,
+              size_t last1,
+              size_t first2,
+              size_t last2,
+              size_t first3) noexcept
+    {
+        if( !m_team.fork(worker_index, Work{first1, last1, first2, last2, first3}) ) {
+            std::merge(m_first1 + first1,
+                       m_first1 + last1,
+                       m_first2 + first2,
+                       m_first2 + last2,
+                       m_first3 + first3,
+                       m_cmp);
+            m_work_counters[worker_index].commit_relaxed((last1 - first1) + (last2 - first2));
+        }
+    }
+
+    bool is_done() noexcept
+    {
+        // see Sort::is_done()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        size_t done = 0;
+        for( auto &counter : m_work_counters )
+            done += counter.load_relaxed();
+        return done == m_size3;
+    }
+
+    static void dispatch(void *ctx) noexcept
+    {
+        auto me = static_cast<Merge *>(ctx);
+        me->dispatch_worker(me->m_team.next_worker_index());
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt1, class FwdIt2, class FwdIt3, class Cmp>
+FwdIt3
+merge(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2, FwdIt3 first3, Cmp cmp) noexcept
+{
+    if constexpr( internal::is_random_iterator_v<FwdIt1> &&
+                  internal::is_random_iterator_v<FwdIt2> &&
+                  internal::is_random_iterator_v<FwdIt3> ) {
+        const auto count = std::distance(first1, last1) + std::distance(first2, last2);
+        internal::TraceCall trace(algorithm::merge, count, 0);
+        if( static_cast<size_t>(count) > internal::merge_parallel_limit &&
+            internal::worth_parallel(count, internal::cost_compare) ) {
+            // runs inline if no helpers are available at the moment
+            internal::Admission admission{internal::max_workers() - 1};
+            if( admission.granted() != 0 ) {
+                try {
+                    internal::Merge<FwdIt1, FwdIt2, FwdIt3, Cmp> merge(
+                        first1, last1, first2, last2, first3, cmp, admission.granted() + 1);
+                    merge.start();
+                    return merge.m_last3;
+                } catch( const internal::parallelism_exception & ) {
+                    trace.fallback();
+                }
+            }
+        }
+        return std::merge(first1, last1, first2, last2, first3, cmp);
+    }
+    else
+        return std::merge(first1, last1, first2, last2, first3, cmp);
+}
+
+template <class FwdIt1, class FwdIt2, class FwdIt3>
+FwdIt3 merge(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2, FwdIt3 first3) noexcept
+{
+    return ::pstld::merge(first1, last1, first2, last2, first3, std::less<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// fill, fill_n
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class T>
+struct Fill : Dispatchable<Fill<It, T>> {
+    Partition<It> m_partition;
+    const T &m_val;
+
+    Fill(size_t count, size_t chunks, It first, const T &val)
+        : m_partition(first, count, chunks), m_val(val)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p = m_partition.at(ind);
+        std::fill(p.first, p.last, m_val);
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt, class T>
+void fill(FwdIt first, FwdIt last, const T &val) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    internal::TraceCall trace(algorithm::fill, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Fill<FwdIt, T> op{static_cast<size_t>(count), chunks, first, val};
+            op.dispatch_apply(chunks);
+            return;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::fill(first, last, val);
+}
+
+template <class FwdIt, class Size, class T>
+FwdIt fill_n(FwdIt first, Size count, const T &val) noexcept
+{
+    internal::TraceCall trace(algorithm::fill_n, count < 1 ? 0 : static_cast<size_t>(count), 0);
+    if( count < 1 )
+        return first;
+
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    trace.planned(chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Fill<FwdIt, T> op{static_cast<size_t>(count), chunks, first, val};
+            op.dispatch_apply(chunks);
+            return op.m_partition.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::fill_n(first, count, val);
+}
+
+//--------------------------------------------------------------------------------------------------
+// generate, generate_n
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class Gen>
+struct Generate : Dispatchable<Generate<It, Gen>> {
+    Partition<It> m_partition;
+    Gen &m_gen;
+
+    Generate(size_t count, size_t chunks, It first, Gen &gen)
+        : m_partition(first, count, chunks), m_gen(gen)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        // this technically violates the assumption that the generation will be performed in a
+        // deterministic order, but that in turn essentially makes a parallel version
+        // unimplementable. so instead this implementation calls the generator concurrently without
+        // a specific order.
+        for( auto p = m_partition.at(ind); p.first != p.last; ++p.first )
+            *p.first = m_gen();
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt, class Gen>
+void generate(FwdIt first, FwdIt last, Gen gen) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_1(count);
+    internal::TraceCall trace(algorithm::generate, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Generate<FwdIt, Gen> op{static_cast<size_t>(count), chunks, first, gen};
+            op.dispatch_apply(chunks);
+            return;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::generate(first, last, gen);
+}
+
+template <class FwdIt, class Size, class Gen>
+FwdIt generate_n(FwdIt first, Size count, Gen gen) noexcept
+{
+    internal::TraceCall trace(algorithm::generate_n, count < 1 ? 0 : static_cast<size_t>(count), 0);
+    if( count < 1 )
+        return first;
+
+    const auto chunks = internal::work_chunks_min_fraction_1(count);
+    trace.planned(chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Generate<FwdIt, Gen> op{static_cast<size_t>(count), chunks, first, gen};
+            op.dispatch_apply(chunks);
+            return op.m_partition.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::generate_n(first, count, gen);
+}
+
+//--------------------------------------------------------------------------------------------------
+// copy, copy_n
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It1, class It2>
+struct Copy : Dispatchable<Copy<It1, It2>> {
+    Partition<It1> m_partition1;
+    Partition<It2> m_partition2;
+
+    Copy(size_t count, size_t chunks, It1 first1, It2 first2)
+        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p1 = m_partition1.at(ind);
+        auto p2 = m_partition2.at(ind);
+        std::copy(p1.first, p1.last, p2.first);
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt1, class FwdIt2>
+FwdIt2 copy(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    internal::TraceCall trace(algorithm::copy, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Copy<FwdIt1, FwdIt2> op{static_cast<size_t>(count), chunks, first1, first2};
+            op.dispatch_apply(chunks);
+            return op.m_partition2.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::copy(first1, last1, first2);
+}
+
+template <class FwdIt1, class Size, class FwdIt2>
+FwdIt2 copy_n(FwdIt1 first1, Size count, FwdIt2 first2) noexcept
+{
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    internal::TraceCall trace(algorithm::copy_n, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Copy<FwdIt1, FwdIt2> op{static_cast<size_t>(count), chunks, first1, first2};
+            op.dispatch_apply(chunks);
+            return op.m_partition2.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::copy_n(first1, count, first2);
+}
+
+//--------------------------------------------------------------------------------------------------
+// copy_if
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+// The first pass evaluates the predicate over each chunk, remembers the outcomes in the chunk's
+// own words of a bitmask and counts the matches. The counts are then turned into the positions of
+// the chunks in the output in a single walk over it, and the second pass copies the marked
+// elements of each chunk there.
+template <class It1, class It2, class Pred>
+struct CopyIf : Dispatchable2<CopyIf<It1, It2, Pred>> {
+    using Word = uint64_t;
+    static constexpr size_t word_bits = 64;
+
+    Partition<It1> m_partition;
+    It2 m_first2;
+    Pred m_pred;
+    size_t m_chunk_words;
+    unitialized_array<Word> m_marks;
+    unitialized_array<size_t> m_counts;
+    unitialized_array<It2> m_outputs;
+
+    CopyIf(size_t count, size_t chunks, It1 first1, It2 first2, Pred pred)
+        : m_partition(first1, count, chunks), m_first2(first2), m_pred(pred),
+          m_chunk_words(words(count, chunks)), m_marks(chunks * m_chunk_words), m_counts(chunks),
+          m_outputs(chunks)
+    {
+        for( size_t i = 0; i != chunks; ++i )
+            m_outputs.put(i, first2);
+    }
+
+    static size_t words(size_t count, size_t chunks) noexcept
+    {
+        const size_t chunk_max = count / chunks + (count % chunks != 0);
+        return (chunk_max + word_bits - 1) / word_bits;
+    }
+
+    void run_first(size_t ind) noexcept
+    {
+        auto p = m_partition.at(ind);
+        Word *marks = m_marks.begin() + ind * m_chunk_words;
+        size_t matched = 0;
+        while( p.first != p.last ) {
+            Word word = 0;
+            for( size_t bit = 0; bit != word_bits && p.first != p.last; ++bit, ++p.first )
+                if( m_pred(*p.first) ) {
+                    word |= Word(1) << bit;
+                    ++matched;
+                }
+            *marks++ = word;
+        }
+        m_counts.put(ind, matched);
+    }
+
+    void skip_first(size_t ind) noexcept { m_counts.put(ind, size_t(0)); }
+
+    void run_second(size_t ind) noexcept
+    {
+        auto p = m_partition.at(ind);
+        It2 out = m_outputs[ind];
+        const Word *marks = m_marks.begin() + ind * m_chunk_words;
+        for( auto left = static_cast<size_t>(std::distance(p.first, p.last)); left != 0; ) {
+            const size_t bits = std::min(left, word_bits);
+            const Word word = *marks++;
+            left -= bits;
+            if( word == 0 ) {
+                // nothing to copy from these elements, which is the usual case of rare matches
+                p.first = std::next(p.first, bits);
+                continue;
+            }
+            for( size_t bit = 0; bit != bits; ++bit, ++p.first )
+                if( word & (Word(1) << bit) )
+                    *out++ = *p.first;
+        }
+    }
+
+    // Advances through the output once, stopping at the start of each chunk's matches. Returns the
+    // end of the whole output.
+    It2 accumulate() noexcept
+    {
+        It2 out = m_first2;
+        for( size_t i = 0; i != m_counts.m_size; ++i ) {
+            m_outputs[i] = out;
+            out = std::next(out, m_counts[i]);
+        }
+        return out;
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt1, class FwdIt2, class Pred>
+FwdIt2 copy_if(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, Pred pred) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    const auto chunks = internal::work_chunks_min_fraction_2(count);
+    internal::TraceCall trace(algorithm::copy_if, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::CopyIf<FwdIt1, FwdIt2, Pred> op{
+                static_cast<size_t>(count), chunks, first1, first2, pred};
+            op.dispatch_apply_first(chunks);
+            const FwdIt2 last2 = op.accumulate();
+            op.dispatch_apply_second(chunks);
+            return last2;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::copy_if(first1, last1, first2, pred);
+}
+
+//--------------------------------------------------------------------------------------------------
+// replace, replace_if
+//--------------------------------------------------------------------------------------------------
+
+template <class FwdIt, class T>
+void replace(FwdIt first, FwdIt last, const T &old_val, const T &new_val) noexcept
+{
+    ::pstld::for_each(first, last, [&](auto &val) {
+        if( val == old_val )
+            val = new_val;
+    });
+}
+
+template <class FwdIt, class Pred, class T>
+void replace_if(FwdIt first, FwdIt last, Pred pred, const T &new_val) noexcept
+{
+    ::pstld::for_each(first, last, [&, pred](auto &val) mutable {
+        if( pred(val) )
+            val = new_val;
+    });
+}
+
+//--------------------------------------------------------------------------------------------------
+// swap_ranges
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It1, class It2>
+struct SwapRanges : Dispatchable<SwapRanges<It1, It2>> {
+    Partition<It1> m_partition1;
+    Partition<It2> m_partition2;
+
+    SwapRanges(size_t count, size_t chunks, It1 first1, It2 first2)
+        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p1 = m_partition1.at(ind);
+        auto p2 = m_partition2.at(ind);
+        std::swap_ranges(p1.first, p1.last, p2.first);
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt1, class FwdIt2>
+FwdIt2 swap_ranges(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    internal::TraceCall trace(algorithm::swap_ranges, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::SwapRanges<FwdIt1, FwdIt2> op{
+                static_cast<size_t>(count), chunks, first1, first2};
+            op.dispatch_apply(chunks);
+            return op.m_partition2.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::swap_ranges(first1, last1, first2);
+}
+
+//--------------------------------------------------------------------------------------------------
+// adjacent_difference
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It1, class It2, class BinOp>
+struct AdjacentDifference : Dispatchable<AdjacentDifference<It1, It2, BinOp>> {
+    Partition<It1> m_partition1;
+    Partition<It2> m_partition2;
+    BinOp m_op;
+
+    AdjacentDifference(size_t count, size_t chunks, It1 first1, It2 first2, BinOp op)
+        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks), m_op(op)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p1 = m_partition1.at(ind);
+        auto p2 = m_partition2.at(ind);
+        auto i1 = p1.first;
+        auto i2 = std::next(p1.first);
+        while( true ) {
+            *p2.first = m_op(*i2, *i1);
+            if( i2 == p1.last )
+                break;
+            i1 = i2;
+            ++i2;
+            ++p2.first;
+        }
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt1, class FwdIt2, class BinOp>
+FwdIt2 adjacent_difference(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, BinOp bop) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    internal::TraceCall trace(algorithm::adjacent_difference, count, 0);
+    if( count > 2 ) {
+        *first2 = *first1;
+        const auto chunks = internal::work_chunks_min_fraction_1(count - 1);
+        trace.planned(chunks);
+        if( chunks > 1 ) {
+            try {
+                internal::AdjacentDifference<FwdIt1, FwdIt2, BinOp> op{
+                    static_cast<size_t>(count - 1), chunks, first1, std::next(first2), bop};
+                op.dispatch_apply(chunks);
+                return op.m_partition2.end();
+            } catch( const internal::parallelism_exception & ) {
+                trace.fallback();
+            }
+        }
+    }
+    return ::std::adjacent_difference(first1, last1, first2, bop);
+}
+
+template <class FwdIt1, class FwdIt2>
+FwdIt2 adjacent_difference(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+{
+    return ::pstld::adjacent_difference(first1, last1, first2, std::minus<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// reverse
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It>
+struct Reverse : Dispatchable<Reverse<It>> {
+    Partition<It> m_partition1;
+    Partition<It, false> m_partition2;
+
+    Reverse(size_t count, size_t chunks, It first, It last)
+        : m_partition1(first, count, chunks), m_partition2(std::prev(last), count, chunks)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p1 = m_partition1.at(ind);
+        auto p2 = m_partition2.at(ind);
+        for( ; p1.first != p1.last; ++p1.first, --p2.first )
+            std::iter_swap(p1.first, p2.first);
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt>
+void reverse(FwdIt first, FwdIt last) noexcept
+{
+    const auto count = std::distance(first, last);
+    internal::TraceCall trace(algorithm::reverse, count, 0);
+    if( count > 3 ) {
+        const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count / 2);
+        trace.planned(chunks);
+        if( chunks > 1 ) {
+            try {
+                internal::Reverse<FwdIt> op{static_cast<size_t>(count / 2), chunks, first, last};
+                op.dispatch_apply(chunks);
+                return;
+            } catch( const internal::parallelism_exception & ) {
+                trace.fallback();
+            }
+        }
+    }
+    ::std::reverse(first, last);
+}
+
+//--------------------------------------------------------------------------------------------------
+// inclusive_scan, transform_inclusive_scan
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class BinOp, class UnOp, class R>
+R partial_reduce(It first, It last, BinOp reduce, UnOp transform)
+{
+    auto init = first++;
+    auto val = static_cast<R>(reduce(transform(*init), transform(*first++)));
+    for( ; first != last; ++first )
+        val = reduce(std::move(val), transform(*first));
+    return val;
+}
+
+template <class It1, class It2, class BinOp, class UnOp, class T>
+struct InclusiveScan : Dispatchable2<InclusiveScan<It1, It2, BinOp, UnOp, T>> {
+    Partition<It1> m_partition1;
+    Partition<It2> m_partition2;
+    unitialized_array<T> m_reduced;
+    BinOp m_op;
+    UnOp m_tr;
+    T &m_init;
+
+    InclusiveScan(size_t count, size_t chunks, It1 first1, It2 first2, BinOp op, UnOp tr, T &init)
+        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks),
+          m_reduced(chunks), m_op(op), m_tr(tr), m_init(init)
+    {
+    }
+
+    void run_first(size_t ind) noexcept
+    {
+        // fill the reduced chunks
+        auto p1 = m_partition1.at(ind);
+        m_reduced.put(ind, partial_reduce<It1, BinOp, UnOp, T>(p1.first, p1.last, m_op, m_tr));
+    }
+
+    void skip_first(size_t ind) noexcept
+    {
+        auto p1 = m_partition1.at(ind);
+        m_reduced.put(
+            ind,
+            partial_reduce<It1, BinOp, UnOp, T>(p1.first, std::next(p1.first, 2), m_op, m_tr));
+    }
+
+    void run_second(size_t ind) noexcept
+    {
+        // fill the output
+        auto p1 = m_partition1.at(ind);
+        auto p2 = m_partition2.at(ind);
+        auto val = ind == 0
+                       ? static_cast<T>(m_op(m_init, m_tr(*p1.first++)))
+                       : static_cast<T>(m_op(std::move(m_reduced[ind - 1]), m_tr(*p1.first++)));
+        *p2.first++ = val;
+        for( ; p1.first != p1.last; ++p1.first, ++p2.first ) {
+            val = m_op(std::move(val), m_tr(*p1.first));
+            *p2.first = val;
+        }
+    }
+
+    void accumulate() noexcept
+    {
+        // reduce chunks serially
+        auto first = m_reduced.begin();
+        auto last = m_reduced.end();
+        *first = m_op(m_init, std::move(*first));
+        for( auto prev = first++; first != last; ++first, ++prev )
+            *first = m_op(*prev, std::move(*first));
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt1, class FwdIt2, class BinOp, class UnOp, class T>
+FwdIt2 transform_inclusive_scan(FwdIt1 first1,
+                                FwdIt1 last1,
+                                FwdIt2 first2,
+                                BinOp reduce_op,
+                                UnOp transform_op,
+                                T val) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    const auto chunks = internal::work_chunks_min_fraction_2(count);
+    internal::TraceCall trace(algorithm::transform_inclusive_scan, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::InclusiveScan<FwdIt1, FwdIt2, BinOp, UnOp, T> op{
+                static_cast<size_t>(count), chunks, first1, first2, reduce_op, transform_op, val};
+            op.dispatch_apply_first(chunks);
+            op.accumulate();
+            op.dispatch_apply_second(chunks);
+            return op.m_partition2.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return ::std::transform_inclusive_scan(
+        first1, last1, first2, reduce_op, transform_op, std::move(val));
+}
+
+template <class FwdIt1, class FwdIt2, class BinOp, class UnOp>
+FwdIt2 transform_inclusive_scan(FwdIt1 first1,
+                                FwdIt1 last1,
+                                FwdIt2 first2,
+                                BinOp reduce_op,
+                                UnOp transform_op) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    internal::TraceCall trace(algorithm::transform_inclusive_scan, count, 0);
+    if( count == 0 )
+        return first2;
+    const auto chunks = internal::work_chunks_min_fraction_2(count - 1);
+    trace.planned(chunks);
+    if( chunks > 1 ) {
+        try {
+            *first2 = transform_op(*first1);
+            internal::InclusiveScan<FwdIt1, FwdIt2, BinOp, UnOp, internal::iterator_value_t<FwdIt2>>
+                op{static_cast<size_t>(count - 1),
+                   chunks,
+                   std::next(first1),
+                   std::next(first2),
+                   reduce_op,
+                   transform_op,
+                   *first2};
+            op.dispatch_apply_first(chunks);
+            op.accumulate();
+            op.dispatch_apply_second(chunks);
+            return op.m_partition2.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return ::std::transform_inclusive_scan(first1, last1, first2, reduce_op, transform_op);
+}
+
+template <class FwdIt1, class FwdIt2, class BinOp, class T>
+FwdIt2 inclusive_scan(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, BinOp reduce_op, T val) noexcept
+{
+    return ::pstld::transform_inclusive_scan(
+        first1, last1, first2, reduce_op, internal::no_op{}, std::move(val));
+}
+
+template <class FwdIt1, class FwdIt2, class BinOp>
+FwdIt2 inclusive_scan(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, BinOp reduce_op) noexcept
+{
+    return ::pstld::transform_inclusive_scan(first1, last1, first2, reduce_op, internal::no_op{});
+}
+
+template <class FwdIt1, class FwdIt2>
+FwdIt2 inclusive_scan(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+{
+    return ::pstld::inclusive_scan(first1, last1, first2, ::std::plus<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// exclusive_scan, transform_exclusive_scan
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It1, class It2, class BinOp, class UnOp, class T>
+struct ExclusiveScan : Dispatchable2<ExclusiveScan<It1, It2, BinOp, UnOp, T>> {
+    Partition<It1> m_partition1;
+    Partition<It2> m_partition2;
+    unitialized_array<T> m_reduced;
+    BinOp m_op;
+    UnOp m_tr;
+    T &m_init;
+
+    ExclusiveScan(size_t count, size_t chunks, It1 first1, It2 first2, BinOp op, UnOp tr, T &init)
+        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks),
+          m_reduced(chunks), m_op(op), m_tr(tr), m_init(init)
+    {
+    }
+
+    void run_first(size_t ind) noexcept
+    {
+        // fill the reduced chunks
+        auto p1 = m_partition1.at(ind);
+        m_reduced.put(ind, partial_reduce<It1, BinOp, UnOp, T>(p1.first, p1.last, m_op, m_tr));
+    }
+
+    void skip_first(size_t ind) noexcept
+    {
+        auto p1 = m_partition1.at(ind);
+        m_reduced.put(
+            ind,
+            partial_reduce<It1, BinOp, UnOp, T>(p1.first, std::next(p1.first, 2), m_op, m_tr));
+    }
+
+    void run_second(size_t ind) noexcept
+    {
+        // fill the output
+        auto p1 = m_partition1.at(ind);
+        auto p2 = m_partition2.at(ind);
+        auto val = std::move(ind == 0 ? m_init : m_reduced[ind - 1]);
+        for( ; p1.first != p1.last; ++p1.first, ++p2.first ) {
+            auto next = m_op(val, m_tr(*p1.first));
+            *p2.first = std::move(val);
+            val = std::move(next);
+        }
+    }
+
+    void accumulate() noexcept
+    {
+        // reduce chunks serially
+        auto first = m_reduced.begin();
+        auto last = m_reduced.end();
+        *first = m_op(m_init, std::move(*first));
+        for( auto prev = first++; first != last; ++first, ++prev )
+            *first = m_op(*prev, std::move(*first));
+    }
+};
+
+template <class FwdIt1, class FwdIt2, class T, class BinOp, class UnOp>
+FwdIt2 transform_exclusive_scan_serial(FwdIt1 first1,
+                                       FwdIt1 last1,
+                                       FwdIt2 first2,
+                                       T val,
+                                       BinOp reduce_op,
+                                       UnOp transform_op) noexcept
+{
+    // manual serial implementation because transform_exclusive_scan from libc++ doesn't play well
+    // with MSVC's unit tests
+    for( ; first1 != last1; ++first1, ++first2 ) {
+        auto next = reduce_op(val, transform_op(*first1));
+        *first2 = std::move(val);
+        val = std::move(next);
+    }
+    return first2;
+}
+
+} // namespace internal
+
+template <class FwdIt1, class FwdIt2, class T, class BinOp, class UnOp>
+FwdIt2 transform_exclusive_scan(FwdIt1 first1,
+                                FwdIt1 last1,
+                                FwdIt2 first2,
+                                T val,
+                                BinOp reduce_op,
+                                UnOp transform_op) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    internal::TraceCall trace(algorithm::transform_exclusive_scan, count, 0);
+    if( count == 0 )
+        return first2;
+    if( count == 1 ) {
+        *first2 = std::move(val);
+        return std::next(first2);
+    }
+    const auto chunks = internal::work_chunks_min_fraction_2(count);
+    trace.planned(chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::ExclusiveScan<FwdIt1, FwdIt2, BinOp, UnOp, T> op{
+                static_cast<size_t>(count), chunks, first1, first2, reduce_op, transform_op, val};
+            op.dispatch_apply_first(chunks);
+            op.accumulate();
+            op.dispatch_apply_second(chunks);
+            return op.m_partition2.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return internal::transform_exclusive_scan_serial(
+        first1, last1, first2, std::move(val), reduce_op, transform_op);
+}
+
+template <class FwdIt1, class FwdIt2, class T, class BinOp>
+FwdIt2 exclusive_scan(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, T val, BinOp reduce_op) noexcept
+{
+    return ::pstld::transform_exclusive_scan(
+        first1, last1, first2, std::move(val), reduce_op, internal::no_op{});
+}
+
+template <class FwdIt1, class FwdIt2, class T>
+FwdIt2 exclusive_scan(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, T val) noexcept
+{
+    return ::pstld::exclusive_scan(first1, last1, first2, std::move(val), ::std::plus<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// lexicographical_compare
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It1, class It2, class Cmp>
+struct LexicographicalCompare : Dispatchable<LexicographicalCompare<It1, It2, Cmp>> {
+    Partition<It1> m_partition1;
+    Partition<It2> m_partition2;
+    Cmp m_cmp;
+    MinIteratorResult<It1> m_result1;
+    MinIteratorResult<It2> m_result2;
+
+    LexicographicalCompare(size_t count, size_t chunks, It1 first1, It2 first2, Cmp cmp)
+        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks), m_cmp(cmp),
+          m_result1(m_partition1.end()), m_result2(m_partition2.end())
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        if( ind < m_result1.min_chunk ) {
+            auto p1 = m_partition1.at(ind);
+            auto p2 = m_partition2.at(ind);
+            for( ; p1.first != p1.last; ++p1.first, ++p2.first ) {
+                if( m_cmp(*p1.first, *p2.first) || m_cmp(*p2.first, *p1.first) ) {
+                    m_result1.put(ind, p1.first);
+                    m_result2.put(ind, p2.first);
+                    return;
+                }
+            }
+        }
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt1, class FwdIt2, class Cmp>
+bool lexicographical_compare(FwdIt1 first1,
+                             FwdIt1 last1,
+                             FwdIt2 first2,
+                             FwdIt2 last2,
+                             Cmp cmp) noexcept
+{
+    const auto count1 = std::distance(first1, last1);
+    const auto count2 = std::distance(first2, last2);
+    const auto count_min = std::min(count1, count2);
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_compare>(count_min);
+    internal::TraceCall trace(algorithm::lexicographical_compare, count_min, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::LexicographicalCompare<FwdIt1, FwdIt2, Cmp> op{
+                static_cast<size_t>(count_min), chunks, first1, first2, cmp};
+            op.dispatch_apply(chunks);
+            if( static_cast<FwdIt1>(op.m_result1.min) != op.m_partition1.end() )
+                return cmp(*static_cast<FwdIt1>(op.m_result1.min),
+                           *static_cast<FwdIt2>(op.m_result2.min));
+            else
+                return count1 < count2;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return ::std::lexicographical_compare(first1, last1, first2, last2, cmp);
+}
+
+template <class FwdIt1, class FwdIt2>
+bool lexicographical_compare(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2) noexcept
+{
+    return ::pstld::lexicographical_compare(first1, last1, first2, last2, std::less<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+// uninitialized_construct
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, bool Value>
+struct UninitializedConstruct : Dispatchable<UninitializedConstruct<It, Value>> {
+    Partition<It> m_partition;
+
+    UninitializedConstruct(size_t count, size_t chunks, It first)
+        : m_partition(first, count, chunks)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p = m_partition.at(ind);
+        if constexpr( Value )
+            std::uninitialized_value_construct(p.first, p.last);
+        else
+            std::uninitialized_default_construct(p.first, p.last);
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt>
+void uninitialized_default_construct(FwdIt first, FwdIt last) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    internal::TraceCall trace(algorithm::uninitialized_default_construct, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::UninitializedConstruct<FwdIt, false> op{
+                static_cast<size_t>(count), chunks, first};
+            op.dispatch_apply(chunks);
+            return;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::uninitialized_default_construct(first, last);
+}
+
+template <class FwdIt, class Size>
+FwdIt uninitialized_default_construct_n(FwdIt first, Size count) noexcept
+{
+    internal::TraceCall trace(algorithm::uninitialized_default_construct_n,
+                              count < 1 ? 0 : static_cast<size_t>(count),
+                              0);
+    if( count < 1 )
+        return first;
+
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    trace.planned(chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::UninitializedConstruct<FwdIt, false> op{
+                static_cast<size_t>(count), chunks, first};
+            op.dispatch_apply(chunks);
+            return op.m_partition.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::uninitialized_default_construct_n(first, count);
+}
+
+template <class FwdIt>
+void uninitialized_value_construct(FwdIt first, FwdIt last) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    internal::TraceCall trace(algorithm::uninitialized_value_construct, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::UninitializedConstruct<FwdIt, true> op{
+                static_cast<size_t>(count), chunks, first};
+            op.dispatch_apply(chunks);
+            return;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::uninitialized_value_construct(first, last);
+}
+
+template <class FwdIt, class Size>
+FwdIt uninitialized_value_construct_n(FwdIt first, Size count) noexcept
+{
+    internal::TraceCall trace(algorithm::uninitialized_value_construct_n,
+                              count < 1 ? 0 : static_cast<size_t>(count),
+                              0);
+    if( count < 1 )
+        return first;
+
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    trace.planned(chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::UninitializedConstruct<FwdIt, true> op{
+                static_cast<size_t>(count), chunks, first};
+            op.dispatch_apply(chunks);
+            return op.m_partition.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::uninitialized_value_construct_n(first, count);
+}
+
+//--------------------------------------------------------------------------------------------------
+// uninitialized_copy, uninitialized_move
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It1, class It2, bool Copy>
+struct UninitializedCopyMove : Dispatchable<UninitializedCopyMove<It1, It2, Copy>> {
+    Partition<It1> m_partition1;
+    Partition<It2> m_partition2;
+
+    UninitializedCopyMove(size_t count, size_t chunks, It1 first1, It2 first2)
+        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p1 = m_partition1.at(ind);
+        auto p2 = m_partition2.at(ind);
+        if constexpr( Copy )
+            std::uninitialized_copy(p1.first, p1.last, p2.first);
+        else
+            std::uninitialized_move(p1.first, p1.last, p2.first);
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt1, class FwdIt2>
+FwdIt2 uninitialized_copy(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    internal::TraceCall trace(algorithm::uninitialized_copy, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::UninitializedCopyMove<FwdIt1, FwdIt2, true> op{
+                static_cast<size_t>(count), chunks, first1, first2};
+            op.dispatch_apply(chunks);
+            return op.m_partition2.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::uninitialized_copy(first1, last1, first2);
+}
+
+template <class FwdIt1, class Size, class FwdIt2>
+FwdIt2 uninitialized_copy_n(FwdIt1 first1, Size count, FwdIt2 first2) noexcept
+{
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    internal::TraceCall trace(algorithm::uninitialized_copy_n, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::UninitializedCopyMove<FwdIt1, FwdIt2, true> op{
+                static_cast<size_t>(count), chunks, first1, first2};
+            op.dispatch_apply(chunks);
+            return op.m_partition2.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::uninitialized_copy_n(first1, count, first2);
+}
+
+template <class FwdIt1, class FwdIt2>
+FwdIt2 uninitialized_move(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    internal::TraceCall trace(algorithm::uninitialized_move, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::UninitializedCopyMove<FwdIt1, FwdIt2, false> op{
+                static_cast<size_t>(count), chunks, first1, first2};
+            op.dispatch_apply(chunks);
+            return op.m_partition2.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::uninitialized_move(first1, last1, first2);
+}
+
+template <class FwdIt1, class Size, class FwdIt2>
+std::pair<FwdIt1, FwdIt2> uninitialized_move_n(FwdIt1 first1, Size count, FwdIt2 first2) noexcept
+{
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    internal::TraceCall trace(algorithm::uninitialized_move_n, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::UninitializedCopyMove<FwdIt1, FwdIt2, false> op{
+                static_cast<size_t>(count), chunks, first1, first2};
+            op.dispatch_apply(chunks);
+            return {op.m_partition1.end(), op.m_partition2.end()};
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::uninitialized_move_n(first1, count, first2);
+}
+
+//--------------------------------------------------------------------------------------------------
+// uninitialized_fill
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It, class T>
+struct UninitializedFill : Dispatchable<UninitializedFill<It, T>> {
+    Partition<It> m_partition;
+    const T &m_val;
+
+    UninitializedFill(size_t count, size_t chunks, It first, const T &val)
+        : m_partition(first, count, chunks), m_val(val)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p = m_partition.at(ind);
+        std::uninitialized_fill(p.first, p.last, m_val);
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt, class T>
+void uninitialized_fill(FwdIt first, FwdIt last, const T &val) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    internal::TraceCall trace(algorithm::uninitialized_fill, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::UninitializedFill<FwdIt, T> op{
+                static_cast<size_t>(count), chunks, first, val};
+            op.dispatch_apply(chunks);
+            return;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::uninitialized_fill(first, last, val);
+}
+
+template <class FwdIt, class Size, class T>
+FwdIt uninitialized_fill_n(FwdIt first, Size count, const T &val) noexcept
+{
+    internal::TraceCall trace(algorithm::uninitialized_fill_n,
+                              count < 1 ? 0 : static_cast<size_t>(count),
+                              0);
+    if( count < 1 )
+        return first;
+
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    trace.planned(chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::UninitializedFill<FwdIt, T> op{
+                static_cast<size_t>(count), chunks, first, val};
+            op.dispatch_apply(chunks);
+            return op.m_partition.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::uninitialized_fill_n(first, count, val);
+}
+
+//--------------------------------------------------------------------------------------------------
+// destroy
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It>
+struct Destroy : Dispatchable<Destroy<It>> {
+    Partition<It> m_partition;
+
+    Destroy(size_t count, size_t chunks, It first) : m_partition(first, count, chunks) {}
+
+    void run(size_t ind) noexcept
+    {
+        auto p = m_partition.at(ind);
+        std::destroy(p.first, p.last);
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt>
+void destroy(FwdIt first, FwdIt last) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    internal::TraceCall trace(algorithm::destroy, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Destroy<FwdIt> op{static_cast<size_t>(count), chunks, first};
+            op.dispatch_apply(chunks);
+            return;
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::destroy(first, last);
+}
+
+template <class FwdIt, class Size>
+FwdIt destroy_n(FwdIt first, Size count) noexcept
+{
+    internal::TraceCall trace(algorithm::destroy_n, count < 1 ? 0 : static_cast<size_t>(count), 0);
+    if( count < 1 )
+        return first;
+
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    trace.planned(chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Destroy<FwdIt> op{static_cast<size_t>(count), chunks, first};
+            op.dispatch_apply(chunks);
+            return op.m_partition.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::destroy_n(first, count);
+}
+
+//--------------------------------------------------------------------------------------------------
+// move
+//--------------------------------------------------------------------------------------------------
+
+namespace internal {
+
+template <class It1, class It2>
+struct Move : Dispatchable<Move<It1, It2>> {
+    Partition<It1> m_partition1;
+    Partition<It2> m_partition2;
+
+    Move(size_t count, size_t chunks, It1 first1, It2 first2)
+        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        auto p1 = m_partition1.at(ind);
+        auto p2 = m_partition2.at(ind);
+        std::move(p1.first, p1.last, p2.first);
+    }
+};
+
+} // namespace internal
+
+template <class FwdIt1, class FwdIt2>
+FwdIt2 move(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+{
+    const auto count = std::distance(first1, last1);
+    const auto chunks = internal::work_chunks_min_fraction_1<internal::cost_copy>(count);
+    internal::TraceCall trace(algorithm::move, count, chunks);
+    if( chunks > 1 ) {
+        try {
+            internal::Move<FwdIt1, FwdIt2> op{static_cast<size_t>(count), chunks, first1, first2};
+            op.dispatch_apply(chunks);
+            return op.m_partition2.end();
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return std::move(first1, last1, first2);
+}
+
+//--------------------------------------------------------------------------------------------------
+// bounded_count, bounded_count_if, bounded_find, bounded_find_if, bounded_reduce,
+// bounded_transform_reduce
+//--------------------------------------------------------------------------------------------------
+
+// The result of a deadline-bounded call: the answer computed over the elements the call managed to
+// process before the deadline. 'covered' is the number of elements the answer accounts for, out of
+// 'total'. An incomplete answer is approximate, e.g. a count of the covered elements only.
+template <class T>
+struct bounded_result {
+    T value;
+    size_t covered;
+    size_t total;
+
+    bool complete() const noexcept { return covered == total; }
+};
+
+namespace internal {
+
+// Calls which are too small to go parallel still check their deadline this many times.
+inline constexpr size_t deadline_serial_chunks = 16;
+
+// The number of chunks of a deadline-bounded call, 0 means that it should run to completion.
+inline size_t bounded_chunks(size_t count, size_t min_chunk, size_t parallel_chunks) noexcept
+{
+    if( parallel_chunks > 1 )
+        return parallel_chunks;
+    return std::min(deadline_serial_chunks, count / min_chunk);
+}
+
+// Runs the chunks, in parallel or one after another on the calling thread, and keeps track of
+// which of them were started before the deadline.
+template <class T>
+struct DeadlineBounded : Dispatchable<T> {
+    size_t m_count;
+    size_t m_chunks;
+    bool m_parallel;
+    std::chrono::steady_clock::time_point m_deadline;
+    parallelism_vector<unsigned char> m_started;
+
+    DeadlineBounded(size_t count,
+                    size_t chunks,
+                    bool parallel,
+                    std::chrono::steady_clock::time_point deadline)
+        : m_count(count), m_chunks(chunks), m_parallel(parallel), m_deadline(deadline),
+          m_started(chunks)
+    {
+    }
+
+    void execute() noexcept
+    {
+        if( m_parallel )
+            this->dispatch_apply(m_chunks);
+        else
+            for( size_t i = 0; i != m_chunks; ++i )
+                Dispatchable<T>::dispatch(this, i);
+    }
+
+    bool start_chunk(size_t ind) noexcept
+    {
+        if( std::chrono::steady_clock::now() >= m_deadline )
+            return false;
+        m_started[ind] = 1;
+        return true;
+    }
+
+    size_t chunk_size(size_t ind) const noexcept
+    {
+        return m_count / m_chunks + (ind < m_count % m_chunks ? 1 : 0);
+    }
+
+    size_t covered() const noexcept
+    {
+        size_t covered = 0;
+        for( size_t i = 0; i != m_chunks; ++i )
+            if( m_started[i] )
+                covered += chunk_size(i);
+        return covered;
+    }
+};
+
+template <class It, class Pred>
+struct BoundedCount : DeadlineBounded<BoundedCount<It, Pred>> {
+    Partition<It> m_partition;
+    Pred m_pred;
+    std::atomic<iterator_diff_t<It>> m_result{};
+
+    BoundedCount(size_t count,
+                 size_t chunks,
+                 bool parallel,
+                 std::chrono::steady_clock::time_point deadline,
+                 It first,
+                 Pred pred)
+        : DeadlineBounded<BoundedCount>(count, chunks, parallel, deadline),
+          m_partition(first, count, chunks), m_pred(pred)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        if( this->start_chunk(ind) ) {
+            auto p = m_partition.at(ind);
+            m_result += std::count_if(p.first, p.last, m_pred);
+        }
+    }
+};
+
+template <class It, class Pred>
+struct BoundedFind : DeadlineBounded<BoundedFind<It, Pred>> {
+    Partition<It> m_partition;
+    MinIteratorResult<It> m_result;
+    Pred m_pred;
+
+    BoundedFind(size_t count,
+                size_t chunks,
+                bool parallel,
+                std::chrono::steady_clock::time_point deadline,
+                It first,
+                It last,
+                Pred pred)
+        : DeadlineBounded<BoundedFind>(count, chunks, parallel, deadline),
+          m_partition(first, count, chunks), m_result{last}, m_pred(pred)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        if( ind < m_result.min_chunk && this->start_chunk(ind) ) {
+            auto p = m_partition.at(ind);
+            auto it = std::find_if(p.first, p.last, m_pred);
+            if( it != p.last )
+                m_result.put(ind, it);
+        }
+    }
+
+    // The answer is final once every chunk before the one with the match was examined, the chunks
+    // after it don't matter.
+    size_t covered() const noexcept
+    {
+        for( size_t i = 0; i != this->m_chunks && i < m_result.min_chunk; ++i )
+            if( !this->m_started[i] )
+                return DeadlineBounded<BoundedFind>::covered();
+        return this->m_count;
+    }
+};
+
+template <class It, class T, class BinOp, class UnOp>
+struct BoundedTransformReduce : DeadlineBounded<BoundedTransformReduce<It, T, BinOp, UnOp>> {
+    Partition<It> m_partition;
+    parallelism_vector<std::optional<T>> m_results;
+    BinOp m_reduce;
+    UnOp m_transform;
+
+    BoundedTransformReduce(size_t count,
+                           size_t chunks,
+                           bool parallel,
+                           std::chrono::steady_clock::time_point deadline,
+                           It first,
+                           BinOp reduce_op,
+                           UnOp transform_op)
+        : DeadlineBounded<BoundedTransformReduce>(count, chunks, parallel, deadline),
+          m_partition(first, count, chunks), m_results(chunks), m_reduce(reduce_op),
+          m_transform(transform_op)
+    {
+    }
+
+    void run(size_t ind) noexcept
+    {
+        if( this->start_chunk(ind) ) {
+            auto p = m_partition.at(ind);
+            auto next = p.first;
+            T val = m_reduce(m_transform(*p.first), m_transform(*++next));
+            while( ++next != p.last )
+                val = m_reduce(std::move(val), m_transform(*next));
+            m_results[ind].emplace(std::move(val));
+        }
+    }
+
+    T reduce(T val) noexcept
+    {
+        for( auto &result : m_results )
+            if( result )
+                val = m_reduce(std::move(val), std::move(*result));
+        return val;
+    }
+};
+
+} // namespace internal
+
+// Deadline-bounded counterparts of count_if, find_if and transform_reduce for callers which prefer
+// an approximate answer to a late one. The chunks not started by the deadline are skipped and the
+// result tells how much of the input was covered. A chunk started before the deadline runs to its
+// end, so the call may overrun the deadline by the time of processing one chunk.
+template <class FwdIt, class Pred>
+bounded_result<typename std::iterator_traits<FwdIt>::difference_type>
+bounded_count_if(std::chrono::steady_clock::time_point deadline,
+                 FwdIt first,
+                 FwdIt last,
+                 Pred pred) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_1(count);
+    internal::TraceCall trace(algorithm::bounded_count_if, count, chunks);
+    const auto bounded = internal::bounded_chunks(count, 1, chunks);
+    if( bounded != 0 ) {
+        try {
+            internal::BoundedCount<FwdIt, Pred> op{
+                static_cast<size_t>(count), bounded, chunks > 1, deadline, first, pred};
+            op.execute();
+            return {op.m_result, op.covered(), static_cast<size_t>(count)};
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return {std::count_if(first, last, pred),
+            static_cast<size_t>(count),
+            static_cast<size_t>(count)};
+}
+
+template <class FwdIt, class T>
+bounded_result<typename std::iterator_traits<FwdIt>::difference_type>
+bounded_count(std::chrono::steady_clock::time_point deadline,
+              FwdIt first,
+              FwdIt last,
+              const T &value) noexcept
+{
+    return ::pstld::bounded_count_if(
+        deadline, first, last, [&value](const auto &iter_value) { return iter_value == value; });
+}
+
+// An incomplete result holds the first match among the covered elements, or 'last'.
+template <class FwdIt, class Pred>
+bounded_result<FwdIt> bounded_find_if(std::chrono::steady_clock::time_point deadline,
+                                      FwdIt first,
+                                      FwdIt last,
+                                      Pred pred) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_1(count);
+    internal::TraceCall trace(algorithm::bounded_find_if, count, chunks);
+    const auto bounded = internal::bounded_chunks(count, 1, chunks);
+    if( bounded != 0 ) {
+        try {
+            internal::BoundedFind<FwdIt, Pred> op{
+                static_cast<size_t>(count), bounded, chunks > 1, deadline, first, last, pred};
+            op.execute();
+            return {op.m_result.min, op.covered(), static_cast<size_t>(count)};
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return {std::find_if(first, last, pred),
+            static_cast<size_t>(count),
+            static_cast<size_t>(count)};
+}
+
+template <class FwdIt, class T>
+bounded_result<FwdIt> bounded_find(std::chrono::steady_clock::time_point deadline,
+                                   FwdIt first,
+                                   FwdIt last,
+                                   const T &value) noexcept
+{
+    return ::pstld::bounded_find_if(
+        deadline, first, last, [&value](const auto &iter_value) { return iter_value == value; });
+}
+
+template <class FwdIt, class T, class BinOp, class UnOp>
+bounded_result<T> bounded_transform_reduce(std::chrono::steady_clock::time_point deadline,
+                                           FwdIt first,
+                                           FwdIt last,
+                                           T val,
+                                           BinOp reduce_op,
+                                           UnOp transform_op) noexcept
+{
+    const auto count = std::distance(first, last);
+    const auto chunks = internal::work_chunks_min_fraction_2(count);
+    internal::TraceCall trace(algorithm::bounded_transform_reduce, count, chunks);
+    const auto bounded = internal::bounded_chunks(count, 2, chunks);
+    if( bounded != 0 ) {
+        try {
+            internal::BoundedTransformReduce<FwdIt, T, BinOp, UnOp> op{static_cast<size_t>(count),
+                                                                       bounded,
+                                                                       chunks > 1,
+                                                                       deadline,
+                                                                       first,
+                                                                       reduce_op,
+                                                                       transform_op};
+            op.execute();
+            return {op.reduce(std::move(val)), op.covered(), static_cast<size_t>(count)};
+        } catch( const internal::parallelism_exception & ) {
+            trace.fallback();
+        }
+    }
+    return {std::transform_reduce(first, last, std::move(val), reduce_op, transform_op),
+            static_cast<size_t>(count),
+            static_cast<size_t>(count)};
+}
+
+template <class FwdIt, class T, class BinOp>
+bounded_result<T> bounded_reduce(std::chrono::steady_clock::time_point deadline,
+                                 FwdIt first,
+                                 FwdIt last,
+                                 T val,
+                                 BinOp reduce_op) noexcept
+{
+    return ::pstld::bounded_transform_reduce(
+        deadline, first, last, std::move(val), reduce_op, internal::no_op{});
+}
+
+template <class FwdIt, class T>
+bounded_result<T> bounded_reduce(std::chrono::steady_clock::time_point deadline,
+                                 FwdIt first,
+                                 FwdIt last,
+                                 T val) noexcept
+{
+    return ::pstld::bounded_reduce(deadline, first, last, std::move(val), std::plus<>{});
+}
+
+//--------------------------------------------------------------------------------------------------
+//
+// Execution policies
+//
+//--------------------------------------------------------------------------------------------------
+
+namespace execution {
+
+// A parallel execution policy which can carry per-call properties, e.g. an executor to run on:
+//   pstld::sort(pstld::execution::par.on(pool), v.begin(), v.end());
+// The properties are applied in order, the last one of a kind wins. The plain 'par' carries none,
+// so calls made with it are identical to the ones made without a policy.
+template <class... Properties>
+class parallel_policy
+{
+public:
+    constexpr parallel_policy() noexcept = default;
+    constexpr explicit parallel_policy(const std::tuple<Properties...> &properties) noexcept
+        : m_properties(properties)
+    {
+    }
+
+    template <class... Others>
+    constexpr parallel_policy<Properties..., Others...> with(const Others &...others) const noexcept
+    {
+        return parallel_policy<Properties..., Others...>{
+            std::tuple_cat(m_properties, std::tuple<Others...>{others...})};
+    }
+
+    constexpr parallel_policy<Properties..., executor> on(const executor &e) const noexcept
+    {
+        return with(e);
+    }
+
+    constexpr const std::tuple<Properties...> &properties() const noexcept { return m_properties; }
+
+private:
+    std::tuple<Properties...> m_properties;
+};
+
+inline constexpr parallel_policy<> par{};
+inline constexpr parallel_policy<priority> par_background{std::tuple{priority::background}};
+inline constexpr parallel_policy<priority> par_utility{std::tuple{priority::utility}};
+inline constexpr parallel_policy<priority> par_user_initiated{std::tuple{priority::user_initiated}};
+inline constexpr parallel_policy<priority> par_user_interactive{
+    std::tuple{priority::user_interactive}};
+
+template <class T>
+struct is_execution_policy : std::false_type {
+};
+template <class... Properties>
+struct is_execution_policy<parallel_policy<Properties...>> : std::true_type {
+};
+
+template <class T>
+inline constexpr bool is_execution_policy_v = is_execution_policy<T>::value;
+
+template <class ExPo, class T>
+using enable_if_execution_policy =
+    typename std::enable_if<is_execution_policy_v<typename std::decay<ExPo>::type>, T>::type;
+
+} // namespace execution
+
+namespace internal {
+
+inline void apply_property(CallOptions &options, const executor &e) noexcept
+{
+    options.exec = &e;
+}
+
+inline void apply_property(CallOptions &options, const execution::idle_strategy &idle) noexcept
+{
+    options.idle = idle;
+}
+
+inline void apply_property(CallOptions &options, const execution::grain &grain) noexcept
+{
+    options.grain = grain.elements;
+}
+
+inline void apply_property(CallOptions &options, const execution::chunks_per_cpu &chunks) noexcept
+{
+    options.chunks_per_cpu = chunks.chunks;
+}
+
+inline void apply_property(CallOptions &options, const execution::serial_below &cutoff) noexcept
+{
+    options.serial_below = cutoff.elements;
+}
+
+inline void apply_property(CallOptions &options, const arena &a) noexcept
+{
+    options.worker_limit = a.workers();
+}
+
+inline void apply_property(CallOptions &options, execution::priority priority) noexcept
+{
+    options.priority = priority;
+}
+
+struct StopFlag {
+    static const std::atomic<bool> *of(const stop_token &token) noexcept
+    {
+        return token.m_state.get();
+    }
+};
+
+inline void apply_property(CallOptions &options, const stop_token &token) noexcept
+{
+    options.stop = StopFlag::of(token);
+}
+
+struct AffinityOf {
+    static AffinityMap *of(const affinity_partitioner &partitioner) noexcept
+    {
+        return partitioner.m_map.get();
+    }
+};
+
+inline void apply_property(CallOptions &options, const affinity_partitioner &partitioner) noexcept
+{
+    options.affinity = AffinityOf::of(partitioner);
+}
+
+// Installs the options carried by a policy on the calling thread for the duration of a call.
+// Policies without properties don't touch the thread-local state at all.
+template <class ExPo>
+class PolicyScope
+{
+public:
+    explicit PolicyScope(const ExPo &) noexcept {}
+};
+
+template <class Property, class... Properties>
+class PolicyScope<execution::parallel_policy<Property, Properties...>>
+{
+public:
+    explicit PolicyScope(const execution::parallel_policy<Property, Properties...> &policy) noexcept
+        : m_options(call_options() != nullptr ? *call_options() : CallOptions{}),
+          m_prev(std::exchange(call_options(), &m_options))
+    {
+        std::apply([this](const auto &...props) { (apply_property(m_options, props), ...); },
+                   policy.properties());
+    }
+    PolicyScope(const PolicyScope &) = delete;
+    ~PolicyScope() { call_options() = m_prev; }
+
+private:
+    CallOptions m_options;
+    const CallOptions *m_prev;
+};
+
+template <class ExPo>
+using policy_scope_t = PolicyScope<typename std::decay<ExPo>::type>;
+
+} // namespace internal
+
+// explain /////////////////////////////////////////////////////////////////////////////////////////
+
+// Reports how a call of 'a' on 'count' elements would be carried out under the policy, without
+// running anything. T is the value type of the range, or the type of the result for the reductions
+// and the scans, which only affects the temporary memory. The iterators are taken to be random
+// access. The count of a search is the number of positions to try, i.e. the length of the range
+// less the length of the needle plus one.
+template <class T, class ExPo>
+execution::enable_if_execution_policy<ExPo, plan>
+explain(algorithm a, size_t count, ExPo &&policy) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return internal::explain_call(a, count, sizeof(T), alignof(T));
+}
+
+template <class T>
+plan explain(algorithm a, size_t count) noexcept
+{
+    return internal::explain_call(a, count, sizeof(T), alignof(T));
+}
+
+// 25.6.1 - all_of /////////////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It, class UnPred>
+execution::enable_if_execution_policy<ExPo, bool>
+all_of(ExPo &&policy, It first, It last, UnPred p) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::all_of(first, last, p);
+}
+
+// 25.6.2 - any_of ////////////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It, class UnPred>
+execution::enable_if_execution_policy<ExPo, bool>
+any_of(ExPo &&policy, It first, It last, UnPred p) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::any_of(first, last, p);
+}
+
+// 25.6.3 - none_of ////////////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It, class UnPred>
+execution::enable_if_execution_policy<ExPo, bool>
+none_of(ExPo &&policy, It first, It last, UnPred p) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::none_of(first, last, p);
+}
+
+// 25.6.4 - for_each, for_each_n ///////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It, class Func>
+execution::enable_if_execution_policy<ExPo, void>
+for_each(ExPo &&policy, It first, It last, Func f) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    ::pstld::for_each(first, last, f);
+}
+
+template <class ExPo, class It, class Size, class Func>
+execution::enable_if_execution_policy<ExPo, It>
+for_each_n(ExPo &&policy, It first, Size count, Func f) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::for_each_n(first, count, f);
+}
+
+// 25.6.5 - find, find_if, find_if_not /////////////////////////////////////////////////////////////
+
+template <class ExPo, class It, class T>
+execution::enable_if_execution_policy<ExPo, It>
+find(ExPo &&policy, It first, It last, const T &value) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::find(first, last, value);
+}
+
+template <class ExPo, class It, class Pred>
+execution::enable_if_execution_policy<ExPo, It>
+find_if(ExPo &&policy, It first, It last, Pred pred) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::find_if(first, last, pred);
+}
+
+template <class ExPo, class It, class Pred>
+execution::enable_if_execution_policy<ExPo, It>
+find_if_not(ExPo &&policy, It first, It last, Pred pred) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::find_if_not(first, last, pred);
+}
+
+// 25.6.6 - find_end ///////////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It1, class It2>
+execution::enable_if_execution_policy<ExPo, It1>
+find_end(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::find_end(first1, last1, first2, last2);
+}
+
+template <class ExPo, class It1, class It2, class Pred>
+execution::enable_if_execution_policy<ExPo, It1>
+find_end(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2, Pred pred)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::find_end(first1, last1, first2, last2, pred);
+}
+
+// 25.6.7 - find_first_of //////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It1, class It2>
+execution::enable_if_execution_policy<ExPo, It1>
+find_first_of(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::find_first_of(first1, last1, first2, last2);
+}
+
+template <class ExPo, class It1, class It2, class Pred>
+execution::enable_if_execution_policy<ExPo, It1>
+find_first_of(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2, Pred pred) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::find_first_of(first1, last1, first2, last2, pred);
+}
+
+// 25.6.8 - adjacent_find //////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It>
+execution::enable_if_execution_policy<ExPo, It>
+adjacent_find(ExPo &&policy, It first, It last) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::adjacent_find(first, last);
+}
+
+template <class ExPo, class It, class Pred>
+execution::enable_if_execution_policy<ExPo, It>
+adjacent_find(ExPo &&policy, It first, It last, Pred pred) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::adjacent_find(first, last, pred);
+}
+
+// 25.6.9 - count, count_if ////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It, class T>
+execution::enable_if_execution_policy<ExPo, typename std::iterator_traits<It>::difference_type>
+count(ExPo &&policy, It first, It last, const T &value) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::count(first, last, value);
+}
+
+template <class ExPo, class It, class Pred>
+execution::enable_if_execution_policy<ExPo, typename std::iterator_traits<It>::difference_type>
+count_if(ExPo &&policy, It first, It last, Pred pred) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::count_if(first, last, pred);
+}
+
+// 25.6.10 - mismatch //////////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It1, class It2>
+execution::enable_if_execution_policy<ExPo, std::pair<It1, It2>>
+mismatch(ExPo &&policy, It1 first1, It1 last1, It2 first2) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::mismatch(first1, last1, first2);
+}
+
+template <class ExPo, class It1, class It2, class Cmp>
+execution::enable_if_execution_policy<ExPo, std::pair<It1, It2>>
+mismatch(ExPo &&policy, It1 first1, It1 last1, It2 first2, Cmp cmp) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::mismatch(first1, last1, first2, cmp);
+}
+
+template <class ExPo, class It1, class It2>
+execution::enable_if_execution_policy<ExPo, std::pair<It1, It2>>
+mismatch(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::mismatch(first1, last1, first2, last2);
+}
+
+template <class ExPo, class It1, class It2, class Cmp>
+execution::enable_if_execution_policy<ExPo, std::pair<It1, It2>>
+mismatch(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2, Cmp cmp) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::mismatch(first1, last1, first2, last2, cmp);
+}
+
+// 25.6.11 - equal /////////////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It1, class It2>
+execution::enable_if_execution_policy<ExPo, bool>
+equal(ExPo &&policy, It1 first1, It1 last1, It2 first2) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::equal(first1, last1, first2);
+}
+
+template <class ExPo, class It1, class It2, class Eq>
+execution::enable_if_execution_policy<ExPo, bool>
+equal(ExPo &&policy, It1 first1, It1 last1, It2 first2, Eq eq) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::equal(first1, last1, first2, eq);
+}
+
+template <class ExPo, class It1, class It2>
+execution::enable_if_execution_policy<ExPo, bool>
+equal(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::equal(first1, last1, first2, last2);
+}
+
+template <class ExPo, class It1, class It2, class Eq>
+execution::enable_if_execution_policy<ExPo, bool>
+equal(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2, Eq eq) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::equal(first1, last1, first2, last2, eq);
+}
+
+// 25.6.13 - search, search_n //////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It1, class It2>
+execution::enable_if_execution_policy<ExPo, It1>
+search(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::search(first1, last1, first2, last2);
+}
+
+template <class ExPo, class It1, class It2, class Pred>
+execution::enable_if_execution_policy<ExPo, It1>
+search(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2, Pred pred) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::search(first1, last1, first2, last2, pred);
+}
+
+template <class ExPo, class It, class Size, class T>
+execution::enable_if_execution_policy<ExPo, It>
+search_n(ExPo &&policy, It first, It last, Size count, const T &value) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::search_n(first, last, count, value);
+}
+
+template <class ExPo, class It, class Size, class T, class Pred>
+execution::enable_if_execution_policy<ExPo, It>
+search_n(ExPo &&policy, It first, It last, Size count, const T &value, Pred pred) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::search_n(first, last, count, value, pred);
+}
+
+// 25.7.1 - copy, copy_n, copy_if //////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It1, class It2>
+execution::enable_if_execution_policy<ExPo, It2>
+copy(ExPo &&policy, It1 first, It1 last, It2 result) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::copy(first, last, result);
+}
+
+template <class ExPo, class It1, class Size, class It2>
+execution::enable_if_execution_policy<ExPo, It2>
+copy_n(ExPo &&policy, It1 first, Size count, It2 result) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::copy_n(first, count, result);
+}
+
+template <class ExPo, class It1, class It2, class Pred>
+execution::enable_if_execution_policy<ExPo, It2>
+copy_if(ExPo &&policy, It1 first, It1 last, It2 result, Pred pred) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::copy_if(first, last, result, pred);
+}
+
+// 25.7.2 - move ///////////////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It1, class It2>
+execution::enable_if_execution_policy<ExPo, It2>
+move(ExPo &&policy, It1 first, It1 last, It2 result) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::move(first, last, result);
+}
+
+// 25.7.3 - swap_ranges ////////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It1, class It2>
+execution::enable_if_execution_policy<ExPo, It2>
+swap_ranges(ExPo &&policy, It1 first, It1 last, It2 result) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::swap_ranges(first, last, result);
+}
+
+// 25.7.4 - transform //////////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It1, class It2, class UnOp>
+execution::enable_if_execution_policy<ExPo, It2>
+transform(ExPo &&policy, It1 first1, It1 last1, It2 first2, UnOp op) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::transform(first1, last1, first2, op);
+}
+
+template <class ExPo, class It1, class It2, class It3, class UnOp>
+execution::enable_if_execution_policy<ExPo, It3>
+transform(ExPo &&policy, It1 first1, It1 last1, It2 first2, It3 first3, UnOp op) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::transform(first1, last1, first2, first3, op);
+}
+
+// 25.7.5 - replace, replace_if, replace_copy, replace_copy_if /////////////////////////////////////
+
+template <class ExPo, class It, class T>
+execution::enable_if_execution_policy<ExPo, void>
+replace(ExPo &&policy, It first, It last, const T &old_val, const T &new_val) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    ::pstld::replace(first, last, old_val, new_val);
+}
+
+template <class ExPo, class It, class Pred, class T>
+execution::enable_if_execution_policy<ExPo, void>
+replace_if(ExPo &&policy, It first, It last, Pred pred, const T &new_val) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    ::pstld::replace_if(first, last, pred, new_val);
+}
+
+// 25.7.6 - fill, fill_n ///////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It, class T>
+execution::enable_if_execution_policy<ExPo, void>
+fill(ExPo &&policy, It first, It last, const T &value) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    ::pstld::fill(first, last, value);
+}
+
+template <class ExPo, class It, class Size, class T>
+execution::enable_if_execution_policy<ExPo, It>
+fill_n(ExPo &&policy, It first, Size count, const T &value) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::fill_n(first, count, value);
+}
+
+// 25.7.7 - generate, generate_n ///////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It, class Gen>
+execution::enable_if_execution_policy<ExPo, void>
+generate(ExPo &&policy, It first, It last, Gen gen)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    ::pstld::generate(first, last, gen);
+}
+
+template <class ExPo, class It, class Size, class Gen>
+execution::enable_if_execution_policy<ExPo, It>
+generate_n(ExPo &&policy, It first, Size count, Gen gen)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::generate_n(first, count, gen);
+}
+
+// 25.7.10 - reverse ///////////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It>
+execution::enable_if_execution_policy<ExPo, void> reverse(ExPo &&policy, It first, It last)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    ::pstld::reverse(first, last);
+}
+
+// 25.8.2.1 - sort /////////////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It>
+execution::enable_if_execution_policy<ExPo, void> sort(ExPo &&policy, It first, It last)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    ::pstld::sort(first, last);
+}
+
+template <class ExPo, class It, class Cmp>
+execution::enable_if_execution_policy<ExPo, void> sort(ExPo &&policy, It first, It last, Cmp cmp)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    ::pstld::sort(first, last, cmp);
+}
+
+// 25.8.2.2 - stable_sort //////////////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It>
+execution::enable_if_execution_policy<ExPo, void> stable_sort(ExPo &&policy, It first, It last)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    ::pstld::stable_sort(first, last);
+}
+
+template <class ExPo, class It, class Cmp>
+execution::enable_if_execution_policy<ExPo, void>
+stable_sort(ExPo &&policy, It first, It last, Cmp cmp)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    ::pstld::stable_sort(first, last, cmp);
+}
+
+template <class ExPo, class It, class Cmp>
+execution::enable_if_execution_policy<ExPo, void>
+stable_sort(ExPo &&policy,
+            It first,
+            It last,
+            Cmp cmp,
+            scratch_span<typename std::iterator_traits<It>::value_type> scratch)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    ::pstld::stable_sort(first, last, cmp, scratch);
+}
+
+// 25.8.2.5 - is_sorted, is_sorted_until ///////////////////////////////////////////////////////////
+
+template <class ExPo, class It>
+execution::enable_if_execution_policy<ExPo, bool> is_sorted(ExPo &&policy, It first, It last)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::is_sorted(first, last);
+}
+
+template <class ExPo, class It, class Cmp>
+execution::enable_if_execution_policy<ExPo, bool>
+is_sorted(ExPo &&policy, It first, It last, Cmp cmp)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::is_sorted(first, last, cmp);
+}
+
+template <class ExPo, class It>
+execution::enable_if_execution_policy<ExPo, It> is_sorted_until(ExPo &&policy, It first, It last)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::is_sorted_until(first, last);
+}
+
+template <class ExPo, class It, class Cmp>
+execution::enable_if_execution_policy<ExPo, It>
+is_sorted_until(ExPo &&policy, It first, It last, Cmp cmp)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::is_sorted_until(first, last, cmp);
+}
+
+// 25.8.5 - is_partitioned /////////////////////////////////////////////////////////////////////////
 
-template <class FwdIt>
-FwdIt adjacent_find(FwdIt first, FwdIt last) noexcept
+template <class ExPo, class It, class Pred>
+execution::enable_if_execution_policy<ExPo, bool>
+is_partitioned(ExPo &&policy, It first, It last, Pred pred)
 {
-    return ::pstld::adjacent_find(
-        first, last, [](const auto &v1, const auto &v2) { return v1 == v2; });
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::is_partitioned(first, last, pred);
 }
 
-//--------------------------------------------------------------------------------------------------
-// search
-//--------------------------------------------------------------------------------------------------
+// 25.8.6 - merge //////////////////////////////////////////////////////////////////////////////////
 
-namespace internal {
+template <class ExPo, class It1, class It2, class It3>
+execution::enable_if_execution_policy<ExPo, It3>
+merge(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2, It3 first3)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::merge(first1, last1, first2, last2, first3);
+}
 
-template <class It1, class It2, class Pred>
-struct Search : Dispatchable<Search<It1, It2, Pred>> {
-    Partition<It1> m_partition;
-    MinIteratorResult<It1> m_result;
-    Pred m_pred;
-    It2 m_first2;
-    It2 m_last2;
+template <class ExPo, class It1, class It2, class It3, class Cmp>
+execution::enable_if_execution_policy<ExPo, It3>
+merge(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2, It3 first3, Cmp cmp)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::merge(first1, last1, first2, last2, first3, cmp);
+}
 
-    Search(size_t count, size_t chunks, It1 first1, It1 last1, It2 first2, It2 last2, Pred pred)
-        : m_partition(first1, count, chunks), m_result{last1}, m_pred(pred), m_first2(first2),
-          m_last2(last2)
-    {
-    }
+// 25.8.9 - min_element, max_element, minmax_element ///////////////////////////////////////////////
 
-    void run(size_t ind) noexcept
-    {
-        if( ind < m_result.min_chunk ) {
-            for( auto p = m_partition.at(ind); p.first != p.last; ++p.first ) {
-                auto i1 = p.first;
-                auto i2 = m_first2;
-                for( ;; ++i1, ++i2 ) {
-                    if( i2 == m_last2 ) {
-                        m_result.put(ind, p.first);
-                        return;
-                    }
-                    if( !m_pred(*i1, *i2) )
-                        break;
-                }
-            }
-        }
-    }
-};
+template <class ExPo, class It>
+execution::enable_if_execution_policy<ExPo, It> min_element(ExPo &&policy, It first, It last)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::min_element(first, last);
+}
 
-} // namespace internal
+template <class ExPo, class It, class Cmp>
+execution::enable_if_execution_policy<ExPo, It>
+min_element(ExPo &&policy, It first, It last, Cmp cmp)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::min_element(first, last, cmp);
+}
 
-template <class FwdIt1, class FwdIt2, class Pred>
-FwdIt1 search(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2, Pred pred) noexcept
+template <class ExPo, class It>
+execution::enable_if_execution_policy<ExPo, It> max_element(ExPo &&policy, It first, It last)
 {
-    if( first1 == last1 || first2 == last2 )
-        return first1;
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::max_element(first, last);
+}
 
-    const auto count1 = std::distance(first1, last1);
-    const auto count2 = std::distance(first2, last2);
-    if( count1 < count2 )
-        return last1;
-    if( count1 == count2 )
-        return std::equal(first1, last1, first2, last2, pred) ? first1 : last1;
+template <class ExPo, class It, class Cmp>
+execution::enable_if_execution_policy<ExPo, It>
+max_element(ExPo &&policy, It first, It last, Cmp cmp)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::max_element(first, last, cmp);
+}
 
-    const auto count = count1 - count2 + 1;
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    try {
-        internal::Search<FwdIt1, FwdIt2, Pred> op{
-            static_cast<size_t>(count), chunks, first1, last1, first2, last2, pred};
-        op.dispatch_apply(chunks);
-        return op.m_result.min;
-    } catch( const internal::parallelism_exception & ) {
-    }
-    return std::search(first1, last1, first2, last2, pred);
+template <class ExPo, class It>
+execution::enable_if_execution_policy<ExPo, std::pair<It, It>>
+minmax_element(ExPo &&policy, It first, It last)
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::minmax_element(first, last);
 }
 
-template <class FwdIt1, class FwdIt2>
-FwdIt1 search(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2) noexcept
+template <class ExPo, class It, class Cmp>
+execution::enable_if_execution_policy<ExPo, std::pair<It, It>>
+minmax_element(ExPo &&policy, It first, It last, Cmp cmp)
 {
-    return ::pstld::search(
-        first1, last1, first2, last2, [](const auto &v1, const auto &v2) { return v1 == v2; });
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::minmax_element(first, last, cmp);
 }
 
-//--------------------------------------------------------------------------------------------------
-// search_n
-//--------------------------------------------------------------------------------------------------
+// 25.8.11 - lexicographical_compare ///////////////////////////////////////////////////////////////
 
-namespace internal {
+template <class ExPo, class It1, class It2>
+execution::enable_if_execution_policy<ExPo, bool>
+lexicographical_compare(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::lexicographical_compare(first1, last1, first2, last2);
+}
 
-template <class It, class T, class Pred>
-struct SearchN : Dispatchable<SearchN<It, T, Pred>> {
-    Partition<It> m_partition;
-    MinIteratorResult<It> m_result;
-    Pred m_pred;
-    const T &m_val;
-    size_t m_seq;
+template <class ExPo, class It1, class It2, class Cmp>
+execution::enable_if_execution_policy<ExPo, bool> lexicographical_compare(ExPo &&policy,
+                                                                          It1 first1,
+                                                                          It1 last1,
+                                                                          It2 first2,
+                                                                          It2 last2,
+                                                                          Cmp cmp) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::lexicographical_compare(first1, last1, first2, last2, cmp);
+}
 
-    SearchN(size_t count, size_t chunks, It first, It last, Pred pred, const T &val, size_t seq)
-        : m_partition(first, count, chunks), m_result{last}, m_pred(pred), m_val(val), m_seq(seq)
-    {
-    }
+// 25.10.4 - reduce ////////////////////////////////////////////////////////////////////////////////
 
-    void run(size_t ind) noexcept
-    {
-        if( ind < m_result.min_chunk ) {
-            for( auto p = m_partition.at(ind); p.first != p.last; ++p.first ) {
-                auto it = p.first;
-                for( size_t s = 0;; ++it, ++s ) {
-                    if( s == m_seq ) {
-                        m_result.put(ind, p.first);
-                        return;
-                    }
-                    if( !m_pred(*it, m_val) )
-                        break;
-                }
-            }
-        }
-    }
-};
+template <class ExPo, class It>
+execution::enable_if_execution_policy<ExPo, typename std::iterator_traits<It>::value_type>
+reduce(ExPo &&policy, It first, It last) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::reduce(first, last);
+}
 
-} // namespace internal
+template <class ExPo, class It, class T>
+execution::enable_if_execution_policy<ExPo, T>
+reduce(ExPo &&policy, It first, It last, T val) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::reduce(first, last, std::move(val));
+}
 
-template <class FwdIt, class Size, class T, class Pred>
-FwdIt search_n(FwdIt first, FwdIt last, Size count2, const T &value, Pred pred) noexcept
+template <class ExPo, class It, class T, class BinOp>
+execution::enable_if_execution_policy<ExPo, T>
+reduce(ExPo &&policy, It first, It last, T val, BinOp op) noexcept
 {
-    if( first == last )
-        return first;
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::reduce(first, last, std::move(val), op);
+}
 
-    if( count2 <= Size{} )
-        return first;
+// 25.10.6 - transform_reduce //////////////////////////////////////////////////////////////////////
 
-    const auto count1 = std::distance(first, last);
-    if( static_cast<Size>(count1) < count2 )
-        return last;
-    if( static_cast<Size>(count1) == count2 )
-        return std::all_of(first, last, [&](const auto &v) { return pred(v, value); }) ? first
-                                                                                       : last;
+template <class ExPo, class It1, class It2, class T>
+execution::enable_if_execution_policy<ExPo, T>
+transform_reduce(ExPo &&policy, It1 first1, It1 last1, It2 first2, T val) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::transform_reduce(first1, last1, first2, std::move(val));
+}
 
-    const auto count = count1 - count2 + 1;
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    try {
-        internal::SearchN<FwdIt, T, Pred> op{static_cast<size_t>(count),
-                                             chunks,
-                                             first,
-                                             last,
-                                             pred,
-                                             value,
-                                             static_cast<size_t>(count2)};
-        op.dispatch_apply(chunks);
-        return op.m_result.min;
-    } catch( const internal::parallelism_exception & ) {
-    }
-    return std::search_n(first, last, count2, value, pred);
+template <class ExPo, class It1, class It2, class T, class BinRedOp, class BinTrOp>
+execution::enable_if_execution_policy<ExPo, T> transform_reduce(ExPo &&policy,
+                                                                It1 first1,
+                                                                It1 last1,
+                                                                It2 first2,
+                                                                T val,
+                                                                BinRedOp redop,
+                                                                BinTrOp trop) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::transform_reduce(first1, last1, first2, std::move(val), redop, trop);
 }
 
-template <class FwdIt, class Size, class T>
-FwdIt search_n(FwdIt first, FwdIt last, Size count2, const T &value) noexcept
+template <class ExPo, class It, class T, class BinOp, class UnOp>
+execution::enable_if_execution_policy<ExPo, T>
+transform_reduce(ExPo &&policy, It first, It last, T val, BinOp bop, UnOp uop) noexcept
 {
-    return ::pstld::search_n(first, last, count2, value, std::equal_to<>{});
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::transform_reduce(first, last, std::move(val), bop, uop);
 }
 
-//--------------------------------------------------------------------------------------------------
-// find_end
-//--------------------------------------------------------------------------------------------------
+// 25.10.8 - exclusive_scan ////////////////////////////////////////////////////////////////////////
 
-namespace internal {
+template <class ExPo, class It1, class It2, class T>
+execution::enable_if_execution_policy<ExPo, It2>
+exclusive_scan(ExPo &&policy, It1 first1, It1 last1, It2 first2, T val) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::exclusive_scan(first1, last1, first2, std::move(val));
+}
 
-template <class It1, class It2, class Pred>
-struct FindEnd : Dispatchable<FindEnd<It1, It2, Pred>> {
-    Partition<It1> m_partition;
-    MaxIteratorResult<It1> m_result;
-    Pred m_pred;
-    It2 m_first2;
-    It2 m_last2;
+template <class ExPo, class It1, class It2, class T, class BinOp>
+execution::enable_if_execution_policy<ExPo, It2>
+exclusive_scan(ExPo &&policy, It1 first1, It1 last1, It2 first2, T val, BinOp bop) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::exclusive_scan(first1, last1, first2, std::move(val), bop);
+}
 
-    FindEnd(size_t count, size_t chunks, It1 first1, It1 last1, It2 first2, It2 last2, Pred pred)
-        : m_partition(first1, count, chunks), m_result{last1}, m_pred(pred), m_first2(first2),
-          m_last2(last2)
-    {
-    }
+// 25.10.9 - inclusive_scan ////////////////////////////////////////////////////////////////////////
 
-    void run(size_t ind) noexcept
-    {
-        if( static_cast<ptrdiff_t>(ind) < static_cast<ptrdiff_t>(m_result.max_chunk) )
-            return;
+template <class ExPo, class It1, class It2, class BinOp, class T>
+execution::enable_if_execution_policy<ExPo, It2>
+inclusive_scan(ExPo &&policy, It1 first1, It1 last1, It2 first2, BinOp bop, T val) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::inclusive_scan(first1, last1, first2, bop, std::move(val));
+}
 
-        auto p = m_partition.at(ind);
-        if constexpr( is_bidirectional_iterator_v<It1> ) {
-            do {
-                --p.last;
-                auto i1 = p.last;
-                auto i2 = m_first2;
-                for( ;; ++i1, ++i2 ) {
-                    if( i2 == m_last2 ) {
-                        m_result.put(ind, p.last);
-                        return;
-                    }
-                    if( !m_pred(*i1, *i2) )
-                        break;
-                }
-            } while( p.first != p.last );
-        }
-        else {
-            auto result = p.last;
-            for( ; p.first != p.last; ++p.first ) {
-                auto i1 = p.first;
-                auto i2 = m_first2;
-                for( ;; ++i1, ++i2 ) {
-                    if( i2 == m_last2 ) {
-                        result = p.first;
-                        break;
-                    }
-                    if( !m_pred(*i1, *i2) )
-                        break;
-                }
-            }
-            if( result != p.last )
-                m_result.put(ind, result);
-        }
-    }
-};
+template <class ExPo, class It1, class It2, class BinOp>
+execution::enable_if_execution_policy<ExPo, It2>
+inclusive_scan(ExPo &&policy, It1 first1, It1 last1, It2 first2, BinOp bop) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::inclusive_scan(first1, last1, first2, bop);
+}
 
-} // namespace internal
+template <class ExPo, class It1, class It2>
+execution::enable_if_execution_policy<ExPo, It2>
+inclusive_scan(ExPo &&policy, It1 first1, It1 last1, It2 first2) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::inclusive_scan(first1, last1, first2);
+}
 
-template <class FwdIt1, class FwdIt2, class Pred>
-FwdIt1 find_end(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2, Pred pred) noexcept
+// 25.10.10 - transform_exclusive_scan /////////////////////////////////////////////////////////////
+
+template <class ExPo, class It1, class It2, class T, class BinOp, class UnOp>
+execution::enable_if_execution_policy<ExPo, It2> transform_exclusive_scan(ExPo &&policy,
+                                                                          It1 first1,
+                                                                          It1 last1,
+                                                                          It2 first2,
+                                                                          T val,
+                                                                          BinOp bop,
+                                                                          UnOp uop) noexcept
 {
-    if( first1 == last1 )
-        return first1;
-    if( first2 == last2 )
-        return last1;
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::transform_exclusive_scan(first1, last1, first2, std::move(val), bop, uop);
+}
 
-    const auto count1 = std::distance(first1, last1);
-    const auto count2 = std::distance(first2, last2);
-    if( count1 < count2 )
-        return last1;
-    if( count1 == count2 )
-        return std::equal(first1, last1, first2, last2, pred) ? first1 : last1;
+// 25.10.11 - transform_inclusive_scan /////////////////////////////////////////////////////////////
 
-    const auto count = count1 - count2 + 1;
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    try {
-        internal::FindEnd<FwdIt1, FwdIt2, Pred> op{
-            static_cast<size_t>(count), chunks, first1, last1, first2, last2, pred};
-        op.dispatch_apply(chunks);
-        return op.m_result.max;
-    } catch( const internal::parallelism_exception & ) {
-    }
-    return std::find_end(first1, last1, first2, last2, pred);
+template <class ExPo, class It1, class It2, class BinOp, class UnOp, class T>
+execution::enable_if_execution_policy<ExPo, It2> transform_inclusive_scan(ExPo &&policy,
+                                                                          It1 first1,
+                                                                          It1 last1,
+                                                                          It2 first2,
+                                                                          BinOp bop,
+                                                                          UnOp uop,
+                                                                          T val) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::transform_inclusive_scan(first1, last1, first2, bop, uop, std::move(val));
+}
+
+template <class ExPo, class It1, class It2, class BinOp, class UnOp>
+execution::enable_if_execution_policy<ExPo, It2> transform_inclusive_scan(ExPo &&policy,
+                                                                          It1 first1,
+                                                                          It1 last1,
+                                                                          It2 first2,
+                                                                          BinOp bop,
+                                                                          UnOp uop) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::transform_inclusive_scan(first1, last1, first2, bop, uop);
 }
 
-template <class FwdIt1, class FwdIt2>
-FwdIt1 find_end(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2) noexcept
+// 25.10.12 - adjacent_difference //////////////////////////////////////////////////////////////////
+
+template <class ExPo, class It1, class It2>
+execution::enable_if_execution_policy<ExPo, It2>
+adjacent_difference(ExPo &&policy, It1 first1, It1 last1, It2 first2) noexcept
 {
-    return ::pstld::find_end(
-        first1, last1, first2, last2, [](const auto &v1, const auto &v2) { return v1 == v2; });
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::adjacent_difference(first1, last1, first2);
 }
 
-//--------------------------------------------------------------------------------------------------
-// is_sorted
-//--------------------------------------------------------------------------------------------------
-
-namespace internal {
+template <class ExPo, class It1, class It2, class BinOp>
+execution::enable_if_execution_policy<ExPo, It2>
+adjacent_difference(ExPo &&policy, It1 first1, It1 last1, It2 first2, BinOp op) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::adjacent_difference(first1, last1, first2, op);
+}
 
-template <class It, class Cmp>
-struct IsSorted : Dispatchable<IsSorted<It, Cmp>> {
-    Partition<It> m_partition;
-    Cmp m_cmp;
-    std::atomic_bool m_done{false};
-    bool m_result = true;
+// 25.11.3 - uninitialized_default_construct, uninitialized_default_construct_n ////////////////////
 
-    IsSorted(size_t count, size_t chunks, It first, Cmp cmp)
-        : m_partition(first, count, chunks), m_cmp(cmp)
-    {
-    }
+template <class ExPo, class It>
+execution::enable_if_execution_policy<ExPo, void>
+uninitialized_default_construct(ExPo &&policy, It first, It last) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    ::pstld::uninitialized_default_construct(first, last);
+}
 
-    void run(size_t ind) noexcept
-    {
-        if( m_done == false ) {
-            auto p = m_partition.at(ind);
-            for( auto it1 = p.first, it2 = p.first; it1 != p.last; it1 = it2 ) {
-                ++it2;
-                if( m_cmp(*it2, *it1) ) {
-                    m_done = true;
-                    m_result = false;
-                    return;
-                }
-            }
-        }
-    }
-};
+template <class ExPo, class It, class Size>
+execution::enable_if_execution_policy<ExPo, It>
+uninitialized_default_construct_n(ExPo &&policy, It first, Size count) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::uninitialized_default_construct_n(first, count);
+}
 
-} // namespace internal
+// 25.11.4 - uninitialized_value_construct, uninitialized_value_construct_n ////////////////////////
 
-template <class FwdIt, class Cmp>
-bool is_sorted(FwdIt first, FwdIt last, Cmp cmp)
+template <class ExPo, class It>
+execution::enable_if_execution_policy<ExPo, void>
+uninitialized_value_construct(ExPo &&policy, It first, It last) noexcept
 {
-    const auto count = std::distance(first, last);
-    if( count > 2 ) {
-        const auto chunks = internal::work_chunks_min_fraction_1(count - 1);
-        if( chunks > 1 ) {
-            try {
-                internal::IsSorted<FwdIt, Cmp> op{
-                    static_cast<size_t>(count - 1), chunks, first, cmp};
-                op.dispatch_apply(chunks);
-                return op.m_result;
-            } catch( const internal::parallelism_exception & ) {
-            }
-        }
-    }
-    return std::is_sorted(first, last, cmp);
+    internal::policy_scope_t<ExPo> scope{policy};
+    ::pstld::uninitialized_value_construct(first, last);
 }
 
-template <class FwdIt>
-bool is_sorted(FwdIt first, FwdIt last)
+template <class ExPo, class It, class Size>
+execution::enable_if_execution_policy<ExPo, It>
+uninitialized_value_construct_n(ExPo &&policy, It first, Size count) noexcept
 {
-    return ::pstld::is_sorted(first, last, std::less<>{});
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::uninitialized_value_construct_n(first, count);
 }
 
-//--------------------------------------------------------------------------------------------------
-// is_sorted_until
-//--------------------------------------------------------------------------------------------------
+// 25.11.5 - uninitialized_copy, uninitialized_copy_n //////////////////////////////////////////////
 
-namespace internal {
+template <class ExPo, class It1, class It2>
+execution::enable_if_execution_policy<ExPo, It2>
+uninitialized_copy(ExPo &&policy, It1 first, It1 last, It2 result) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::uninitialized_copy(first, last, result);
+}
 
-template <class It, class Cmp>
-struct IsSortedUntil : Dispatchable<IsSortedUntil<It, Cmp>> {
-    Partition<It> m_partition;
-    Cmp m_cmp;
-    MinIteratorResult<It> m_result;
+template <class ExPo, class It1, class Size, class It2>
+execution::enable_if_execution_policy<ExPo, It2>
+uninitialized_copy_n(ExPo &&policy, It1 first, Size count, It2 result) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::uninitialized_copy_n(first, count, result);
+}
 
-    IsSortedUntil(size_t count, size_t chunks, It first, It last, Cmp cmp)
-        : m_partition(first, count, chunks), m_cmp(cmp), m_result(last)
-    {
-    }
+// 25.11.6 - uninitialized_move, uninitialized_move_n //////////////////////////////////////////////
 
-    void run(size_t ind) noexcept
-    {
-        if( ind < m_result.min_chunk ) {
-            auto p = m_partition.at(ind);
-            for( auto it1 = p.first, it2 = p.first; it1 != p.last; it1 = it2 ) {
-                ++it2;
-                if( m_cmp(*it2, *it1) ) {
-                    m_result.put(ind, it2);
-                    return;
-                }
-            }
-        }
-    }
-};
+template <class ExPo, class It1, class It2>
+execution::enable_if_execution_policy<ExPo, It2>
+uninitialized_move(ExPo &&policy, It1 first, It1 last, It2 result) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::uninitialized_move(first, last, result);
+}
 
-} // namespace internal
+template <class ExPo, class It1, class Size, class It2>
+execution::enable_if_execution_policy<ExPo, std::pair<It1, It2>>
+uninitialized_move_n(ExPo &&policy, It1 first, Size count, It2 result) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::uninitialized_move_n(first, count, result);
+}
 
-template <class FwdIt, class Cmp>
-FwdIt is_sorted_until(FwdIt first, FwdIt last, Cmp cmp)
+// 25.11.7 - uninitialized_fill, uninitialized_fill_n //////////////////////////////////////////////
+
+template <class ExPo, class It, class T>
+execution::enable_if_execution_policy<ExPo, void>
+uninitialized_fill(ExPo &&policy, It first, It last, const T &value) noexcept
 {
-    const auto count = std::distance(first, last);
-    if( count > 2 ) {
-        const auto chunks = internal::work_chunks_min_fraction_1(count - 1);
-        if( chunks > 1 ) {
-            try {
-                internal::IsSortedUntil<FwdIt, Cmp> op{
-                    static_cast<size_t>(count - 1), chunks, first, last, cmp};
-                op.dispatch_apply(chunks);
-                return op.m_result.min;
-            } catch( const internal::parallelism_exception & ) {
-            }
-        }
-    }
-    return std::is_sorted_until(first, last, cmp);
+    internal::policy_scope_t<ExPo> scope{policy};
+    ::pstld::uninitialized_fill(first, last, value);
 }
 
-template <class FwdIt>
-FwdIt is_sorted_until(FwdIt first, FwdIt last)
+template <class ExPo, class It, class Size, class T>
+execution::enable_if_execution_policy<ExPo, It>
+uninitialized_fill_n(ExPo &&policy, It first, Size count, const T &value) noexcept
 {
-    return ::pstld::is_sorted_until(first, last, std::less<>{});
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::uninitialized_fill_n(first, count, value);
 }
 
-//--------------------------------------------------------------------------------------------------
-// is_partitioned
-//--------------------------------------------------------------------------------------------------
+// 25.11.9 - destroy, destroy_n ////////////////////////////////////////////////////////////////////
 
-namespace internal {
+template <class ExPo, class It>
+execution::enable_if_execution_policy<ExPo, void> destroy(ExPo &&policy, It first, It last) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    ::pstld::destroy(first, last);
+}
 
-template <class It, class Pred>
-struct IsPartitioned : Dispatchable<IsPartitioned<It, Pred>> {
-    enum Scan
-    {
-        broken,
-        all_true,
-        all_false,
-        true_false
-    };
+template <class ExPo, class It, class Size>
+execution::enable_if_execution_policy<ExPo, It>
+destroy_n(ExPo &&policy, It first, Size count) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::destroy_n(first, count);
+}
 
-    Partition<It> m_partition;
-    Pred m_pred;
-    std::atomic<size_t> m_right_true{0};
-    std::atomic<size_t> m_left_false{std::numeric_limits<size_t>::max() - 1};
+// bounded_count, bounded_count_if, bounded_find, bounded_find_if, bounded_reduce,
+// bounded_transform_reduce ////////////////////////////////////////////////////////////////////////
 
-    IsPartitioned(size_t count, size_t chunks, It first, Pred pred)
-        : m_partition(first, count, chunks), m_pred(pred)
-    {
-    }
+template <class ExPo, class It, class Pred>
+execution::enable_if_execution_policy<
+    ExPo,
+    bounded_result<typename std::iterator_traits<It>::difference_type>>
+bounded_count_if(ExPo &&policy,
+                 std::chrono::steady_clock::time_point deadline,
+                 It first,
+                 It last,
+                 Pred pred) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::bounded_count_if(deadline, first, last, pred);
+}
 
-    Scan scan(It first, It last) noexcept
-    {
-        if( m_pred(*first) ) {
-            while( true ) {
-                ++first;
-                if( first == last )
-                    return all_true;
-                if( !m_pred(*first) )
-                    break;
-            }
-            while( true ) {
-                ++first;
-                if( first == last )
-                    return true_false;
-                if( m_pred(*first) )
-                    return broken;
-            }
-        }
-        else {
-            while( true ) {
-                ++first;
-                if( first == last )
-                    return all_false;
-                if( m_pred(*first) )
-                    return broken;
-            }
-        }
-    }
+template <class ExPo, class It, class T>
+execution::enable_if_execution_policy<
+    ExPo,
+    bounded_result<typename std::iterator_traits<It>::difference_type>>
+bounded_count(ExPo &&policy,
+              std::chrono::steady_clock::time_point deadline,
+              It first,
+              It last,
+              const T &value) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::bounded_count(deadline, first, last, value);
+}
 
-    void run(size_t ind) noexcept
-    {
-        if( m_right_true.load() <= m_left_false.load() ) {
-            auto p = m_partition.at(ind);
-            auto s = scan(p.first, p.last);
-            if( s == all_true ) {
-                size_t was = m_right_true.load();
-                while( was < ind ) {
-                    if( m_right_true.compare_exchange_strong(was, ind) )
-                        break;
-                }
-            }
-            else if( s == all_false ) {
-                size_t was = m_left_false.load();
-                while( was > ind ) {
-                    if( m_left_false.compare_exchange_strong(was, ind) )
-                        break;
-                }
-            }
-            else if( s == true_false ) {
-                size_t was = m_right_true.load();
-                while( was < ind ) {
-                    if( m_right_true.compare_exchange_strong(was, ind) )
-                        break;
-                }
-                was = m_left_false.load();
-                while( was > ind ) {
-                    if( m_left_false.compare_exchange_strong(was, ind) )
-                        break;
-                }
-            }
-            else {
-                m_right_true.store(std::numeric_limits<size_t>::max());
-            }
-        }
-    }
-};
+template <class ExPo, class It, class Pred>
+execution::enable_if_execution_policy<ExPo, bounded_result<It>>
+bounded_find_if(ExPo &&policy,
+                std::chrono::steady_clock::time_point deadline,
+                It first,
+                It last,
+                Pred pred) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::bounded_find_if(deadline, first, last, pred);
+}
 
-} // namespace internal
+template <class ExPo, class It, class T>
+execution::enable_if_execution_policy<ExPo, bounded_result<It>>
+bounded_find(ExPo &&policy,
+             std::chrono::steady_clock::time_point deadline,
+             It first,
+             It last,
+             const T &value) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::bounded_find(deadline, first, last, value);
+}
 
-template <class FwdIt, class Pred>
-bool is_partitioned(FwdIt first, FwdIt last, Pred pred)
+template <class ExPo, class It, class T, class BinOp, class UnOp>
+execution::enable_if_execution_policy<ExPo, bounded_result<T>>
+bounded_transform_reduce(ExPo &&policy,
+                         std::chrono::steady_clock::time_point deadline,
+                         It first,
+                         It last,
+                         T val,
+                         BinOp bop,
+                         UnOp uop) noexcept
 {
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::IsPartitioned<FwdIt, Pred> op{
-                static_cast<size_t>(count), chunks, first, pred};
-            op.dispatch_apply(chunks);
-            return op.m_right_true.load() <= op.m_left_false.load();
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::is_partitioned(first, last, pred);
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::bounded_transform_reduce(deadline, first, last, std::move(val), bop, uop);
+}
+
+template <class ExPo, class It, class T, class BinOp>
+execution::enable_if_execution_policy<ExPo, bounded_result<T>>
+bounded_reduce(ExPo &&policy,
+               std::chrono::steady_clock::time_point deadline,
+               It first,
+               It last,
+               T val,
+               BinOp bop) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::bounded_reduce(deadline, first, last, std::move(val), bop);
+}
+
+template <class ExPo, class It, class T>
+execution::enable_if_execution_policy<ExPo, bounded_result<T>>
+bounded_reduce(ExPo &&policy,
+               std::chrono::steady_clock::time_point deadline,
+               It first,
+               It last,
+               T val) noexcept
+{
+    internal::policy_scope_t<ExPo> scope{policy};
+    return ::pstld::bounded_reduce(deadline, first, last, std::move(val));
 }
 
 //--------------------------------------------------------------------------------------------------
-// min_element
+//
+// Asynchronous algorithms
+//
 //--------------------------------------------------------------------------------------------------
 
 namespace internal {
 
-template <class It, class Cmp>
-struct MinElement : Dispatchable<MinElement<It, Cmp>> {
-    Partition<It> m_partition;
-    unitialized_array<It> m_results;
-    Cmp m_cmp;
+template <class T>
+struct AsyncResult {
+    std::optional<T> value;
 
-    MinElement(size_t count, size_t chunks, It first, Cmp cmp)
-        : m_partition(first, count, chunks), m_results(chunks), m_cmp(cmp)
+    template <class F>
+    void produce(F &f)
     {
+        value.emplace(f());
     }
 
-    void run(size_t ind) noexcept
+    T take() { return std::move(*value); }
+};
+
+template <>
+struct AsyncResult<void> {
+    template <class F>
+    void produce(F &f)
     {
-        auto p = m_partition.at(ind);
-        m_results.put(ind, std::min_element(p.first, p.last, m_cmp));
+        f();
     }
+
+    void take() noexcept {}
 };
 
-template <class It, class Cmp>
-iterator_value_t<It> min_iter_element(It first, It last, Cmp cmp)
+template <class T>
+class AsyncState
 {
-    auto smallest = *first;
-    ++first;
-    for( ; first != last; ++first ) {
-        if( cmp(*(*first), *smallest) ) {
-            smallest = *first;
-        }
+public:
+    virtual ~AsyncState() = default;
+
+    bool ready() const noexcept { return m_ready.load(std::memory_order_acquire); }
+
+    // Must be called before the state is destroyed even if it's ready - the backend may still be
+    // finishing the bookkeeping of the dispatched job.
+    void wait() noexcept { m_dg.wait(); }
+
+    T take() { return m_result.take(); }
+
+protected:
+    DispatchGroup m_dg;
+    std::atomic<bool> m_ready{false};
+    AsyncResult<T> m_result;
+};
+
+template <class T, class F>
+class AsyncTask final : public AsyncState<T>
+{
+public:
+    explicit AsyncTask(F &&f) : m_f(std::move(f)) {}
+
+    void start() noexcept { this->m_dg.dispatch(static_cast<void *>(this), run); }
+
+private:
+    static void run(void *ctx) noexcept
+    {
+        auto me = static_cast<AsyncTask *>(ctx);
+        me->m_result.produce(me->m_f);
+        me->m_ready.store(true, std::memory_order_release);
     }
-    return smallest;
-}
+
+    F m_f;
+};
+
+struct async_launch_t {
+};
 
 } // namespace internal
 
-template <class FwdIt, class Cmp>
-FwdIt min_element(FwdIt first, FwdIt last, Cmp cmp)
+namespace async {
+
+// The completion handle of an algorithm running asynchronously. The destructor waits for the
+// algorithm to complete, so the handle must not outlive the data the algorithm works on.
+template <class T>
+class handle
 {
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_2(count);
-    if( chunks > 1 ) {
-        try {
-            internal::MinElement<FwdIt, Cmp> op{static_cast<size_t>(count), chunks, first, cmp};
-            op.dispatch_apply(chunks);
-            return internal::min_iter_element(op.m_results.begin(), op.m_results.end(), cmp);
-        } catch( const internal::parallelism_exception & ) {
+public:
+    handle() noexcept = default;
+    handle(const handle &) = delete;
+    handle(handle &&rhs) noexcept
+        : m_state(std::exchange(rhs.m_state, nullptr)), m_inline(std::move(rhs.m_inline)),
+          m_valid(std::exchange(rhs.m_valid, false))
+    {
+    }
+    ~handle() { reset(); }
+
+    handle &operator=(const handle &) = delete;
+    handle &operator=(handle &&rhs) noexcept
+    {
+        if( this != &rhs ) {
+            reset();
+            m_state = std::exchange(rhs.m_state, nullptr);
+            m_inline = std::move(rhs.m_inline);
+            m_valid = std::exchange(rhs.m_valid, false);
         }
+        return *this;
     }
-    return std::min_element(first, last, cmp);
-}
 
-template <class FwdIt>
-FwdIt min_element(FwdIt first, FwdIt last)
-{
-    return ::pstld::min_element(first, last, std::less<>{});
-}
+    // Launches f() on the backend, used by the functions below.
+    template <class F>
+    handle(internal::async_launch_t, F f) noexcept;
 
-//--------------------------------------------------------------------------------------------------
-// max_element
-//--------------------------------------------------------------------------------------------------
+    // Whether the handle refers to an algorithm whose result wasn't taken yet.
+    bool valid() const noexcept { return m_valid; }
 
-namespace internal {
+    // Whether the algorithm has completed, never blocks.
+    bool ready() const noexcept { return m_valid && (m_state == nullptr || m_state->ready()); }
 
-template <class It, class Cmp>
-struct MaxElement : Dispatchable<MaxElement<It, Cmp>> {
-    Partition<It> m_partition;
-    unitialized_array<It> m_results;
-    Cmp m_cmp;
+    // Blocks until the algorithm has completed, the calling thread may execute other pending work
+    // of pstld meanwhile.
+    void wait() noexcept
+    {
+        if( m_state != nullptr )
+            m_state->wait();
+    }
 
-    MaxElement(size_t count, size_t chunks, It first, Cmp cmp)
-        : m_partition(first, count, chunks), m_results(chunks), m_cmp(cmp)
+    // Waits for the completion and returns the result of the algorithm, the handle becomes invalid.
+    T get() noexcept
     {
+        wait();
+        m_valid = false;
+        return m_state != nullptr ? m_state->take() : m_inline.take();
     }
 
-    void run(size_t ind) noexcept
+private:
+    void reset() noexcept
     {
-        auto p = m_partition.at(ind);
-        m_results.put(ind, std::max_element(p.first, p.last, m_cmp));
+        if( m_state != nullptr ) {
+            m_state->wait();
+            delete std::exchange(m_state, nullptr);
+        }
+        m_valid = false;
     }
+
+    internal::AsyncState<T> *m_state = nullptr;
+    internal::AsyncResult<T> m_inline; // the result when the launch fell back to the caller
+    bool m_valid = false;
 };
 
-template <class It, class Cmp>
-iterator_value_t<It> max_iter_element(It first, It last, Cmp cmp)
+template <class T>
+template <class F>
+handle<T>::handle(internal::async_launch_t, F f) noexcept : m_valid(true)
 {
-    auto biggest = *first;
-    ++first;
-    for( ; first != last; ++first ) {
-        if( cmp(*biggest, *(*first)) ) {
-            biggest = *first;
-        }
+    using Task = internal::AsyncTask<T, F>;
+    if( auto task = new(std::nothrow) Task(std::move(f)) ) {
+        m_state = task;
+        task->start();
     }
-    return biggest;
+    else {
+        // can't allocate the state - run synchronously instead
+        m_inline.produce(f);
+    }
+}
+
+} // namespace async
+
+namespace internal {
+
+template <class F>
+async::handle<std::invoke_result_t<const F &>> launch_async(F f) noexcept
+{
+    return {async_launch_t{}, std::move(f)};
 }
 
 } // namespace internal
 
-template <class FwdIt, class Cmp>
-FwdIt max_element(FwdIt first, FwdIt last, Cmp cmp)
+// Non-blocking counterparts of the algorithms: each takes the same arguments as the corresponding
+// function in pstld, including an optional leading execution policy, starts the algorithm on the
+// backend and immediately returns an async::handle of its result:
+//   auto sorting = pstld::async::sort(v.begin(), v.end());
+//   ... // do something else
+//   sorting.wait();
+// The arguments are copied, the ranges they refer to must stay alive until the handle is waited.
+namespace async {
+
+template <class... Args>
+auto all_of(Args... args) noexcept
 {
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_2(count);
-    if( chunks > 1 ) {
-        try {
-            internal::MaxElement<FwdIt, Cmp> op{static_cast<size_t>(count), chunks, first, cmp};
-            op.dispatch_apply(chunks);
-            return internal::max_iter_element(op.m_results.begin(), op.m_results.end(), cmp);
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::max_element(first, last, cmp);
+    return internal::launch_async([=] { return ::pstld::all_of(args...); });
 }
 
-template <class FwdIt>
-FwdIt max_element(FwdIt first, FwdIt last)
+template <class... Args>
+auto any_of(Args... args) noexcept
 {
-    return ::pstld::max_element(first, last, std::less<>{});
+    return internal::launch_async([=] { return ::pstld::any_of(args...); });
 }
 
-//--------------------------------------------------------------------------------------------------
-// minmax_element
-//--------------------------------------------------------------------------------------------------
+template <class... Args>
+auto none_of(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::none_of(args...); });
+}
 
-namespace internal {
+template <class... Args>
+auto for_each(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::for_each(args...); });
+}
 
-template <class It, class Cmp>
-struct MinMaxElement : Dispatchable<MinMaxElement<It, Cmp>> {
-    Partition<It> m_partition;
-    unitialized_array<std::pair<It, It>> m_results;
-    Cmp m_cmp;
+template <class... Args>
+auto for_each_n(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::for_each_n(args...); });
+}
 
-    MinMaxElement(size_t count, size_t chunks, It first, Cmp cmp)
-        : m_partition(first, count, chunks), m_results(chunks), m_cmp(cmp)
-    {
-    }
+template <class... Args>
+auto find(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::find(args...); });
+}
 
-    void run(size_t ind) noexcept
-    {
-        auto p = m_partition.at(ind);
-        m_results.put(ind, std::minmax_element(p.first, p.last, m_cmp));
-    }
-};
+template <class... Args>
+auto find_if(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::find_if(args...); });
+}
 
-template <class It, class Cmp>
-iterator_value_t<It> minmax_iter_element(It first, It last, Cmp cmp)
+template <class... Args>
+auto find_if_not(Args... args) noexcept
 {
-    auto smallest = (*first).first;
-    auto biggest = (*first).second;
-    ++first;
-    for( ; first != last; ++first ) {
-        if( cmp(*((*first).first), *smallest) )
-            smallest = (*first).first;
-        if( !cmp(*((*first).second), *biggest) )
-            biggest = (*first).second;
-    }
-    return {smallest, biggest};
+    return internal::launch_async([=] { return ::pstld::find_if_not(args...); });
 }
 
-} // namespace internal
+template <class... Args>
+auto find_end(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::find_end(args...); });
+}
 
-template <class FwdIt, class Cmp>
-std::pair<FwdIt, FwdIt> minmax_element(FwdIt first, FwdIt last, Cmp cmp)
+template <class... Args>
+auto find_first_of(Args... args) noexcept
 {
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_2(count);
-    if( chunks > 1 ) {
-        try {
-            internal::MinMaxElement<FwdIt, Cmp> op{static_cast<size_t>(count), chunks, first, cmp};
-            op.dispatch_apply(chunks);
-            return internal::minmax_iter_element(op.m_results.begin(), op.m_results.end(), cmp);
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::minmax_element(first, last, cmp);
+    return internal::launch_async([=] { return ::pstld::find_first_of(args...); });
 }
 
-template <class FwdIt>
-std::pair<FwdIt, FwdIt> minmax_element(FwdIt first, FwdIt last)
+template <class... Args>
+auto adjacent_find(Args... args) noexcept
 {
-    return ::pstld::minmax_element(first, last, std::less<>{});
+    return internal::launch_async([=] { return ::pstld::adjacent_find(args...); });
 }
 
-//--------------------------------------------------------------------------------------------------
-// transform
-//--------------------------------------------------------------------------------------------------
+template <class... Args>
+auto count(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::count(args...); });
+}
 
-namespace internal {
+template <class... Args>
+auto count_if(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::count_if(args...); });
+}
 
-template <class It1, class It2, class UnOp>
-struct Transform2 : Dispatchable<Transform2<It1, It2, UnOp>> {
-    Partition<It1> m_partition1;
-    Partition<It2> m_partition2;
-    UnOp m_op;
+template <class... Args>
+auto mismatch(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::mismatch(args...); });
+}
 
-    Transform2(size_t count, size_t chunks, It1 first1, It2 first2, UnOp op)
-        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks), m_op(op)
-    {
-    }
+template <class... Args>
+auto equal(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::equal(args...); });
+}
 
-    void run(size_t ind) noexcept
-    {
-        auto p = m_partition1.at(ind);
-        std::transform(p.first, p.last, m_partition2.at(ind).first, m_op);
-    }
-};
+template <class... Args>
+auto search(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::search(args...); });
+}
 
-template <class It1, class It2, class It3, class BinOp>
-struct Transform3 : Dispatchable<Transform3<It1, It2, It3, BinOp>> {
-    Partition<It1> m_partition1;
-    Partition<It2> m_partition2;
-    Partition<It3> m_partition3;
-    BinOp m_op;
+template <class... Args>
+auto search_n(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::search_n(args...); });
+}
+
+template <class... Args>
+auto copy(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::copy(args...); });
+}
+
+template <class... Args>
+auto copy_n(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::copy_n(args...); });
+}
+
+template <class... Args>
+auto copy_if(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::copy_if(args...); });
+}
+
+template <class... Args>
+auto move(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::move(args...); });
+}
+
+template <class... Args>
+auto swap_ranges(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::swap_ranges(args...); });
+}
+
+template <class... Args>
+auto transform(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::transform(args...); });
+}
+
+template <class... Args>
+auto replace(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::replace(args...); });
+}
+
+template <class... Args>
+auto replace_if(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::replace_if(args...); });
+}
+
+template <class... Args>
+auto fill(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::fill(args...); });
+}
 
-    Transform3(size_t count, size_t chunks, It1 first1, It2 first2, It3 first3, BinOp op)
-        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks),
-          m_partition3(first3, count, chunks), m_op(op)
-    {
-    }
+template <class... Args>
+auto fill_n(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::fill_n(args...); });
+}
 
-    void run(size_t ind) noexcept
-    {
-        auto p = m_partition1.at(ind);
-        std::transform(
-            p.first, p.last, m_partition2.at(ind).first, m_partition3.at(ind).first, m_op);
-    }
-};
+template <class... Args>
+auto generate(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::generate(args...); });
+}
 
-} // namespace internal
-template <class FwdIt1, class FwdIt2, class UnOp>
-FwdIt2 transform(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, UnOp transform_op) noexcept
+template <class... Args>
+auto generate_n(Args... args) noexcept
 {
-    const auto count = std::distance(first1, last1);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Transform2<FwdIt1, FwdIt2, UnOp> op{
-                static_cast<size_t>(count), chunks, first1, first2, transform_op};
-            op.dispatch_apply(chunks);
-            return op.m_partition2.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::transform(first1, last1, first2, transform_op);
+    return internal::launch_async([=] { return ::pstld::generate_n(args...); });
 }
 
-template <class FwdIt1, class FwdIt2, class FwdIt3, class BinOp>
-FwdIt3
-transform(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt3 first3, BinOp transform_op) noexcept
+template <class... Args>
+auto reverse(Args... args) noexcept
 {
-    const auto count = std::distance(first1, last1);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Transform3<FwdIt1, FwdIt2, FwdIt3, BinOp> op{
-                static_cast<size_t>(count), chunks, first1, first2, first3, transform_op};
-            op.dispatch_apply(chunks);
-            return op.m_partition3.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::transform(first1, last1, first2, first3, transform_op);
+    return internal::launch_async([=] { return ::pstld::reverse(args...); });
 }
 
-//--------------------------------------------------------------------------------------------------
-// equal
-//--------------------------------------------------------------------------------------------------
+template <class... Args>
+auto sort(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::sort(args...); });
+}
 
-namespace internal {
+template <class... Args>
+auto stable_sort(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::stable_sort(args...); });
+}
 
-template <class It1, class It2, class Cmp>
-struct Equal : Dispatchable<Equal<It1, It2, Cmp>> {
-    Partition<It1> m_partition1;
-    Partition<It2> m_partition2;
-    Cmp m_cmp;
-    std::atomic_bool m_done{false};
-    bool m_result = true;
+template <class... Args>
+auto is_sorted(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::is_sorted(args...); });
+}
 
-    Equal(size_t count, size_t chunks, It1 first1, It2 first2, Cmp cmp)
-        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks), m_cmp(cmp)
-    {
-    }
+template <class... Args>
+auto is_sorted_until(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::is_sorted_until(args...); });
+}
 
-    void run(size_t ind) noexcept
-    {
-        if( m_done )
-            return;
-        auto p1 = m_partition1.at(ind);
-        auto p2 = m_partition2.at(ind);
-        if( !std::equal(p1.first, p1.last, p2.first, m_cmp) ) {
-            m_done = true;
-            m_result = false;
-        }
-    }
-};
+template <class... Args>
+auto is_partitioned(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::is_partitioned(args...); });
+}
 
-} // namespace internal
+template <class... Args>
+auto merge(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::merge(args...); });
+}
 
-template <class FwdIt1, class FwdIt2, class Cmp>
-bool equal(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, Cmp cmp) noexcept
+template <class... Args>
+auto min_element(Args... args) noexcept
 {
-    const auto count = std::distance(first1, last1);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Equal<FwdIt1, FwdIt2, Cmp> op{
-                static_cast<size_t>(count), chunks, first1, first2, cmp};
-            op.dispatch_apply(chunks);
-            return op.m_result;
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::equal(first1, last1, first2, cmp);
+    return internal::launch_async([=] { return ::pstld::min_element(args...); });
 }
 
-template <class FwdIt1, class FwdIt2>
-bool equal(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+template <class... Args>
+auto max_element(Args... args) noexcept
 {
-    return ::pstld::equal(first1, last1, first2, std::equal_to<>{});
+    return internal::launch_async([=] { return ::pstld::max_element(args...); });
 }
 
-template <class FwdIt1, class FwdIt2, class Cmp>
-bool equal(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2, Cmp cmp) noexcept
+template <class... Args>
+auto minmax_element(Args... args) noexcept
 {
-    const auto count = std::distance(first1, last1);
-    if( count != std::distance(first2, last2) )
-        return false;
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Equal<FwdIt1, FwdIt2, Cmp> op{
-                static_cast<size_t>(count), chunks, first1, first2, cmp};
-            op.dispatch_apply(chunks);
-            return op.m_result;
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::equal(first1, last1, first2, cmp);
+    return internal::launch_async([=] { return ::pstld::minmax_element(args...); });
 }
 
-template <class FwdIt1, class FwdIt2>
-bool equal(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2) noexcept
+template <class... Args>
+auto lexicographical_compare(Args... args) noexcept
 {
-    return ::pstld::equal(first1, last1, first2, last2, std::equal_to<>{});
+    return internal::launch_async([=] { return ::pstld::lexicographical_compare(args...); });
 }
 
-//--------------------------------------------------------------------------------------------------
-// mismatch
-//--------------------------------------------------------------------------------------------------
+template <class... Args>
+auto reduce(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::reduce(args...); });
+}
 
-namespace internal {
+template <class... Args>
+auto transform_reduce(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::transform_reduce(args...); });
+}
 
-template <class It1, class It2, class Cmp>
-struct Mismatch : Dispatchable<Mismatch<It1, It2, Cmp>> {
-    Partition<It1> m_partition1;
-    Partition<It2> m_partition2;
-    Cmp m_cmp;
-    MinIteratorResult<It1> m_result1;
-    MinIteratorResult<It2> m_result2;
+template <class... Args>
+auto exclusive_scan(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::exclusive_scan(args...); });
+}
 
-    Mismatch(size_t count, size_t chunks, It1 first1, It2 first2, Cmp cmp)
-        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks), m_cmp(cmp),
-          m_result1(m_partition1.end()), m_result2(m_partition2.end())
-    {
-    }
+template <class... Args>
+auto inclusive_scan(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::inclusive_scan(args...); });
+}
 
-    void run(size_t ind) noexcept
-    {
-        if( ind < m_result1.min_chunk ) {
-            auto p1 = m_partition1.at(ind);
-            auto p2 = m_partition2.at(ind);
-            for( ; p1.first != p1.last; ++p1.first, ++p2.first )
-                if( !m_cmp(*p1.first, *p2.first) ) {
-                    m_result1.put(ind, p1.first);
-                    m_result2.put(ind, p2.first);
-                    return;
-                }
-        }
-    }
-};
+template <class... Args>
+auto transform_exclusive_scan(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::transform_exclusive_scan(args...); });
+}
 
-} // namespace internal
+template <class... Args>
+auto transform_inclusive_scan(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::transform_inclusive_scan(args...); });
+}
 
-template <class FwdIt1, class FwdIt2, class Cmp>
-std::pair<FwdIt1, FwdIt2> mismatch(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, Cmp cmp) noexcept
+template <class... Args>
+auto adjacent_difference(Args... args) noexcept
 {
-    const auto count = std::distance(first1, last1);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Mismatch<FwdIt1, FwdIt2, Cmp> op{
-                static_cast<size_t>(count), chunks, first1, first2, cmp};
-            op.dispatch_apply(chunks);
-            return {op.m_result1.min, op.m_result2.min};
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::mismatch(first1, last1, first2, cmp);
+    return internal::launch_async([=] { return ::pstld::adjacent_difference(args...); });
 }
 
-template <class FwdIt1, class FwdIt2>
-std::pair<FwdIt1, FwdIt2> mismatch(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+template <class... Args>
+auto uninitialized_default_construct(Args... args) noexcept
 {
-    return ::pstld::mismatch(first1, last1, first2, std::equal_to<>{});
+    return internal::launch_async(
+        [=] { return ::pstld::uninitialized_default_construct(args...); });
 }
 
-template <class FwdIt1, class FwdIt2, class Cmp>
-std::pair<FwdIt1, FwdIt2>
-mismatch(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2, Cmp cmp) noexcept
+template <class... Args>
+auto uninitialized_default_construct_n(Args... args) noexcept
 {
-    const auto count = std::min(std::distance(first1, last1), std::distance(first2, last2));
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Mismatch<FwdIt1, FwdIt2, Cmp> op{
-                static_cast<size_t>(count), chunks, first1, first2, cmp};
-            op.dispatch_apply(chunks);
-            return {op.m_result1.min, op.m_result2.min};
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::mismatch(first1, last1, first2, last2, cmp);
+    return internal::launch_async(
+        [=] { return ::pstld::uninitialized_default_construct_n(args...); });
 }
 
-template <class FwdIt1, class FwdIt2>
-std::pair<FwdIt1, FwdIt2>
-mismatch(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2) noexcept
+template <class... Args>
+auto uninitialized_value_construct(Args... args) noexcept
 {
-    return ::pstld::mismatch(first1, last1, first2, last2, std::equal_to<>{});
+    return internal::launch_async([=] { return ::pstld::uninitialized_value_construct(args...); });
 }
 
-//--------------------------------------------------------------------------------------------------
-// sort
-//--------------------------------------------------------------------------------------------------
+template <class... Args>
+auto uninitialized_value_construct_n(Args... args) noexcept
+{
+    return internal::launch_async(
+        [=] { return ::pstld::uninitialized_value_construct_n(args...); });
+}
 
-namespace internal {
+template <class... Args>
+auto uninitialized_copy(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::uninitialized_copy(args...); });
+}
 
-template <class It, class Pred>
-void insertion_sort(It first, It last, Pred pred)
+template <class... Args>
+auto uninitialized_copy_n(Args... args) noexcept
 {
-    if( first == last )
-        return;
-    auto it = first;
-    ++it;
-    for( ; it != last; ++it ) {
-        auto hole = it;
-        iterator_value_t<It> v = std::move(*hole);
-        if( pred(v, *first) ) {
-            while( true ) {
-                *hole = std::move(*(hole - 1));
-                --hole;
-                if( hole == first )
-                    break;
-            }
-            *first = std::move(v);
-        }
-        else {
-            auto prev = std::prev(it);
-            while( true ) {
-                if( !pred(v, *prev) )
-                    break;
-                *hole = std::move(*prev);
-                hole = prev;
-                --prev;
-            }
-            *hole = std::move(v);
-        }
-    }
+    return internal::launch_async([=] { return ::pstld::uninitialized_copy_n(args...); });
 }
 
-template <class It, class Pred>
-void median_3(It it1, It it2, It it3, Pred pred)
+template <class... Args>
+auto uninitialized_move(Args... args) noexcept
 {
-    // orders elements at i1, it2, i3 by pred
-    if( pred(*it2, *it1) )
-        std::iter_swap(it1, it2);
-    if( pred(*it3, *it2) ) {
-        std::iter_swap(it2, it3);
-        if( pred(*it2, *it1) )
-            std::iter_swap(it1, it2);
-    }
+    return internal::launch_async([=] { return ::pstld::uninitialized_move(args...); });
+}
+
+template <class... Args>
+auto uninitialized_move_n(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::uninitialized_move_n(args...); });
+}
+
+template <class... Args>
+auto uninitialized_fill(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::uninitialized_fill(args...); });
 }
 
-template <class It, class Pred>
-void guess_median(It it1, It mid, It it2, Pred pred)
+template <class... Args>
+auto uninitialized_fill_n(Args... args) noexcept
 {
-    const auto size = it2 - it1;
-    if( size > 40 ) {
-        const auto _1_8 = size / 8;
-        const auto _1_4 = size / 4;
-        median_3(it1, it1 + _1_8, it1 + _1_4, pred);
-        median_3(mid - _1_8, mid, mid + _1_8, pred);
-        median_3(it2 - _1_4, it2 - _1_8, it2, pred);
-        median_3(it1 + _1_8, mid, it2 - _1_8, pred);
-    }
-    else {
-        median_3(it1, mid, it2, pred);
-    }
+    return internal::launch_async([=] { return ::pstld::uninitialized_fill_n(args...); });
 }
 
-template <class It, class Pred>
-std::pair<It, It> partition(It first, It last, Pred pred)
+template <class... Args>
+auto destroy(Args... args) noexcept
 {
-    auto mid = first + (last - first) / 2;
-    guess_median(first, mid, std::prev(last), pred);
+    return internal::launch_async([=] { return ::pstld::destroy(args...); });
+}
 
-    auto pfirst = mid;
-    auto plast = std::next(mid);
+template <class... Args>
+auto destroy_n(Args... args) noexcept
+{
+    return internal::launch_async([=] { return ::pstld::destroy_n(args...); });
+}
 
-    while( first < pfirst && !pred(*(pfirst - 1), *pfirst) && !pred(*pfirst, *(pfirst - 1)) )
-        --pfirst;
+} // namespace async
 
-    while( plast < last && !pred(*plast, *pfirst) && !pred(*pfirst, *plast) )
-        ++plast;
+//--------------------------------------------------------------------------------------------------
+//
+// Senders
+//
+//--------------------------------------------------------------------------------------------------
 
-    auto gtfirst = plast;
-    auto lslast = pfirst;
+// A minimal sender/receiver model in the spirit of P2300, self-contained so that it doesn't depend
+// on any particular implementation of std::execution:
+// - a sender describes work completing with the values listed in its 'value_types' tuple;
+// - a receiver is any object with a 'set_value(values...)' member function;
+// - 'sender.connect(receiver)' returns an operation state, which is neither copyable nor movable
+//   and must stay alive from its 'start()' until the receiver has been completed.
+// The algorithms are noexcept, so there are no error or stopped completions. Continuations run on
+// the thread which completed the previous stage, no thread has to wake up in between.
 
-    while( true ) {
-        for( ; gtfirst < last; ++gtfirst ) {
-            if( pred(*pfirst, *gtfirst) )
-                continue;
-            if( pred(*gtfirst, *pfirst) )
-                break;
-            if( plast != gtfirst )
-                std::iter_swap(plast, gtfirst);
-            ++plast;
-        }
-        for( ; first < lslast; --lslast ) {
-            if( pred(*(lslast - 1), *pfirst) )
-                continue;
-            if( pred(*pfirst, *(lslast - 1)) )
-                break;
-            if( --pfirst != lslast - 1 )
-                std::iter_swap(pfirst, lslast - 1);
-        }
-        if( lslast == first && gtfirst == last )
-            return {pfirst, plast};
-        if( lslast == first ) {
-            if( plast != gtfirst )
-                std::iter_swap(pfirst, plast);
-            ++plast;
-            std::iter_swap(pfirst, gtfirst);
-            ++pfirst;
-            ++gtfirst;
-        }
-        else if( gtfirst == last ) {
-            if( --lslast != --pfirst )
-                std::iter_swap(lslast, pfirst);
-            std::iter_swap(pfirst, --plast);
-        }
-        else {
-            std::iter_swap(gtfirst, --lslast);
-            ++gtfirst;
-        }
-    }
-}
+namespace senders {
 
-inline constexpr size_t log2(size_t n) noexcept
+template <class S>
+using value_types_of_t = typename std::decay_t<S>::value_types;
+
+} // namespace senders
+
+// Schedules work on the same backend as the parallel algorithms, or on the default executor if
+// one is installed.
+class scheduler
 {
-    size_t log2n = 0;
-    while( n > 1 ) {
-        log2n++;
-        n >>= 1;
-    }
-    return log2n;
-}
+public:
+    class sender
+    {
+    public:
+        using value_types = std::tuple<>;
 
-template <class It, class Cmp>
-struct Sort {
-    struct Work {
-        size_t first;
-        size_t last;
-        size_t depth;
+        template <class R>
+        class operation
+        {
+        public:
+            explicit operation(R r) : m_receiver(std::move(r)) {}
+            operation(const operation &) = delete;
+            operation &operator=(const operation &) = delete;
+
+            void start() noexcept { internal::dispatch_async(static_cast<void *>(this), run); }
+
+        private:
+            static void run(void *ctx) noexcept
+            {
+                static_cast<operation *>(ctx)->m_receiver.set_value();
+            }
+
+            R m_receiver;
+        };
+
+        template <class R>
+        operation<R> connect(R r) const
+        {
+            return operation<R>{std::move(r)};
+        }
     };
 
-    It m_first;
-    It m_last;
-    size_t m_size;
-    Cmp m_cmp;
-    DispatchGroup m_dg;
-    size_t m_workers{max_hw_threads()};
-    std::atomic<size_t> m_next_worker_index{1};
-    parallelism_vector<CircularWorkStealingDeque<Work>> m_queues{m_workers};
-    parallelism_vector<WorkCounter> m_work_counters{m_workers};
+    sender schedule() const noexcept { return {}; }
+
+    friend bool operator==(scheduler, scheduler) noexcept { return true; }
+    friend bool operator!=(scheduler, scheduler) noexcept { return false; }
+};
+
+namespace internal {
+
+template <class T>
+struct values_of {
+    using type = std::tuple<T>;
+};
+
+template <>
+struct values_of<void> {
+    using type = std::tuple<>;
+};
+
+template <class F, class Values>
+struct then_values;
+
+template <class F, class... Vs>
+struct then_values<F, std::tuple<Vs...>> {
+    using type = typename values_of<std::invoke_result_t<F &, Vs...>>::type;
+};
 
-    Sort(It first, It last, Cmp cmp)
-        : m_first(first), m_last(last), m_size(last - first), m_cmp(cmp)
+template <class R, class... Vs>
+class JustOperation
+{
+public:
+    JustOperation(const std::tuple<Vs...> &values, R r) : m_values(values), m_receiver(std::move(r))
     {
     }
+    JustOperation(const JustOperation &) = delete;
+    JustOperation &operator=(const JustOperation &) = delete;
 
     void start() noexcept
     {
-        m_queues[0].push_bottom(Work{0, m_size, 2 * log2(m_size)});
-        for( size_t i = 1; i != m_workers; ++i )
-            m_dg.dispatch(static_cast<void *>(this), dispatch);
-        dispatch_worker(0);
-        m_dg.wait();
+        std::apply([this](Vs &...vs) { m_receiver.set_value(std::move(vs)...); }, m_values);
     }
 
-    void dispatch_worker(size_t worker_index) noexcept
+private:
+    std::tuple<Vs...> m_values;
+    R m_receiver;
+};
+
+template <class F, class R>
+struct ThenReceiver {
+    F f;
+    R r;
+
+    template <class... Vs>
+    void set_value(Vs &&...vs) noexcept
     {
-        Work w;
-        while( true ) {
-            if( m_queues[worker_index].pop_bottom(w) ) {
-                // have a local work to do
-                do_sort(w, worker_index);
-                continue;
-            }
+        if constexpr( std::is_void_v<std::invoke_result_t<F &, Vs...>> ) {
+            f(std::forward<Vs>(vs)...);
+            r.set_value();
+        }
+        else {
+            r.set_value(f(std::forward<Vs>(vs)...));
+        }
+    }
+};
 
-            for( size_t i = 1; i != m_workers; ++i ) {
-                size_t steal_index = (i + worker_index) % m_workers;
-                if( m_queues[steal_index].steal_top(w) ) {
-                    // stolen from an other queue
-                    do_sort(w, worker_index);
-                    continue;
-                }
-            }
+template <class F, class R>
+struct BulkReceiver {
+    size_t n;
+    F f;
+    R r;
 
-            // nothing to do - perhaps we are done?
-            if( is_done() )
-                break;
+    template <class... Vs>
+    void set_value(Vs &&...vs) noexcept
+    {
+        auto call = [&](size_t ind) { f(ind, vs...); };
+        using Call = decltype(call);
+        dispatch_apply(n, static_cast<void *>(&call), [](void *ctx, size_t ind) noexcept {
+            (*static_cast<Call *>(ctx))(ind);
+        });
+        r.set_value(std::forward<Vs>(vs)...);
+    }
+};
 
-            // give up execution
-            std::this_thread::yield();
-        }
+template <class Op, size_t I>
+struct WhenAllReceiver {
+    Op *op;
+
+    template <class... Vs>
+    void set_value(Vs &&...vs) noexcept
+    {
+        op->template complete<I>(std::forward<Vs>(vs)...);
     }
+};
 
-    void do_sort(const Work w, size_t worker_index) noexcept
+template <class Op, size_t I, class S>
+struct WhenAllChild {
+    using operation_t =
+        decltype(std::declval<const S &>().connect(std::declval<WhenAllReceiver<Op, I>>()));
+
+    WhenAllChild(const S &s, Op *op) : operation(s.connect(WhenAllReceiver<Op, I>{op})) {}
+
+    operation_t operation;
+};
+
+template <class R, class Indices, class... S>
+class WhenAllOperation;
+
+template <class R, size_t... I, class... S>
+class WhenAllOperation<R, std::index_sequence<I...>, S...>
+    : WhenAllChild<WhenAllOperation<R, std::index_sequence<I...>, S...>, I, S>...
+{
+public:
+    WhenAllOperation(const std::tuple<S...> &senders, R r)
+        : WhenAllChild<WhenAllOperation, I, S>(std::get<I>(senders), this)...,
+          m_receiver(std::move(r))
     {
-        auto first = m_first + w.first;
-        auto last = m_first + w.last;
-        auto depth = w.depth;
-        while( first != last ) {
-            const auto len = last - first;
-            if( static_cast<size_t>(len) <= insertion_sort_limit ) {
-                // small len - do an insertion sort
-                insertion_sort(first, last, m_cmp);
-                m_work_counters[worker_index].commit_relaxed(len);
-                break;
-            }
-            else if( depth == 0 ) {
-                std::make_heap(first, last, m_cmp);
-                std::sort_heap(first, last, m_cmp);
-                m_work_counters[worker_index].commit_relaxed(len);
-                break;
-            }
-            else {
-                // regular len - do a quicksort
-                --depth;
-                auto p = internal::partition(first, last, m_cmp);
-                const auto left_len = p.second - first;
-                const auto mid_len = p.second - p.first;
-                const auto right_len = last - p.second;
-                m_work_counters[worker_index].commit_relaxed(mid_len);
-                if( right_len != 0 ) {
-                    if( left_len != 0 ) {
-                        // fork the right unsorted side
-                        fork(worker_index,
-                             static_cast<size_t>(std::distance(m_first, p.second)),
-                             static_cast<size_t>(std::distance(m_first, last)),
-                             depth);
+    }
+    WhenAllOperation(const WhenAllOperation &) = delete;
+    WhenAllOperation &operator=(const WhenAllOperation &) = delete;
 
-                        // process locally the left unsorted side
-                        last = p.first;
-                    }
-                    else {
-                        // nothing to do on the left - process the right side locally
-                        first = p.second;
-                    }
-                }
-                else {
-                    // nothing to do on the right - process the left side locally
-                    last = p.first;
-                }
-            }
-        }
+    void start() noexcept { (WhenAllChild<WhenAllOperation, I, S>::operation.start(), ...); }
+
+    template <size_t J, class... Vs>
+    void complete(Vs &&...vs) noexcept
+    {
+        std::get<J>(m_values).emplace(std::forward<Vs>(vs)...);
+        if( m_remaining.fetch_sub(1, std::memory_order_acq_rel) != 1 )
+            return;
+        auto values = std::tuple_cat(std::move(*std::get<I>(m_values))...);
+        std::apply([this](auto &...vs) { m_receiver.set_value(std::move(vs)...); }, values);
     }
 
-    void fork(size_t worker_index, size_t first, size_t last, size_t depth) noexcept
+private:
+    R m_receiver;
+    std::tuple<std::optional<senders::value_types_of_t<S>>...> m_values;
+    std::atomic<size_t> m_remaining{sizeof...(S)};
+};
+
+template <class Values>
+struct SyncWaitState {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::optional<Values> values;
+};
+
+template <class Values>
+struct SyncWaitReceiver {
+    SyncWaitState<Values> *state;
+
+    template <class... Vs>
+    void set_value(Vs &&...vs) noexcept
     {
-        try {
-            m_queues[worker_index].push_bottom(Work{first, last, depth});
-        } catch( const parallelism_exception & ) {
-            ::std::sort(m_first + first, m_first + last, m_cmp);
-            m_work_counters[worker_index].commit_relaxed(last - first);
-        }
+        // notified under the lock, the waiter destroys the state as soon as it sees the values
+        std::lock_guard lock{state->mutex};
+        state->values.emplace(std::forward<Vs>(vs)...);
+        state->cv.notify_one();
     }
+};
 
-    bool is_done() noexcept
+} // namespace internal
+
+namespace senders {
+
+// Completes inline with the given values.
+template <class... Vs>
+class just_sender
+{
+public:
+    using value_types = std::tuple<Vs...>;
+
+    explicit just_sender(std::tuple<Vs...> values) : m_values(std::move(values)) {}
+
+    template <class R>
+    internal::JustOperation<R, Vs...> connect(R r) const
     {
-        size_t done = 0;
-        for( size_t i = 0; i != m_workers; ++i )
-            done += m_work_counters[i].load_relaxed();
-        return done == m_size;
+        return {m_values, std::move(r)};
+    }
+
+private:
+    std::tuple<Vs...> m_values;
+};
+
+template <class... Vs>
+just_sender<std::decay_t<Vs>...> just(Vs &&...vs)
+{
+    return just_sender<std::decay_t<Vs>...>{std::make_tuple(std::forward<Vs>(vs)...)};
+}
+
+// Completes with the result of f(values...) invoked on the values of the predecessor.
+template <class S, class F>
+class then_sender
+{
+public:
+    using value_types = typename internal::then_values<F, value_types_of_t<S>>::type;
+
+    then_sender(S s, F f) : m_sender(std::move(s)), m_f(std::move(f)) {}
+
+    template <class R>
+    auto connect(R r) const
+    {
+        return m_sender.connect(internal::ThenReceiver<F, R>{m_f, std::move(r)});
     }
 
-    static void dispatch(void *ctx) noexcept
+private:
+    S m_sender;
+    F m_f;
+};
+
+template <class S, class F>
+then_sender<S, F> then(S s, F f)
+{
+    return {std::move(s), std::move(f)};
+}
+
+// Invokes f(i, values...) for every i in [0, n) via the backend's parallel loop and then completes
+// with the predecessor's values.
+template <class S, class F>
+class bulk_sender
+{
+public:
+    using value_types = value_types_of_t<S>;
+
+    bulk_sender(S s, size_t n, F f) : m_sender(std::move(s)), m_n(n), m_f(std::move(f)) {}
+
+    template <class R>
+    auto connect(R r) const
     {
-        auto me = static_cast<Sort *>(ctx);
-        size_t index = me->m_next_worker_index++;
-        me->dispatch_worker(index);
+        return m_sender.connect(internal::BulkReceiver<F, R>{m_n, m_f, std::move(r)});
     }
-};
 
-} // namespace internal
+private:
+    S m_sender;
+    size_t m_n;
+    F m_f;
+};
 
-template <class RanIt, class Cmp>
-void sort(RanIt first, RanIt last, Cmp cmp) noexcept
+template <class S, class F>
+bulk_sender<S, F> bulk(S s, size_t n, F f)
 {
-    const auto count = std::distance(first, last);
-    if( static_cast<size_t>(count) > internal::insertion_sort_limit ) {
-        try {
-            internal::Sort<RanIt, Cmp> sort(first, last, cmp);
-            sort.start();
-            return;
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    std::sort(first, last, cmp);
+    return {std::move(s), n, std::move(f)};
 }
 
-template <class RanIt>
-void sort(RanIt first, RanIt last) noexcept
+// Starts all senders at once and completes with their values concatenated once the last one has
+// completed.
+template <class... S>
+class when_all_sender
 {
-    return ::pstld::sort(first, last, std::less<>{});
-}
+public:
+    using value_types = decltype(std::tuple_cat(std::declval<value_types_of_t<S>>()...));
 
-//--------------------------------------------------------------------------------------------------
-// stable_sort
-//--------------------------------------------------------------------------------------------------
+    explicit when_all_sender(S... s) : m_senders(std::move(s)...) {}
 
-namespace internal {
+    template <class R>
+    internal::WhenAllOperation<R, std::index_sequence_for<S...>, S...> connect(R r) const
+    {
+        return {m_senders, std::move(r)};
+    }
 
-inline size_t stable_sort_tree_height(size_t elems) noexcept
-{
-    size_t chunks_elems = elems / insertion_sort_limit;
-    size_t log2_elems = log2(chunks_elems);
+private:
+    std::tuple<S...> m_senders;
+};
 
-    size_t chunks_oversubscr = max_hw_threads() * chunks_per_cpu;
-    size_t log2_oversubscr = log2(chunks_oversubscr);
+template <class... S>
+when_all_sender<S...> when_all(S... s)
+{
+    return when_all_sender<S...>{std::move(s)...};
+}
 
-    return std::min(log2_elems, log2_oversubscr) & ~size_t(1);
+// Starts the sender and blocks the calling thread until it completes. Must not be called from
+// within a sender chain running on the backend.
+template <class S>
+std::optional<value_types_of_t<S>> sync_wait(const S &s) noexcept
+{
+    using Values = value_types_of_t<S>;
+    internal::SyncWaitState<Values> state;
+    auto operation = s.connect(internal::SyncWaitReceiver<Values>{&state});
+    operation.start();
+    std::unique_lock lock{state.mutex};
+    state.cv.wait(lock, [&] { return state.values.has_value(); });
+    return std::move(state.values);
 }
 
-template <class It1, class It2, class Cmp>
-void merge_mid_move(It1 first, It1 mid, It1 last, It2 out, Cmp cmp)
+// Sender versions of the algorithms: each runs the algorithm with the given arguments once the
+// predecessor has completed, discarding its values, and completes with the algorithm's result:
+//   auto sorted = pstld::senders::sort(pstld::scheduler{}.schedule(), v.begin(), v.end());
+//   auto sum = pstld::senders::reduce(sorted, v.begin(), v.end(), 0.);
+//   auto [value] = pstld::senders::sync_wait(sum).value();
+template <class S, class... Args>
+auto for_each(S s, Args... args) noexcept
 {
-    // TODO: should it move-construct in-place instead of moving into?
-    auto first1 = first;
-    auto first2 = mid;
-    for( ; first1 != mid; ++out ) {
-        if( first2 == last ) {
-            std::move(first1, mid, out);
-            return;
-        }
-        if( cmp(*first2, *first1) ) {
-            *out = std::move(*first2);
-            ++first2;
-        }
-        else {
-            *out = std::move(*first1);
-            ++first1;
-        }
-    }
-    std::move(first2, last, out);
+    return then(std::move(s), [=](auto &&...) { return ::pstld::for_each(args...); });
 }
 
-template <class It, class Cmp>
-void insertion_sort_buf_assign_move(It first, It last, Cmp cmp, iterator_value_t<It> *buf)
+template <class S, class... Args>
+auto transform(S s, Args... args) noexcept
 {
-    if( first == last )
-        return;
+    return then(std::move(s), [=](auto &&...) { return ::pstld::transform(args...); });
+}
 
-    auto last2 = buf;
-    *(last2++) = std::move(*first);
+template <class S, class... Args>
+auto reduce(S s, Args... args) noexcept
+{
+    return then(std::move(s), [=](auto &&...) { return ::pstld::reduce(args...); });
+}
 
-    for( ; ++first != last; ++last2 ) {
-        auto j2 = last2;
-        auto i2 = j2;
-        if( cmp(*first, *--i2) ) {
-            *j2 = std::move(*i2);
-            for( --j2; i2 != buf && cmp(*first, *--i2); --j2 )
-                *j2 = std::move(*i2);
-            *j2 = std::move(*first);
-        }
-        else {
-            *j2 = std::move(*first);
-        }
-    }
+template <class S, class... Args>
+auto transform_reduce(S s, Args... args) noexcept
+{
+    return then(std::move(s), [=](auto &&...) { return ::pstld::transform_reduce(args...); });
 }
 
-template <class It, class Cmp>
-void stable_sort(It first, It last, Cmp cmp, iterator_value_t<It> *buf);
+template <class S, class... Args>
+auto sort(S s, Args... args) noexcept
+{
+    return then(std::move(s), [=](auto &&...) { return ::pstld::sort(args...); });
+}
 
-template <class It, class Cmp>
-void stable_sort_buf_assign_move(It first, It last, Cmp cmp, iterator_value_t<It> *buf)
+template <class S, class... Args>
+auto stable_sort(S s, Args... args) noexcept
 {
-    size_t len = last - first;
-    if( len == 0 ) {
-    }
-    else if( len == 1 ) {
-        *buf = std::move(*first);
-    }
-    else if( len == 2 ) {
-        auto second = first;
-        ++second;
-        if( cmp(*second, *first) ) {
-            *(buf++) = std::move(*second);
-            *buf = std::move(*first);
-        }
-        else {
-            *(buf++) = std::move(*first);
-            *buf = std::move(*second);
-        }
-    }
-    else if( len <= insertion_sort_limit ) {
-        insertion_sort_buf_assign_move(first, last, cmp, buf);
-    }
-    else {
-        size_t half = len / 2;
-        It mid = first + half;
-        stable_sort(first, mid, cmp, buf);
-        stable_sort(mid, last, cmp, buf + half);
-        merge_mid_move(first, mid, last, buf, cmp);
-    }
+    return then(std::move(s), [=](auto &&...) { return ::pstld::stable_sort(args...); });
 }
 
-template <class It, class Cmp>
-void stable_sort(It first, It last, Cmp cmp, iterator_value_t<It> *buf)
+template <class S, class... Args>
+auto inclusive_scan(S s, Args... args) noexcept
 {
-    size_t len = last - first;
-    if( len <= insertion_sort_limit ) {
-        insertion_sort(first, last, cmp);
-    }
-    else {
-        size_t half = len / 2;
-        It mid = first + half;
-        stable_sort_buf_assign_move(first, mid, cmp, buf);
-        stable_sort_buf_assign_move(mid, last, cmp, buf + half);
-        merge_mid_move(buf, buf + half, buf + len, first, cmp);
-    }
+    return then(std::move(s), [=](auto &&...) { return ::pstld::inclusive_scan(args...); });
 }
 
-template <class It, class Cmp>
-struct StableSort {
-    struct Work {
-        size_t first;
-        size_t last;
-        size_t depth;
-    };
+template <class S, class... Args>
+auto exclusive_scan(S s, Args... args) noexcept
+{
+    return then(std::move(s), [=](auto &&...) { return ::pstld::exclusive_scan(args...); });
+}
 
-    It m_first;
-    It m_last;
-    Cmp m_cmp;
-    size_t m_size;
-    size_t m_height;
-    size_t m_chunks;
-    size_t m_workers{max_hw_threads()};
-    std::atomic<size_t> m_next_chunk{0};
+} // namespace senders
 
-    Partition<It> m_partition;
-    parallelism_vector<iterator_value_t<It>> m_buf; // TODO: should be raw temp memory instead?
-    parallelism_vector<std::atomic<bool>> m_flags;
+#if defined(PSTLD_INTERNAL_ARC)
+} // inline namespace arc
+#endif
 
-    DispatchGroup m_dg;
+} // namespace pstld
 
-    StableSort(It first, It last, Cmp cmp)
-        : m_first(first), m_last(last), m_cmp(cmp), m_size(last - first),
-          m_height(stable_sort_tree_height(m_size)), m_chunks(size_t(1) << m_height),
-          m_partition(first, m_size, m_chunks), m_buf(m_size), m_flags(size_t(1) << m_height)
-    {
-    }
+//--------------------------------------------------------------------------------------------------
+//
+// System-specific implementation details
+//
+//--------------------------------------------------------------------------------------------------
 
-    void start() noexcept
-    {
-        for( size_t i = 1; i != m_workers; ++i )
-            m_dg.dispatch(static_cast<void *>(this), dispatch);
-        dispatch_worker();
-        m_dg.wait();
-    }
+#if defined(PSTLD_INTERNAL_HEADER_ONLY) || defined(PSTLD_INTERNAL_IMPLEMENTATION_FILE)
 
-    static void dispatch(void *ctx) noexcept
-    {
-        auto me = static_cast<StableSort *>(ctx);
-        me->dispatch_worker();
-    }
+    #if defined(PSTLD_INTERNAL_BACKEND_DISPATCH)
+        #include <dispatch/dispatch.h>
+    #else
+        #include <deque>
+    #endif
 
-    void dispatch_worker() noexcept
-    {
-        while( true ) {
-            size_t chunk = m_next_chunk.fetch_add(1);
-            if( chunk >= m_chunks )
-                break;
-            bottomup(chunk);
-        }
-    }
+    #if defined(__APPLE__)
+        #include <pthread.h>
+        #include <sys/types.h>
+        #include <sys/sysctl.h>
+        #include <sys/mman.h>
+    #elif defined(__linux__)
+        #include <sched.h>
+        #include <unistd.h>
+        #include <sys/mman.h>
+        #include <sys/resource.h>
+        #include <sys/syscall.h>
+        #include <cerrno>
+        #include <cmath>
+        #include <string>
+    #endif
 
-    void bottomup(size_t ind) noexcept
-    {
-        auto p = m_partition.at(ind);
+    #include <cstdio>
+    #include <cstdlib>
 
-        stable_sort(p.first, p.last, m_cmp, m_buf.data() + std::distance(m_first, p.first));
-        std::atomic<bool> *flag_ptr = m_flags.data();
-        if( !flag_ptr[ind / 2].exchange(true) ) // try to give up merging
-            return;
+namespace pstld {
 
-        auto buf = m_buf.data();
-        for( size_t lvl = 1, chunks = m_chunks / 2;; ++lvl, chunks >>= 1 ) {
-            bool odd = ind & 1;
-            ind >>= 1;
+    #if defined(PSTLD_INTERNAL_ARC)
+inline namespace arc {
+    #endif
 
-            auto first = odd ? m_partition.at(ind << lvl).first : p.first;
-            auto mid = odd ? p.first : p.last;
-            auto last = odd ? p.last : m_partition.at(((ind + 1) << lvl) - 1).last;
+namespace internal {
 
-            if( lvl % 2 ) {
-                // merge into tmp buf
-                merge_mid_move(first, mid, last, buf + (first - m_first), m_cmp);
-            }
-            else {
-                // merge back into orig buffer
-                merge_mid_move(buf + (first - m_first),
-                               buf + (mid - m_first),
-                               buf + (last - m_first),
-                               first,
-                               m_cmp);
-            }
+    #if defined(PSTLD_INTERNAL_BACKEND_DISPATCH)
 
-            flag_ptr += chunks;
-            if( !flag_ptr[ind / 2].exchange(true) ) // try to give up merging
-                return;
+PSTLD_INTERNAL_IMPL qos_class_t qos_class(execution::priority priority) noexcept
+{
+    switch( priority ) {
+        case execution::priority::background:
+            return QOS_CLASS_BACKGROUND;
+        case execution::priority::utility:
+            return QOS_CLASS_UTILITY;
+        case execution::priority::user_initiated:
+            return QOS_CLASS_USER_INITIATED;
+        case execution::priority::user_interactive:
+            return QOS_CLASS_USER_INTERACTIVE;
+        default:
+            return QOS_CLASS_DEFAULT;
+    }
+}
 
-            p.first = first;
-            p.last = last;
-        }
+PSTLD_INTERNAL_IMPL void
+backend_dispatch_apply(size_t iterations, void *ctx, void (*function)(void *, size_t)) noexcept
+{
+        #pragma clang diagnostic push
+        #pragma clang diagnostic ignored "-Wnullability-extension"
+    if( const execution::priority priority = current_priority();
+        priority != execution::priority::normal ) {
+        const auto queue = dispatch_get_global_queue(qos_class(priority), 0);
+        ::dispatch_apply_f(iterations, queue, ctx, function);
+        return;
     }
-};
+        #if DISPATCH_APPLY_AUTO_AVAILABLE
+        ::dispatch_apply_f(iterations, DISPATCH_APPLY_AUTO, ctx, function);
+        #else
+        ::dispatch_apply_f(iterations, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ctx, function);
+        #endif
+        #pragma clang diagnostic pop
+}
 
-} // namespace internal
+PSTLD_INTERNAL_IMPL void backend_dispatch_async(void *ctx, void (*function)(void *)) noexcept
+{
+    ::dispatch_async_f(dispatch_get_global_queue(qos_class(current_priority()), 0), ctx, function);
+}
 
-template <class RanIt, class Cmp>
-void stable_sort(RanIt first, RanIt last, Cmp cmp) noexcept
+PSTLD_INTERNAL_IMPL DispatchGroup::DispatchGroup() noexcept
+    : m_executor(current_executor()), m_priority(current_priority()),
+      m_group(m_executor == nullptr ? dispatch_group_create() : nullptr),
+      m_queue(dispatch_get_global_queue(qos_class(m_priority), 0))
 {
-    const auto count = std::distance(first, last);
-    if( static_cast<size_t>(count) > internal::insertion_sort_limit * 4 ) {
-        try {
-            internal::StableSort<RanIt, Cmp> op(first, last, cmp);
-            op.start();
-            return;
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    std::stable_sort(first, last, cmp);
 }
 
-template <class RanIt>
-void stable_sort(RanIt first, RanIt last) noexcept
+PSTLD_INTERNAL_IMPL DispatchGroup::~DispatchGroup()
 {
-    return ::pstld::stable_sort(first, last, std::less<>{});
+        #if !defined(PSTLD_INTERNAL_ARC)
+    if( m_group != nullptr )
+        ::dispatch_release(static_cast<dispatch_group_t>(m_group));
+        #endif
 }
 
-//--------------------------------------------------------------------------------------------------
-// merge
-//--------------------------------------------------------------------------------------------------
+PSTLD_INTERNAL_IMPL void DispatchGroup::dispatch(void *ctx, void (*function)(void *)) noexcept
+{
+    if( m_executor != nullptr )
+        return dispatch_executor(ctx, function);
+
+    ::dispatch_group_async_f(static_cast<dispatch_group_t>(m_group),
+                             static_cast<dispatch_queue_t>(m_queue),
+                             ctx,
+                             function);
+}
+
+PSTLD_INTERNAL_IMPL void DispatchGroup::wait() noexcept
+{
+    if( m_executor != nullptr )
+        return wait_executor();
 
-namespace internal {
+    ::dispatch_group_wait(static_cast<dispatch_group_t>(m_group), DISPATCH_TIME_FOREVER);
+}
 
-template <class It1, class It2, class It3, class Cmp>
-struct Merge {
-    struct Work {
-        size_t first1;
-        size_t last1;
-        size_t first2;
-        size_t last2;
-        size_t first3;
+    #else // defined(PSTLD_INTERNAL_BACKEND_DISPATCH)
+
+// Lowers the scheduling priority of the calling thread according to the priority class of its pool.
+// The classes above normal share the workers of the normal pool, since raising the priority would
+// require privileges anyway.
+PSTLD_INTERNAL_IMPL void set_worker_priority(execution::priority priority) noexcept
+{
+        #if defined(__APPLE__)
+    switch( priority ) {
+        case execution::priority::background:
+            pthread_set_qos_class_self_np(QOS_CLASS_BACKGROUND, 0);
+            break;
+        case execution::priority::utility:
+            pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+            break;
+        default:
+            break;
+    }
+        #elif defined(__linux__)
+    const int niceness = priority == execution::priority::background ? 10
+                         : priority == execution::priority::utility  ? 5
+                                                                     : 0;
+    if( niceness != 0 ) {
+        // on Linux the niceness is a per-thread attribute
+        const auto tid = static_cast<id_t>(::syscall(SYS_gettid));
+        errno = 0;
+        const int current = ::getpriority(PRIO_PROCESS, tid);
+        if( errno == 0 )
+            ::setpriority(PRIO_PROCESS, tid, current + niceness);
+    }
+        #else
+    (void)priority;
+        #endif
+}
+
+// A persistent pool of std::thread workers. Each worker owns a work-stealing deque, tasks submitted
+// from outside of the pool go into a shared injection queue. Threads that wait for their tasks to
+// complete keep executing pending tasks meanwhile, so nested parallel calls can't starve the pool.
+// The background and utility classes have pools of their own with lowered scheduling priority, the
+// other classes share one pool where each class gets its own injection queue and the more urgent
+// queues are drained first. The pools are created on first use.
+class ThreadPool
+{
+public:
+    struct Task {
+        void (*function)(void *);
+        void *ctx;
+        std::atomic<size_t> *pending; // decremented after the task is executed, can be nullptr
     };
 
-    It1 m_first1;
-    It1 m_last1;
-    size_t m_size1;
-    It2 m_first2;
-    It2 m_last2;
-    size_t m_size2;
-    It3 m_first3;
-    It3 m_last3;
-    size_t m_size3; // = m_size1 + m_size2
-    Cmp m_cmp;
-    DispatchGroup m_dg;
-    size_t m_workers{max_hw_threads()};
-    std::atomic<size_t> m_next_worker_index{1};
-    parallelism_vector<CircularWorkStealingDeque<Work>> m_queues{m_workers};
-    parallelism_vector<WorkCounter> m_work_counters{m_workers};
+    static constexpr size_t no_worker = std::numeric_limits<size_t>::max();
+    static constexpr size_t spins_before_sleep = 64;
 
-    Merge(It1 first1, It1 last1, It2 first2, It2 last2, It3 first3, Cmp cmp)
-        : m_first1(first1), m_last1(last1), m_size1(last1 - first1), m_first2(first2),
-          m_last2(last2), m_size2(last2 - first2), m_first3(first3),
-          m_last3(std::next(first3, m_size1 + m_size2)), m_size3(m_size1 + m_size2), m_cmp(cmp)
+    static ThreadPool &instance(execution::priority priority) noexcept
     {
+        switch( priority ) {
+            case execution::priority::background:
+                return tier<execution::priority::background>();
+            case execution::priority::utility:
+                return tier<execution::priority::utility>();
+            default:
+                return tier<execution::priority::normal>();
+        }
     }
 
-    void start() noexcept
+    size_t concurrency() const noexcept { return m_workers + 1; }
+
+    void submit(Task task, execution::priority priority) noexcept
     {
-        m_queues[0].push_bottom(Work{0, m_size1, 0, m_size2, 0});
-        for( size_t i = 1; i != m_workers; ++i )
-            m_dg.dispatch(static_cast<void *>(this), dispatch);
-        dispatch_worker(0);
-        m_dg.wait();
+        if( task.pending != nullptr )
+            task.pending->fetch_add(1);
+
+        try {
+            if( const size_t index = worker_index(); index != no_worker ) {
+                m_queues[index].push_bottom(task);
+            }
+            else {
+                std::lock_guard lock{m_injected_mut};
+                m_injected[size_t(priority)].push_back(task);
+                m_injected_size.fetch_add(1);
+            }
+        } catch( const parallelism_exception & ) {
+            execute(task);
+            return;
+        }
+
+        m_epoch.fetch_add(1);
+        wake_up(false);
     }
 
-    void dispatch_worker(size_t worker_index) noexcept
+    void wait(std::atomic<size_t> &pending) noexcept
     {
-        Work w;
-        while( true ) {
-            if( m_queues[worker_index].pop_bottom(w) ) {
-                // have a local work to do
-                do_merge(w, worker_index);
+        const size_t index = worker_index();
+        size_t idle = 0;
+        while( pending.load() != 0 ) {
+            const size_t epoch = m_epoch.load();
+            Task task;
+            if( acquire(index, task) ) {
+                execute(task);
+                idle = 0;
                 continue;
             }
 
-            for( size_t i = 1; i != m_workers; ++i ) {
-                size_t steal_index = (i + worker_index) % m_workers;
-                if( m_queues[steal_index].steal_top(w) ) {
-                    // stolen from an other queue
-                    do_merge(w, worker_index);
-                    continue;
-                }
+            if( ++idle < spins_before_sleep ) {
+                count_yield();
+                std::this_thread::yield();
+                continue;
             }
 
-            // nothing to do - perhaps we are done?
-            if( is_done() )
-                break;
-
-            // give up execution
-            std::this_thread::yield();
+            idle = 0;
+            sleep([&] { return pending.load() == 0 || m_epoch.load() != epoch; });
         }
     }
 
-    void do_merge(const Work w, size_t worker_index) noexcept
-    {
-        size_t first1 = w.first1;
-        size_t last1 = w.last1;
-        size_t first2 = w.first2;
-        size_t last2 = w.last2;
-        size_t first3 = w.first3;
-
-        while( (last1 - first1) + (last2 - first2) > merge_parallel_limit ) {
-            // chop the input in roughly halves while it's big enough
-            size_t mid1;
-            size_t mid2;
-            if( last1 - first1 < last2 - first2 ) {
-                mid2 = first2 + (last2 - first2) / 2;
-                mid1 = std::distance(
-                    m_first1,
-                    std::lower_bound(
-                        m_first1 + first1, m_first1 + last1, *(m_first2 + mid2), m_cmp));
-            }
-            else {
-                mid1 = first1 + (last1 - first1) / 2;
-                mid2 = std::distance(
-                    m_first2,
-                    std::lower_bound(
-                        m_first2 + first2, m_first2 + last2, *(m_first1 + mid1), m_cmp));
-            }
+private:
+    static constexpr size_t priorities = size_t(execution::priority::user_interactive) + 1;
 
-            fork(
-                worker_index, mid1, last1, mid2, last2, first3 + (mid1 - first1) + (mid2 - first2));
-            last1 = mid1;
-            last2 = mid2;
-        }
+    // The pool the current thread works for, if any, and its index there.
+    struct Identity {
+        const ThreadPool *pool = nullptr;
+        size_t index = no_worker;
+    };
 
-        std::merge(m_first1 + first1,
-                   m_first1 + last1,
-                   m_first2 + first2,
-                   m_first2 + last2,
-                   m_first3 + first3,
-                   m_cmp);
-        m_work_counters[worker_index].commit_relaxed((last1 - first1) + (last2 - first2));
+    template <execution::priority Priority>
+    static ThreadPool &tier() noexcept
+    {
+        // intentionally leaked - the workers must outlive any static destructor calling pstld
+        static ThreadPool *const pool = new ThreadPool(Priority);
+        return *pool;
     }
 
-    void fork(size_t worker_index,
-              size_t first1,
-              size_t last1,
-              size_t first2,
-              size_t last2,
-              size_t first3) noexcept
+    explicit ThreadPool(execution::priority priority)
+        : m_workers(std::max(max_hw_threads(), size_t(2)) - 1), m_queues(m_workers)
     {
-        try {
-            m_queues[worker_index].push_bottom(Work{first1, last1, first2, last2, first3});
-        } catch( const parallelism_exception & ) {
-            std::merge(m_first1 + first1,
-                       m_first1 + last1,
-                       m_first2 + first2,
-                       m_first2 + last2,
-                       m_first3 + first3,
-                       m_cmp);
-            m_work_counters[worker_index].commit_relaxed((last1 - first1) + (last2 - first2));
-        }
+        for( size_t i = 0; i != m_workers; ++i )
+            std::thread([this, i, priority] {
+                set_worker_priority(priority);
+                run_worker(i);
+            }).detach();
     }
 
-    bool is_done() noexcept
+    static Identity &identity() noexcept
     {
-        size_t done = 0;
-        for( size_t i = 0; i != m_workers; ++i )
-            done += m_work_counters[i].load_relaxed();
-        return done == m_size3;
+        static thread_local Identity identity;
+        return identity;
     }
 
-    static void dispatch(void *ctx) noexcept
+    size_t worker_index() const noexcept
     {
-        auto me = static_cast<Merge *>(ctx);
-        size_t index = me->m_next_worker_index++;
-        me->dispatch_worker(index);
+        const Identity &me = identity();
+        return me.pool == this ? me.index : no_worker;
     }
-};
 
-} // namespace internal
+    void run_worker(size_t index) noexcept
+    {
+        identity() = {this, index};
+        size_t idle = 0;
+        while( true ) {
+            const size_t epoch = m_epoch.load();
+            Task task;
+            if( acquire(index, task) ) {
+                execute(task);
+                idle = 0;
+                continue;
+            }
 
-template <class FwdIt1, class FwdIt2, class FwdIt3, class Cmp>
-FwdIt3
-merge(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2, FwdIt3 first3, Cmp cmp) noexcept
-{
-    if constexpr( internal::is_random_iterator_v<FwdIt1> &&
-                  internal::is_random_iterator_v<FwdIt2> &&
-                  internal::is_random_iterator_v<FwdIt3> ) {
-        const auto count = std::distance(first1, last1) + std::distance(first2, last2);
-        if( static_cast<size_t>(count) > internal::merge_parallel_limit ) {
-            try {
-                internal::Merge<FwdIt1, FwdIt2, FwdIt3, Cmp> merge(
-                    first1, last1, first2, last2, first3, cmp);
-                merge.start();
-                return merge.m_last3;
-            } catch( const internal::parallelism_exception & ) {
+            if( ++idle < spins_before_sleep ) {
+                count_yield();
+                std::this_thread::yield();
+                continue;
             }
+
+            idle = 0;
+            sleep([&] { return m_epoch.load() != epoch; });
         }
     }
-    return std::merge(first1, last1, first2, last2, first3, cmp);
-}
 
-template <class FwdIt1, class FwdIt2, class FwdIt3>
-FwdIt3 merge(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2, FwdIt3 first3) noexcept
-{
-    return ::pstld::merge(first1, last1, first2, last2, first3, std::less<>{});
-}
+    bool acquire(size_t index, Task &task) noexcept
+    {
+        if( index != no_worker && m_queues[index].pop_bottom(task) )
+            return true;
 
-//--------------------------------------------------------------------------------------------------
-// fill, fill_n
-//--------------------------------------------------------------------------------------------------
+        if( m_injected_size.load() != 0 ) {
+            std::lock_guard lock{m_injected_mut};
+            for( size_t i = priorities; i-- != 0; )
+                if( !m_injected[i].empty() ) {
+                    task = m_injected[i].front();
+                    m_injected[i].pop_front();
+                    m_injected_size.fetch_sub(1);
+                    return true;
+                }
+        }
 
-namespace internal {
+        const size_t start = index == no_worker ? 0 : index + 1;
+        for( size_t i = 0; i != m_workers; ++i ) {
+            const bool stolen = m_queues[(start + i) % m_workers].steal_top(task);
+            count_steal(stolen);
+            if( stolen )
+                return true;
+        }
 
-template <class It, class T>
-struct Fill : Dispatchable<Fill<It, T>> {
-    Partition<It> m_partition;
-    const T &m_val;
+        return false;
+    }
 
-    Fill(size_t count, size_t chunks, It first, const T &val)
-        : m_partition(first, count, chunks), m_val(val)
+    void execute(const Task &task) noexcept
     {
+        task.function(task.ctx);
+        if( task.pending != nullptr && task.pending->fetch_sub(1) == 1 )
+            wake_up(true);
     }
 
-    void run(size_t ind) noexcept
+    template <class Pred>
+    void sleep(Pred pred) noexcept
     {
-        auto p = m_partition.at(ind);
-        std::fill(p.first, p.last, m_val);
+        m_sleepers.fetch_add(1);
+        {
+            std::unique_lock lock{m_sleep_mut};
+            m_sleep_cv.wait(lock, pred);
+        }
+        m_sleepers.fetch_sub(1);
     }
+
+    void wake_up(bool all) noexcept
+    {
+        // pairs with the increment of m_sleepers in sleep(), both are sequentially consistent
+        if( m_sleepers.load() == 0 )
+            return;
+        {
+            std::lock_guard lock{m_sleep_mut};
+        }
+        if( all )
+            m_sleep_cv.notify_all();
+        else
+            m_sleep_cv.notify_one();
+    }
+
+    const size_t m_workers;
+    parallelism_vector<CircularWorkStealingDeque<Task>> m_queues;
+    std::deque<Task, parallelism_allocator<Task>> m_injected[priorities]; // indexed by priority
+    std::atomic<size_t> m_injected_size{0}; // allows to skip locking when nothing was injected
+    std::mutex m_injected_mut;
+    std::atomic<size_t> m_epoch{0};
+    std::atomic<size_t> m_sleepers{0};
+    std::mutex m_sleep_mut;
+    std::condition_variable m_sleep_cv;
 };
 
-} // namespace internal
+PSTLD_INTERNAL_IMPL void
+backend_dispatch_apply(size_t iterations, void *ctx, void (*function)(void *, size_t)) noexcept
+{
+    struct Apply {
+        void *ctx;
+        void (*function)(void *, size_t);
+        size_t iterations;
+        std::atomic<size_t> next{0};
+
+        static void run(void *me_ptr) noexcept
+        {
+            auto me = static_cast<Apply *>(me_ptr);
+            for( size_t ind = me->next++; ind < me->iterations; ind = me->next++ )
+                me->function(me->ctx, ind);
+        }
+    };
 
-template <class FwdIt, class T>
-void fill(FwdIt first, FwdIt last, const T &val) noexcept
+    if( iterations == 0 )
+        return;
+
+    const execution::priority priority = current_priority();
+    auto &pool = ThreadPool::instance(priority);
+    Apply apply{ctx, function, iterations};
+    std::atomic<size_t> pending{0};
+    const size_t helpers = std::min({iterations, pool.concurrency(), max_hw_threads()}) - 1;
+    for( size_t i = 0; i != helpers; ++i )
+        pool.submit({Apply::run, &apply, &pending}, priority);
+    Apply::run(&apply);
+    pool.wait(pending);
+}
+
+PSTLD_INTERNAL_IMPL void backend_dispatch_async(void *ctx, void (*function)(void *)) noexcept
 {
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Fill<FwdIt, T> op{static_cast<size_t>(count), chunks, first, val};
-            op.dispatch_apply(chunks);
-            return;
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::fill(first, last, val);
+    const execution::priority priority = current_priority();
+    ThreadPool::instance(priority).submit({function, ctx, nullptr}, priority);
 }
 
-template <class FwdIt, class Size, class T>
-FwdIt fill_n(FwdIt first, Size count, const T &val) noexcept
+PSTLD_INTERNAL_IMPL DispatchGroup::DispatchGroup() noexcept
+    : m_executor(current_executor()), m_priority(current_priority())
 {
-    if( count < 1 )
-        return first;
+}
 
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Fill<FwdIt, T> op{static_cast<size_t>(count), chunks, first, val};
-            op.dispatch_apply(chunks);
-            return op.m_partition.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::fill_n(first, count, val);
+PSTLD_INTERNAL_IMPL DispatchGroup::~DispatchGroup()
+{
 }
 
-//--------------------------------------------------------------------------------------------------
-// generate, generate_n
-//--------------------------------------------------------------------------------------------------
+PSTLD_INTERNAL_IMPL void DispatchGroup::dispatch(void *ctx, void (*function)(void *)) noexcept
+{
+    if( m_executor != nullptr )
+        return dispatch_executor(ctx, function);
 
-namespace internal {
+    ThreadPool::instance(m_priority).submit({function, ctx, &m_pending}, m_priority);
+}
 
-template <class It, class Gen>
-struct Generate : Dispatchable<Generate<It, Gen>> {
-    Partition<It> m_partition;
-    Gen &m_gen;
+PSTLD_INTERNAL_IMPL void DispatchGroup::wait() noexcept
+{
+    if( m_executor != nullptr )
+        return wait_executor();
 
-    Generate(size_t count, size_t chunks, It first, Gen &gen)
-        : m_partition(first, count, chunks), m_gen(gen)
-    {
-    }
+    ThreadPool::instance(m_priority).wait(m_pending);
+}
 
-    void run(size_t ind) noexcept
-    {
-        // this technically violates the assumption that the generation will be performed in a
-        // deterministic order, but that in turn essentially makes a parallel version
-        // unimplementable. so instead this implementation calls the generator concurrently without
-        // a specific order.
-        for( auto p = m_partition.at(ind); p.first != p.last; ++p.first )
-            *p.first = m_gen();
-    }
-};
+    #endif // defined(PSTLD_INTERNAL_BACKEND_DISPATCH)
 
-} // namespace internal
+    #if defined(__APPLE__)
 
-template <class FwdIt, class Gen>
-void generate(FwdIt first, FwdIt last, Gen gen) noexcept
+PSTLD_INTERNAL_IMPL size_t sysctl_count(const char *name) noexcept
 {
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Generate<FwdIt, Gen> op{static_cast<size_t>(count), chunks, first, gen};
-            op.dispatch_apply(chunks);
-            return;
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::generate(first, last, gen);
+    int count = 0;
+    size_t count_len = sizeof(count);
+    if( sysctlbyname(name, &count, &count_len, nullptr, 0) != 0 || count < 1 )
+        return 1;
+    return static_cast<size_t>(count);
+}
+
+PSTLD_INTERNAL_IMPL cpu_topology discover_topology() noexcept
+{
+    cpu_topology t;
+    t.logical_cpus = sysctl_count("hw.logicalcpu_max");
+    t.usable_cpus = sysctl_count("hw.logicalcpu");
+    t.physical_cores = sysctl_count("hw.physicalcpu_max");
+    t.smt_per_core = std::max(t.logical_cpus / t.physical_cores, size_t(1));
+    t.workers = t.physical_cores;
+    return t;
 }
 
-template <class FwdIt, class Size, class Gen>
-FwdIt generate_n(FwdIt first, Size count, Gen gen) noexcept
-{
-    if( count < 1 )
-        return first;
+    #elif defined(__linux__)
 
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Generate<FwdIt, Gen> op{static_cast<size_t>(count), chunks, first, gen};
-            op.dispatch_apply(chunks);
-            return op.m_partition.end();
-        } catch( const internal::parallelism_exception & ) {
+PSTLD_INTERNAL_IMPL bool read_line(const std::string &path, std::string &line)
+{
+    FILE *file = std::fopen(path.c_str(), "r");
+    if( file == nullptr )
+        return false;
+    char buf[256];
+    const bool read = std::fgets(buf, sizeof(buf), file) != nullptr;
+    std::fclose(file);
+    if( !read )
+        return false;
+    line = buf;
+    while( !line.empty() && (line.back() == '\n' || line.back() == ' ') )
+        line.pop_back();
+    return true;
+}
+
+// Parses lists like "0-3,8,10-11" as used by sysfs.
+PSTLD_INTERNAL_IMPL size_t count_cpu_list(const std::string &list) noexcept
+{
+    size_t count = 0;
+    const char *p = list.c_str();
+    while( *p != 0 ) {
+        char *end;
+        const unsigned long first = std::strtoul(p, &end, 10);
+        if( end == p )
+            break;
+        unsigned long last = first;
+        p = end;
+        if( *p == '-' ) {
+            last = std::strtoul(p + 1, &end, 10);
+            p = end;
         }
+        count += last >= first ? last - first + 1 : 0;
+        if( *p == ',' )
+            ++p;
     }
-    return std::generate_n(first, count, gen);
+    return count;
 }
 
-//--------------------------------------------------------------------------------------------------
-// copy, copy_n
-//--------------------------------------------------------------------------------------------------
+// Returns the number of CPUs granted by the cgroup bandwidth limit, the most restrictive one along
+// the hierarchy wins. 0 means there's no limit.
+PSTLD_INTERNAL_IMPL double cgroup_cpu_quota()
+{
+    double quota = 0.;
+    auto limit = [&](double cpus) {
+        if( cpus > 0. && (quota == 0. || cpus < quota) )
+            quota = cpus;
+    };
 
-namespace internal {
+    std::string v2_path;
+    std::string v1_path;
+    if( FILE *file = std::fopen("/proc/self/cgroup", "r") ) {
+        char buf[1024];
+        while( std::fgets(buf, sizeof(buf), file) != nullptr ) {
+            std::string line = buf;
+            while( !line.empty() && line.back() == '\n' )
+                line.pop_back();
+            const auto colon1 = line.find(':');
+            const auto colon2 = line.find(':', colon1 + 1);
+            if( colon1 == std::string::npos || colon2 == std::string::npos )
+                continue;
+            const std::string controllers = line.substr(colon1 + 1, colon2 - colon1 - 1);
+            const std::string path = line.substr(colon2 + 1);
+            if( controllers.empty() )
+                v2_path = path;
+            else if( ("," + controllers + ",").find(",cpu,") != std::string::npos )
+                v1_path = path;
+        }
+        std::fclose(file);
+    }
 
-template <class It1, class It2>
-struct Copy : Dispatchable<Copy<It1, It2>> {
-    Partition<It1> m_partition1;
-    Partition<It2> m_partition2;
+    // walks from the process' cgroup up to the root, inside a container the path from
+    // /proc/self/cgroup might not be visible and only the root of the mount is checked then
+    auto walk = [](std::string path, auto &&check) {
+        while( true ) {
+            check(path);
+            if( path.empty() || path == "/" )
+                break;
+            const auto slash = path.find_last_of('/');
+            path = slash == std::string::npos ? std::string{} : path.substr(0, slash);
+        }
+    };
 
-    Copy(size_t count, size_t chunks, It1 first1, It2 first2)
-        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks)
-    {
-    }
+    walk(v2_path, [&](const std::string &path) {
+        std::string line;
+        if( !read_line("/sys/fs/cgroup" + path + "/cpu.max", line) )
+            return;
+        double max = 0.;
+        double period = 0.;
+        if( std::sscanf(line.c_str(), "%lf %lf", &max, &period) == 2 && period > 0. )
+            limit(max / period);
+    });
 
-    void run(size_t ind) noexcept
-    {
-        auto p1 = m_partition1.at(ind);
-        auto p2 = m_partition2.at(ind);
-        std::copy(p1.first, p1.last, p2.first);
-    }
-};
+    for( const char *mount : {"/sys/fs/cgroup/cpu,cpuacct", "/sys/fs/cgroup/cpu"} )
+        walk(v1_path, [&](const std::string &path) {
+            std::string quota_line;
+            std::string period_line;
+            if( !read_line(mount + path + "/cpu.cfs_quota_us", quota_line) ||
+                !read_line(mount + path + "/cpu.cfs_period_us", period_line) )
+                return;
+            const double max = std::atof(quota_line.c_str());
+            const double period = std::atof(period_line.c_str());
+            if( period > 0. )
+                limit(max / period);
+        });
 
-} // namespace internal
+    return quota;
+}
 
-template <class FwdIt1, class FwdIt2>
-FwdIt2 copy(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+PSTLD_INTERNAL_IMPL cpu_topology discover_topology() noexcept
 {
-    const auto count = std::distance(first1, last1);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Copy<FwdIt1, FwdIt2> op{static_cast<size_t>(count), chunks, first1, first2};
-            op.dispatch_apply(chunks);
-            return op.m_partition2.end();
-        } catch( const internal::parallelism_exception & ) {
+    cpu_topology t;
+    try {
+        t.logical_cpus = static_cast<size_t>(std::max(::sysconf(_SC_NPROCESSORS_CONF), 1l));
+
+        const size_t max_cpus = std::max(t.logical_cpus, size_t(CPU_SETSIZE));
+        cpu_set_t *set = CPU_ALLOC(max_cpus);
+        const size_t set_size = CPU_ALLOC_SIZE(max_cpus);
+        std::vector<size_t> cpus;
+        if( set != nullptr ) {
+            CPU_ZERO_S(set_size, set);
+            if( ::sched_getaffinity(0, set_size, set) == 0 )
+                for( size_t cpu = 0; cpu != max_cpus; ++cpu )
+                    if( CPU_ISSET_S(cpu, set_size, set) )
+                        cpus.push_back(cpu);
+            CPU_FREE(set);
         }
+        t.usable_cpus = cpus.empty() ? t.logical_cpus : cpus.size();
+
+        std::vector<std::pair<long, long>> cores; // package id, core id
+        for( const size_t cpu : cpus ) {
+            const std::string dir =
+                "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+            std::string package;
+            std::string core;
+            if( read_line(dir + "physical_package_id", package) &&
+                read_line(dir + "core_id", core) )
+                cores.emplace_back(std::atol(package.c_str()), std::atol(core.c_str()));
+        }
+        std::sort(cores.begin(), cores.end());
+        cores.erase(std::unique(cores.begin(), cores.end()), cores.end());
+        t.physical_cores = cores.empty() ? t.usable_cpus : cores.size();
+        t.smt_per_core = std::max(t.usable_cpus / t.physical_cores, size_t(1));
+
+        std::string nodes;
+        if( read_line("/sys/devices/system/node/online", nodes) )
+            t.numa_nodes = std::max(count_cpu_list(nodes), size_t(1));
+
+        t.cpu_quota = cgroup_cpu_quota();
+    } catch( ... ) {
+        t = cpu_topology{};
+        t.logical_cpus = t.usable_cpus = t.physical_cores =
+            std::max(std::thread::hardware_concurrency(), 1u);
     }
-    return std::copy(first1, last1, first2);
+
+    t.workers = t.usable_cpus;
+    if( t.cpu_quota > 0. )
+        t.workers = std::min(t.workers, static_cast<size_t>(std::ceil(t.cpu_quota)));
+    t.workers = std::max(t.workers, size_t(1));
+    return t;
 }
 
-template <class FwdIt1, class Size, class FwdIt2>
-FwdIt2 copy_n(FwdIt1 first1, Size count, FwdIt2 first2) noexcept
+    #else
+
+PSTLD_INTERNAL_IMPL cpu_topology discover_topology() noexcept
 {
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Copy<FwdIt1, FwdIt2> op{static_cast<size_t>(count), chunks, first1, first2};
-            op.dispatch_apply(chunks);
-            return op.m_partition2.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::copy_n(first1, count, first2);
+    cpu_topology t;
+    t.logical_cpus = t.usable_cpus = t.physical_cores = t.workers =
+        std::max(std::thread::hardware_concurrency(), 1u);
+    return t;
 }
 
-//--------------------------------------------------------------------------------------------------
-// replace, replace_if
-//--------------------------------------------------------------------------------------------------
+    #endif
 
-template <class FwdIt, class T>
-void replace(FwdIt first, FwdIt last, const T &old_val, const T &new_val) noexcept
+struct TopologyCache {
+    std::mutex mutex;
+    cpu_topology topology{discover_topology()};
+    std::atomic<size_t> workers{topology.workers};
+};
+
+PSTLD_INTERNAL_IMPL TopologyCache &topology_cache() noexcept
 {
-    ::pstld::for_each(first, last, [&](auto &val) {
-        if( val == old_val )
-            val = new_val;
-    });
+    static TopologyCache cache;
+    return cache;
 }
 
-template <class FwdIt, class Pred, class T>
-void replace_if(FwdIt first, FwdIt last, Pred pred, const T &new_val) noexcept
+PSTLD_INTERNAL_IMPL size_t max_hw_threads() noexcept
 {
-    ::pstld::for_each(first, last, [&, pred](auto &val) mutable {
-        if( pred(val) )
-            val = new_val;
-    });
+    return topology_cache().workers.load(std::memory_order_relaxed);
 }
 
-//--------------------------------------------------------------------------------------------------
-// swap_ranges
-//--------------------------------------------------------------------------------------------------
+PSTLD_INTERNAL_IMPL const CallOptions *&call_options() noexcept
+{
+    static thread_local const CallOptions *options = nullptr;
+    return options;
+}
 
-namespace internal {
+// Takes over a per-thread block given back by an exited thread or allocates and publishes a new
+// one, nullptr if the allocation failed. The blocks are never freed, so their number is bounded by
+// the number of threads alive at a time. 'init' prepares a newly allocated block.
+template <class Block, class Init>
+Block *claim_block(std::atomic<Block *> &blocks, Init init) noexcept
+{
+    Block *block = blocks.load(std::memory_order_acquire);
+    for( bool owned = false; block != nullptr; block = block->next, owned = false )
+        if( block->owned.compare_exchange_strong(owned, true, std::memory_order_acquire) )
+            return block;
+    block = new(std::nothrow) Block;
+    if( block == nullptr )
+        return nullptr;
+    init(*block);
+    block->next = blocks.load(std::memory_order_relaxed);
+    while( !blocks.compare_exchange_weak(block->next, block, std::memory_order_release) )
+        ;
+    return block;
+}
 
-template <class It1, class It2>
-struct SwapRanges : Dispatchable<SwapRanges<It1, It2>> {
-    Partition<It1> m_partition1;
-    Partition<It2> m_partition2;
+PSTLD_INTERNAL_IMPL std::chrono::steady_clock::time_point &parallel_since() noexcept
+{
+    static thread_local std::chrono::steady_clock::time_point since;
+    return since;
+}
 
-    SwapRanges(size_t count, size_t chunks, It1 first1, It2 first2)
-        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks)
-    {
-    }
+struct AlgorithmCounters {
+    std::atomic<size_t> parallel{0};
+    std::atomic<size_t> serial{0};
+    std::atomic<size_t> fallbacks{0};
+    std::atomic<size_t> latency[latency_buckets] = {};
+};
 
-    void run(size_t ind) noexcept
+// The counters bumped by one thread. A block taken over from an exited thread keeps its counts,
+// the snapshot adds up all blocks ever allocated.
+struct StatsBlock {
+    AlgorithmCounters algorithms[algorithms_count];
+    std::atomic<size_t> steals{0};
+    std::atomic<size_t> failed_steals{0};
+    std::atomic<size_t> yields{0};
+    std::atomic<bool> owned{true};
+    bool shared = false;
+    StatsBlock *next = nullptr;
+
+    // Only the owning thread writes to its block, a plain load and store are enough there and
+    // the snapshots still read whole values. The shared block is bumped by many threads at once.
+    void bump(std::atomic<size_t> &counter) const noexcept
     {
-        auto p1 = m_partition1.at(ind);
-        auto p2 = m_partition2.at(ind);
-        std::swap_ranges(p1.first, p1.last, p2.first);
+        if( shared )
+            counter.fetch_add(1, std::memory_order_relaxed);
+        else
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
     }
 };
 
-} // namespace internal
+struct StatsRegistry {
+    std::atomic<StatsBlock *> blocks{nullptr};
+    StatsBlock shared; // counts the threads which couldn't get a block of their own
 
-template <class FwdIt1, class FwdIt2>
-FwdIt2 swap_ranges(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+    StatsRegistry() noexcept { shared.shared = true; }
+};
+
+PSTLD_INTERNAL_IMPL StatsRegistry &stats_registry() noexcept
 {
-    const auto count = std::distance(first1, last1);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::SwapRanges<FwdIt1, FwdIt2> op{
-                static_cast<size_t>(count), chunks, first1, first2};
-            op.dispatch_apply(chunks);
-            return op.m_partition2.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::swap_ranges(first1, last1, first2);
+    static StatsRegistry registry;
+    return registry;
 }
 
-//--------------------------------------------------------------------------------------------------
-// adjacent_difference
-//--------------------------------------------------------------------------------------------------
-
-namespace internal {
-
-template <class It1, class It2, class BinOp>
-struct AdjacentDifference : Dispatchable<AdjacentDifference<It1, It2, BinOp>> {
-    Partition<It1> m_partition1;
-    Partition<It2> m_partition2;
-    BinOp m_op;
+struct StatsSlot {
+    StatsBlock *block;
+    bool closed;
+};
 
-    AdjacentDifference(size_t count, size_t chunks, It1 first1, It2 first2, BinOp op)
-        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks), m_op(op)
-    {
-    }
+PSTLD_INTERNAL_IMPL StatsSlot &stats_slot() noexcept
+{
+    static thread_local StatsSlot slot;
+    return slot;
+}
 
-    void run(size_t ind) noexcept
+struct StatsReaper {
+    ~StatsReaper()
     {
-        auto p1 = m_partition1.at(ind);
-        auto p2 = m_partition2.at(ind);
-        auto i1 = p1.first;
-        auto i2 = std::next(p1.first);
-        while( true ) {
-            *p2.first = m_op(*i2, *i1);
-            if( i2 == p1.last )
-                break;
-            i1 = i2;
-            ++i2;
-            ++p2.first;
-        }
+        auto &slot = stats_slot();
+        slot.block->owned.store(false, std::memory_order_release);
+        slot.block = nullptr;
+        slot.closed = true;
     }
 };
 
-} // namespace internal
-
-template <class FwdIt1, class FwdIt2, class BinOp>
-FwdIt2 adjacent_difference(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, BinOp bop) noexcept
+// The counters of the calling thread, or the shared ones if it has no block of its own.
+PSTLD_INTERNAL_IMPL StatsBlock &stats_block() noexcept
 {
-    const auto count = std::distance(first1, last1);
-    if( count > 2 ) {
-        *first2 = *first1;
-        const auto chunks = internal::work_chunks_min_fraction_1(count - 1);
-        try {
-            internal::AdjacentDifference<FwdIt1, FwdIt2, BinOp> op{
-                static_cast<size_t>(count - 1), chunks, first1, std::next(first2), bop};
-            op.dispatch_apply(chunks);
-            return op.m_partition2.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return ::std::adjacent_difference(first1, last1, first2, bop);
+    auto &slot = stats_slot();
+    if( slot.block != nullptr )
+        return *slot.block;
+    auto &registry = stats_registry();
+    if( slot.closed )
+        return registry.shared;
+    slot.block = claim_block(registry.blocks, [](StatsBlock &) {});
+    if( slot.block == nullptr )
+        return registry.shared;
+    static thread_local StatsReaper reaper;
+    return *slot.block;
 }
 
-template <class FwdIt1, class FwdIt2>
-FwdIt2 adjacent_difference(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+PSTLD_INTERNAL_IMPL void count_parallel_call(algorithm a,
+                                             std::chrono::steady_clock::duration latency) noexcept
 {
-    return ::pstld::adjacent_difference(first1, last1, first2, std::minus<>{});
+    auto &block = stats_block();
+    auto &counters = block.algorithms[size_t(a)];
+    block.bump(counters.parallel);
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count();
+    const size_t bucket = ns > 1 ? std::min(log2(static_cast<size_t>(ns)), latency_buckets - 1) : 0;
+    block.bump(counters.latency[bucket]);
 }
 
-//--------------------------------------------------------------------------------------------------
-// reverse
-//--------------------------------------------------------------------------------------------------
-
-namespace internal {
-
-template <class It>
-struct Reverse : Dispatchable<Reverse<It>> {
-    Partition<It> m_partition1;
-    Partition<It, false> m_partition2;
+PSTLD_INTERNAL_IMPL void count_serial_call(algorithm a, bool fallback) noexcept
+{
+    auto &block = stats_block();
+    auto &counters = block.algorithms[size_t(a)];
+    block.bump(counters.serial);
+    if( fallback )
+        block.bump(counters.fallbacks);
+}
 
-    Reverse(size_t count, size_t chunks, It first, It last)
-        : m_partition1(first, count, chunks), m_partition2(std::prev(last), count, chunks)
-    {
-    }
+PSTLD_INTERNAL_IMPL void count_steal(bool stolen) noexcept
+{
+    auto &block = stats_block();
+    block.bump(stolen ? block.steals : block.failed_steals);
+}
 
-    void run(size_t ind) noexcept
-    {
-        auto p1 = m_partition1.at(ind);
-        auto p2 = m_partition2.at(ind);
-        for( ; p1.first != p1.last; ++p1.first, --p2.first )
-            std::iter_swap(p1.first, p2.first);
-    }
-};
+PSTLD_INTERNAL_IMPL void count_yield() noexcept
+{
+    auto &block = stats_block();
+    block.bump(block.yields);
+}
 
-} // namespace internal
+    #if defined(PSTLD_TRACING)
 
-template <class FwdIt>
-void reverse(FwdIt first, FwdIt last) noexcept
+PSTLD_INTERNAL_IMPL std::atomic<const trace::hooks *> &trace_hooks_storage() noexcept
 {
-    const auto count = std::distance(first, last);
-    if( count > 3 ) {
-        const auto chunks = internal::work_chunks_min_fraction_1(count / 2);
-        try {
-            internal::Reverse<FwdIt> op{static_cast<size_t>(count / 2), chunks, first, last};
-            op.dispatch_apply(chunks);
-            return;
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    ::std::reverse(first, last);
+    static std::atomic<const trace::hooks *> storage{nullptr};
+    return storage;
 }
 
-//--------------------------------------------------------------------------------------------------
-// inclusive_scan, transform_inclusive_scan
-//--------------------------------------------------------------------------------------------------
-
-namespace internal {
+PSTLD_INTERNAL_IMPL const trace::hooks *trace_hooks() noexcept
+{
+    return trace_hooks_storage().load(std::memory_order_acquire);
+}
 
-template <class It, class BinOp, class UnOp, class R>
-R partial_reduce(It first, It last, BinOp reduce, UnOp transform)
+PSTLD_INTERNAL_IMPL TracedCall *&current_trace_call() noexcept
 {
-    auto init = first++;
-    auto val = static_cast<R>(reduce(transform(*init), transform(*first++)));
-    for( ; first != last; ++first )
-        val = reduce(std::move(val), transform(*first));
-    return val;
+    static thread_local TracedCall *traced = nullptr;
+    return traced;
 }
 
-template <class It1, class It2, class BinOp, class UnOp, class T>
-struct InclusiveScan : Dispatchable2<InclusiveScan<It1, It2, BinOp, UnOp, T>> {
-    Partition<It1> m_partition1;
-    Partition<It2> m_partition2;
-    unitialized_array<T> m_reduced;
-    BinOp m_op;
-    UnOp m_tr;
-    T &m_init;
+struct TraceEvent {
+    std::chrono::steady_clock::time_point time;
+    const char *name;
+    const char *arg_name;
+    size_t arg;
+    uint32_t tid; // of the thread which owned the ring at the time
+    char phase;
+};
+
+// A single-producer ring of events: the owning thread appends at the head, a flush consumes from
+// the tail. The ring of an exited thread is handed to the next thread which needs one, the events
+// carry the thread ids since a flush may find those of both threads in a ring.
+struct TraceRing {
+    static constexpr size_t capacity = size_t(1) << 16;
+
+    TraceEvent events[capacity];
+    std::atomic<size_t> head{0};
+    std::atomic<size_t> tail{0};
+    std::atomic<bool> owned{true};
+    TraceRing *next = nullptr;
+};
+
+struct TraceRecorder {
+    std::atomic<bool> recording{false};
+    std::atomic<TraceRing *> rings{nullptr};
+    std::atomic<uint32_t> next_tid{1};
+    std::atomic<size_t> dropped{0};
+    const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    std::mutex flush_mutex;
+};
 
-    InclusiveScan(size_t count, size_t chunks, It1 first1, It2 first2, BinOp op, UnOp tr, T &init)
-        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks),
-          m_reduced(chunks), m_op(op), m_tr(tr), m_init(init)
-    {
-    }
+PSTLD_INTERNAL_IMPL TraceRecorder &trace_recorder() noexcept
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
 
-    void run_first(size_t ind) noexcept
-    {
-        // fill the reduced chunks
-        auto p1 = m_partition1.at(ind);
-        m_reduced.put(ind, partial_reduce<It1, BinOp, UnOp, T>(p1.first, p1.last, m_op, m_tr));
-    }
+PSTLD_INTERNAL_IMPL bool trace_recording() noexcept
+{
+    return trace_recorder().recording.load(std::memory_order_relaxed);
+}
 
-    void run_second(size_t ind) noexcept
-    {
-        // fill the output
-        auto p1 = m_partition1.at(ind);
-        auto p2 = m_partition2.at(ind);
-        auto val = ind == 0
-                       ? static_cast<T>(m_op(m_init, m_tr(*p1.first++)))
-                       : static_cast<T>(m_op(std::move(m_reduced[ind - 1]), m_tr(*p1.first++)));
-        *p2.first++ = val;
-        for( ; p1.first != p1.last; ++p1.first, ++p2.first ) {
-            val = m_op(std::move(val), m_tr(*p1.first));
-            *p2.first = val;
-        }
-    }
+// The ring of the calling thread. Like ScratchCache it's plain thread-local data, which a reaper
+// created along with the first ring closes at the thread exit, giving the ring back.
+struct TraceRingSlot {
+    TraceRing *ring;
+    uint32_t tid; // given anew whenever a ring is claimed, so timelines of threads never merge
+    bool closed;
+};
 
-    void accumulate() noexcept
+PSTLD_INTERNAL_IMPL TraceRingSlot &trace_ring_slot() noexcept
+{
+    static thread_local TraceRingSlot slot;
+    return slot;
+}
+
+struct TraceRingReaper {
+    ~TraceRingReaper()
     {
-        // reduce chunks serially
-        auto first = m_reduced.begin();
-        auto last = m_reduced.end();
-        *first = m_op(m_init, std::move(*first));
-        for( auto prev = first++; first != last; ++first, ++prev )
-            *first = m_op(*prev, std::move(*first));
+        auto &slot = trace_ring_slot();
+        slot.ring->owned.store(false, std::memory_order_release);
+        slot.ring = nullptr;
+        slot.closed = true;
     }
 };
 
-} // namespace internal
+PSTLD_INTERNAL_IMPL TraceRing *trace_ring() noexcept
+{
+    auto &slot = trace_ring_slot();
+    if( slot.ring != nullptr || slot.closed )
+        return slot.ring;
+    auto &recorder = trace_recorder();
+    slot.ring = claim_block(recorder.rings, [](TraceRing &) {});
+    if( slot.ring == nullptr )
+        return nullptr;
+    slot.tid = recorder.next_tid.fetch_add(1, std::memory_order_relaxed);
+    static thread_local TraceRingReaper reaper;
+    return slot.ring;
+}
 
-template <class FwdIt1, class FwdIt2, class BinOp, class UnOp, class T>
-FwdIt2 transform_inclusive_scan(FwdIt1 first1,
-                                FwdIt1 last1,
-                                FwdIt2 first2,
-                                BinOp reduce_op,
-                                UnOp transform_op,
-                                T val) noexcept
+PSTLD_INTERNAL_IMPL void
+trace_record(char phase, const char *name, const char *arg_name, size_t arg) noexcept
 {
-    const auto count = std::distance(first1, last1);
-    const auto chunks = internal::work_chunks_min_fraction_2(count);
-    if( chunks > 1 ) {
-        try {
-            internal::InclusiveScan<FwdIt1, FwdIt2, BinOp, UnOp, T> op{
-                static_cast<size_t>(count), chunks, first1, first2, reduce_op, transform_op, val};
-            op.dispatch_apply_first(chunks);
-            op.accumulate();
-            op.dispatch_apply_second(chunks);
-            return op.m_partition2.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
+    if( !trace_recording() )
+        return;
+    TraceRing *ring = trace_ring();
+    if( ring == nullptr )
+        return;
+    const size_t head = ring->head.load(std::memory_order_relaxed);
+    if( head - ring->tail.load(std::memory_order_acquire) == TraceRing::capacity ) {
+        trace_recorder().dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
     }
-    return ::std::transform_inclusive_scan(
-        first1, last1, first2, reduce_op, transform_op, std::move(val));
+    ring->events[head % TraceRing::capacity] = TraceEvent{
+        std::chrono::steady_clock::now(), name, arg_name, arg, trace_ring_slot().tid, phase};
+    ring->head.store(head + 1, std::memory_order_release);
 }
 
-template <class FwdIt1, class FwdIt2, class BinOp, class UnOp>
-FwdIt2 transform_inclusive_scan(FwdIt1 first1,
-                                FwdIt1 last1,
-                                FwdIt2 first2,
-                                BinOp reduce_op,
-                                UnOp transform_op) noexcept
+    #endif
+
+PSTLD_INTERNAL_IMPL std::atomic<const executor *> &default_executor_storage() noexcept
 {
-    const auto count = std::distance(first1, last1);
-    if( count == 0 )
-        return first2;
-    const auto chunks = internal::work_chunks_min_fraction_2(count - 1);
-    if( chunks > 1 ) {
-        try {
-            *first2 = transform_op(*first1);
-            internal::InclusiveScan<FwdIt1, FwdIt2, BinOp, UnOp, internal::iterator_value_t<FwdIt2>>
-                op{static_cast<size_t>(count - 1),
-                   chunks,
-                   std::next(first1),
-                   std::next(first2),
-                   reduce_op,
-                   transform_op,
-                   *first2};
-            op.dispatch_apply_first(chunks);
-            op.accumulate();
-            op.dispatch_apply_second(chunks);
-            return op.m_partition2.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return ::std::transform_inclusive_scan(first1, last1, first2, reduce_op, transform_op);
+    static std::atomic<const executor *> storage{nullptr};
+    return storage;
 }
 
-template <class FwdIt1, class FwdIt2, class BinOp, class T>
-FwdIt2 inclusive_scan(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, BinOp reduce_op, T val) noexcept
+PSTLD_INTERNAL_IMPL const executor *current_executor() noexcept
 {
-    return ::pstld::transform_inclusive_scan(
-        first1, last1, first2, reduce_op, internal::no_op{}, std::move(val));
+    const CallOptions *options = call_options();
+    if( options != nullptr && options->exec != nullptr )
+        return options->exec;
+    return default_executor_storage().load(std::memory_order_acquire);
 }
 
-template <class FwdIt1, class FwdIt2, class BinOp>
-FwdIt2 inclusive_scan(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, BinOp reduce_op) noexcept
+PSTLD_INTERNAL_IMPL size_t &nesting_depth() noexcept
 {
-    return ::pstld::transform_inclusive_scan(first1, last1, first2, reduce_op, internal::no_op{});
+    static thread_local size_t depth = 0;
+    return depth;
 }
 
-template <class FwdIt1, class FwdIt2>
-FwdIt2 inclusive_scan(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+PSTLD_INTERNAL_IMPL size_t &arena_limit() noexcept
 {
-    return ::pstld::inclusive_scan(first1, last1, first2, ::std::plus<>{});
+    static thread_local size_t limit = std::numeric_limits<size_t>::max();
+    return limit;
 }
 
-//--------------------------------------------------------------------------------------------------
-// exclusive_scan, transform_exclusive_scan
-//--------------------------------------------------------------------------------------------------
+// The tighter of the limits set by the arena entered by the calling thread and by the current call.
+PSTLD_INTERNAL_IMPL size_t worker_limit() noexcept
+{
+    const CallOptions *options = call_options();
+    if( options != nullptr )
+        return std::min(options->worker_limit, arena_limit());
+    return arena_limit();
+}
 
-namespace internal {
+PSTLD_INTERNAL_IMPL size_t max_workers() noexcept
+{
+    const executor *e = current_executor();
+    const size_t workers = e != nullptr ? e->concurrency(e->context) : max_hw_threads();
+    return std::max(std::min(workers, worker_limit()), size_t(1));
+}
 
-template <class It1, class It2, class BinOp, class UnOp, class T>
-struct ExclusiveScan : Dispatchable2<ExclusiveScan<It1, It2, BinOp, UnOp, T>> {
-    Partition<It1> m_partition1;
-    Partition<It2> m_partition2;
-    unitialized_array<T> m_reduced;
-    BinOp m_op;
-    UnOp m_tr;
-    T &m_init;
+// Executes the iterations of a parallel call, marking the workers as nested into it and keeping
+// them in the caller's arena, so that the calls made from within obey both. A capped call is
+// executed by fewer lanes, which pull the iterations from a shared counter.
+struct Lanes {
+    void *ctx;
+    void (*function)(void *, size_t);
+    size_t iterations;
+    size_t limit;
+    std::atomic<size_t> next{0};
 
-    ExclusiveScan(size_t count, size_t chunks, It1 first1, It2 first2, BinOp op, UnOp tr, T &init)
-        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks),
-          m_reduced(chunks), m_op(op), m_tr(tr), m_init(init)
+    static void run(void *me_ptr, size_t) noexcept
     {
+        auto me = static_cast<Lanes *>(me_ptr);
+        NestedScope nested;
+        const size_t previous = std::exchange(arena_limit(), me->limit);
+        for( size_t ind = me->next++; ind < me->iterations; ind = me->next++ )
+            me->function(me->ctx, ind);
+        arena_limit() = previous;
     }
 
-    void run_first(size_t ind) noexcept
+    static void run_one(void *me_ptr, size_t ind) noexcept
     {
-        // fill the reduced chunks
-        auto p1 = m_partition1.at(ind);
-        m_reduced.put(ind, partial_reduce<It1, BinOp, UnOp, T>(p1.first, p1.last, m_op, m_tr));
+        auto me = static_cast<Lanes *>(me_ptr);
+        NestedScope nested;
+        const size_t previous = std::exchange(arena_limit(), me->limit);
+        me->function(me->ctx, ind);
+        arena_limit() = previous;
     }
+};
 
-    void run_second(size_t ind) noexcept
+// The owners of a range are recorded per segment, a fixed fraction of it, so that calls splitting
+// the range into different numbers of chunks still agree on which thread gets which part. A chunk
+// records the segments whose middles it covers and replays the owner of the segment under its own
+// middle. Owners are the affinity slots of the threads plus one, zero means unknown.
+struct AffinityMap {
+    static constexpr size_t segments = 1024;
+    std::atomic<uint16_t> owners[segments] = {};
+
+    uint16_t owner(size_t chunk, size_t chunks) const noexcept
     {
-        // fill the output
-        auto p1 = m_partition1.at(ind);
-        auto p2 = m_partition2.at(ind);
-        auto val = std::move(ind == 0 ? m_init : m_reduced[ind - 1]);
-        for( ; p1.first != p1.last; ++p1.first, ++p2.first ) {
-            auto next = m_op(val, m_tr(*p1.first));
-            *p2.first = std::move(val);
-            val = std::move(next);
-        }
+        return owners[(2 * chunk + 1) * segments / (2 * chunks)].load(std::memory_order_relaxed);
     }
 
-    void accumulate() noexcept
+    void record(size_t chunk, size_t chunks, uint16_t owner) noexcept
     {
-        // reduce chunks serially
-        auto first = m_reduced.begin();
-        auto last = m_reduced.end();
-        *first = m_op(m_init, std::move(*first));
-        for( auto prev = first++; first != last; ++first, ++prev )
-            *first = m_op(*prev, std::move(*first));
+        const auto chunk_of = [chunks](size_t segment) {
+            return (2 * segment + 1) * chunks / (2 * segments);
+        };
+        size_t segment = chunk * segments / chunks;
+        while( segment != segments && chunk_of(segment) < chunk )
+            ++segment;
+        for( ; segment != segments && chunk_of(segment) == chunk; ++segment )
+            owners[segment].store(owner, std::memory_order_relaxed);
+    }
+
+    void clear() noexcept
+    {
+        for( auto &owner : owners )
+            owner.store(0, std::memory_order_relaxed);
     }
 };
 
-template <class FwdIt1, class FwdIt2, class T, class BinOp, class UnOp>
-FwdIt2 transform_exclusive_scan_serial(FwdIt1 first1,
-                                       FwdIt1 last1,
-                                       FwdIt2 first2,
-                                       T val,
-                                       BinOp reduce_op,
-                                       UnOp transform_op) noexcept
+// A small number identifying the calling thread, stable for its lifetime.
+PSTLD_INTERNAL_IMPL uint16_t affinity_slot() noexcept
 {
-    // manual serial implementation because transform_exclusive_scan from libc++ doesn't play well
-    // with MSVC's unit tests
-    for( ; first1 != last1; ++first1, ++first2 ) {
-        auto next = reduce_op(val, transform_op(*first1));
-        *first2 = std::move(val);
-        val = std::move(next);
-    }
-    return first2;
+    static std::atomic<size_t> next{0};
+    static thread_local const uint16_t slot = static_cast<uint16_t>(
+        next.fetch_add(1, std::memory_order_relaxed) % std::numeric_limits<uint16_t>::max() + 1);
+    return slot;
 }
 
-} // namespace internal
+// Lanes replaying an affinity map: each lane first claims the chunks recorded for its thread, then
+// pulls the remaining ones from the shared counter. Whoever runs a chunk becomes its owner.
+struct AffinityLanes {
+    void *ctx;
+    void (*function)(void *, size_t);
+    size_t iterations;
+    size_t limit;
+    AffinityMap &map;
+    std::atomic<bool> *claimed;
+    std::atomic<size_t> next{0};
 
-template <class FwdIt1, class FwdIt2, class T, class BinOp, class UnOp>
-FwdIt2 transform_exclusive_scan(FwdIt1 first1,
-                                FwdIt1 last1,
-                                FwdIt2 first2,
-                                T val,
-                                BinOp reduce_op,
-                                UnOp transform_op) noexcept
+    void claim(size_t ind, uint16_t slot) noexcept
+    {
+        if( claimed[ind].exchange(true, std::memory_order_relaxed) )
+            return;
+        map.record(ind, iterations, slot);
+        function(ctx, ind);
+    }
+
+    static void run(void *me_ptr, size_t) noexcept
+    {
+        auto me = static_cast<AffinityLanes *>(me_ptr);
+        NestedScope nested;
+        const size_t previous = std::exchange(arena_limit(), me->limit);
+        const uint16_t slot = affinity_slot();
+        for( size_t ind = 0; ind != me->iterations; ++ind )
+            if( me->map.owner(ind, me->iterations) == slot )
+                me->claim(ind, slot);
+        for( size_t ind = me->next++; ind < me->iterations; ind = me->next++ )
+            me->claim(ind, slot);
+        arena_limit() = previous;
+    }
+};
+
+// The first call which asks for the overhead claims the probe and hands it to a worker of the
+// built-in backend, so that no caller waits for the pool's threads to be spawned and measured. The
+// calls made until the probe completes assume a pessimistic overhead. The probe itself can't run
+// under a lock, since it needs the pool's threads, the lock only orders the installations.
+struct CostModelCache {
+    enum State : int {
+        Unknown,
+        Probing,
+        Ready
+    };
+    std::atomic<int> state{Unknown};
+    std::atomic<double> fork_join_ns{50'000.};
+    std::mutex install_mut;
+};
+
+PSTLD_INTERNAL_IMPL CostModelCache &cost_model_cache() noexcept
 {
-    const auto count = std::distance(first1, last1);
-    if( count == 0 )
-        return first2;
-    if( count == 1 ) {
-        *first2 = std::move(val);
-        return std::next(first2);
+    static CostModelCache cache;
+    return cache;
+}
+
+// Measures the median duration of an empty parallel call on the built-in backend, the first runs
+// are discarded since they include spawning the threads and faulting in their stacks.
+PSTLD_INTERNAL_IMPL double measure_fork_join_ns() noexcept
+{
+    constexpr size_t warmup = 4;
+    constexpr size_t runs = 15;
+    const size_t iterations = std::max(max_hw_threads(), size_t(2));
+    std::atomic<size_t> sink{0};
+    double durations[runs];
+    for( size_t i = 0; i != warmup + runs; ++i ) {
+        const auto start = std::chrono::steady_clock::now();
+        backend_dispatch_apply(iterations, &sink, [](void *ctx, size_t) noexcept {
+            static_cast<std::atomic<size_t> *>(ctx)->fetch_add(1, std::memory_order_relaxed);
+        });
+        const auto end = std::chrono::steady_clock::now();
+        if( i >= warmup )
+            durations[i - warmup] = std::chrono::duration<double, std::nano>(end - start).count();
     }
-    const auto chunks = internal::work_chunks_min_fraction_2(count);
-    if( chunks > 1 ) {
-        try {
-            internal::ExclusiveScan<FwdIt1, FwdIt2, BinOp, UnOp, T> op{
-                static_cast<size_t>(count), chunks, first1, first2, reduce_op, transform_op, val};
-            op.dispatch_apply_first(chunks);
-            op.accumulate();
-            op.dispatch_apply_second(chunks);
-            return op.m_partition2.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
+    std::nth_element(durations, durations + runs / 2, durations + runs);
+    return durations[runs / 2];
+}
+
+PSTLD_INTERNAL_IMPL bool read_cost_profile(const char *path, cost_profile &profile) noexcept
+{
+    FILE *file = std::fopen(path, "r");
+    if( file == nullptr )
+        return false;
+    double fork_join_ns = -1.;
+    const bool parsed = std::fscanf(file, " fork_join_ns %lf", &fork_join_ns) == 1;
+    std::fclose(file);
+    if( !parsed || !(fork_join_ns >= 0.) )
+        return false;
+    profile.fork_join_ns = fork_join_ns;
+    return true;
+}
+
+// With 'exclusive' set the file is written only if it doesn't exist yet.
+PSTLD_INTERNAL_IMPL bool
+write_cost_profile(const char *path, const cost_profile &profile, bool exclusive) noexcept
+{
+    FILE *file = std::fopen(path, exclusive ? "wx" : "w");
+    if( file == nullptr )
+        return false;
+    const bool written = std::fprintf(file, "fork_join_ns %.1f\n", profile.fork_join_ns) > 0;
+    return std::fclose(file) == 0 && written;
+}
+
+// Installs the profile, unless 'probed' is set and a profile was installed explicitly while the
+// probe was running.
+PSTLD_INTERNAL_IMPL void install_cost_profile(const cost_profile &profile, bool probed) noexcept
+{
+    auto &cache = cost_model_cache();
+    std::lock_guard lock{cache.install_mut};
+    if( probed && cache.state.load(std::memory_order_relaxed) != CostModelCache::Probing )
+        return;
+    cache.fork_join_ns.store(profile.fork_join_ns, std::memory_order_relaxed);
+    cache.state.store(CostModelCache::Ready, std::memory_order_release);
+}
+
+// Loads the profile from the file named by PSTLD_COST_PROFILE or measures it. A measured profile
+// is saved into that file only if there's no such file yet, so that a file which failed to parse
+// isn't overwritten.
+PSTLD_INTERNAL_IMPL void probe_cost_profile(void *) noexcept
+{
+    cost_profile profile;
+    const char *path = std::getenv("PSTLD_COST_PROFILE");
+    if( path == nullptr || *path == 0 || !read_cost_profile(path, profile) ) {
+        profile.fork_join_ns = measure_fork_join_ns();
+        if( path != nullptr && *path != 0 )
+            write_cost_profile(path, profile, true);
     }
-    return internal::transform_exclusive_scan_serial(
-        first1, last1, first2, std::move(val), reduce_op, transform_op);
+    install_cost_profile(profile, true);
 }
 
-template <class FwdIt1, class FwdIt2, class T, class BinOp>
-FwdIt2 exclusive_scan(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, T val, BinOp reduce_op) noexcept
+PSTLD_INTERNAL_IMPL double fork_join_overhead_ns() noexcept
 {
-    return ::pstld::transform_exclusive_scan(
-        first1, last1, first2, std::move(val), reduce_op, internal::no_op{});
+    auto &cache = cost_model_cache();
+    int state = cache.state.load(std::memory_order_acquire);
+    if( state == CostModelCache::Unknown &&
+        cache.state.compare_exchange_strong(state, CostModelCache::Probing) )
+        backend_dispatch_async(nullptr, probe_cost_profile);
+    return cache.fork_join_ns.load(std::memory_order_relaxed);
 }
 
-template <class FwdIt1, class FwdIt2, class T>
-FwdIt2 exclusive_scan(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, T val) noexcept
+PSTLD_INTERNAL_IMPL bool cost_model_allows(size_t count, size_t cost) noexcept
 {
-    return ::pstld::exclusive_scan(first1, last1, first2, std::move(val), ::std::plus<>{});
+    if( current_executor() != nullptr )
+        return true; // the overhead of an application's executor is unknown
+    const size_t workers = max_workers();
+    if( workers < 2 )
+        return false;
+    // A parallel call takes roughly the overhead plus the serial time divided between the workers.
+    // Demand it to win by the overhead once more, so that misestimates don't turn into slowdowns.
+    const double serial_ns = static_cast<double>(count) * static_cast<double>(cost) / 1000.;
+    const double saved_ns = serial_ns - serial_ns / static_cast<double>(workers);
+    return saved_ns > 2. * fork_join_overhead_ns();
 }
 
-//--------------------------------------------------------------------------------------------------
-// lexicographical_compare
-//--------------------------------------------------------------------------------------------------
+PSTLD_INTERNAL_IMPL void
+dispatch_apply_uncapped(size_t iterations, void *ctx, void (*function)(void *, size_t)) noexcept
+{
+    if( const executor *e = current_executor() )
+        e->bulk_execute(e->context, iterations, ctx, function);
+    else
+        backend_dispatch_apply(iterations, ctx, function);
+}
 
-namespace internal {
+PSTLD_INTERNAL_IMPL std::atomic<bool> &huge_pages_enabled() noexcept
+{
+    static std::atomic<bool> enabled{true};
+    return enabled;
+}
 
-template <class It1, class It2, class Cmp>
-struct LexicographicalCompare : Dispatchable<LexicographicalCompare<It1, It2, Cmp>> {
-    Partition<It1> m_partition1;
-    Partition<It2> m_partition2;
-    Cmp m_cmp;
-    MinIteratorResult<It1> m_result1;
-    MinIteratorResult<It2> m_result2;
+// The blocks of huge_page_threshold bytes and more are mapped directly, in multiples of the huge
+// page size, and bypass the cache. A power-of-two size class could waste almost half of such a
+// block, and a few of them would crowd the smaller ones out of the cache. Both ways are picked by
+// the requested size alone, so a block is released the way it was allocated.
+constexpr size_t huge_page_size = size_t(2) << 20;
+constexpr size_t prefault_stride = 4096;
 
-    LexicographicalCompare(size_t count, size_t chunks, It1 first1, It2 first2, Cmp cmp)
-        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks), m_cmp(cmp),
-          m_result1(m_partition1.end()), m_result2(m_partition2.end())
-    {
-    }
+struct Prefault {
+    char *data;
+    size_t pages;
+    size_t pieces;
 
-    void run(size_t ind) noexcept
+    static void run(void *ctx, size_t ind) noexcept
     {
-        if( ind < m_result1.min_chunk ) {
-            auto p1 = m_partition1.at(ind);
-            auto p2 = m_partition2.at(ind);
-            for( ; p1.first != p1.last; ++p1.first, ++p2.first ) {
-                if( m_cmp(*p1.first, *p2.first) || m_cmp(*p2.first, *p1.first) ) {
-                    m_result1.put(ind, p1.first);
-                    m_result2.put(ind, p2.first);
-                    return;
-                }
-            }
-        }
+        auto &prefault = *static_cast<Prefault *>(ctx);
+        const size_t first = prefault.pages * ind / prefault.pieces;
+        const size_t last = prefault.pages * (ind + 1) / prefault.pieces;
+        for( size_t page = first; page != last; ++page )
+            static_cast<volatile char *>(prefault.data)[page * prefault_stride] = 0;
     }
 };
 
-} // namespace internal
-
-template <class FwdIt1, class FwdIt2, class Cmp>
-bool lexicographical_compare(FwdIt1 first1,
-                             FwdIt1 last1,
-                             FwdIt2 first2,
-                             FwdIt2 last2,
-                             Cmp cmp) noexcept
-{
-    const auto count1 = std::distance(first1, last1);
-    const auto count2 = std::distance(first2, last2);
-    const auto count_min = std::min(count1, count2);
-    const auto chunks = internal::work_chunks_min_fraction_1(count_min);
-    if( chunks > 1 ) {
-        try {
-            internal::LexicographicalCompare<FwdIt1, FwdIt2, Cmp> op{
-                static_cast<size_t>(count_min), chunks, first1, first2, cmp};
-            op.dispatch_apply(chunks);
-            if( static_cast<FwdIt1>(op.m_result1.min) != op.m_partition1.end() )
-                return cmp(*static_cast<FwdIt1>(op.m_result1.min),
-                           *static_cast<FwdIt2>(op.m_result2.min));
-            else
-                return count1 < count2;
-        } catch( const internal::parallelism_exception & ) {
+PSTLD_INTERNAL_IMPL void *map_block(size_t bytes) noexcept
+{
+    #if defined(__APPLE__) || defined(__linux__)
+    // over-map by a huge page and trim the ends to get an aligned block
+    const size_t length = (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+    const size_t padded = length + huge_page_size;
+    void *raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if( raw == MAP_FAILED )
+        return nullptr;
+    const uintptr_t first = reinterpret_cast<uintptr_t>(raw);
+    const uintptr_t aligned = (first + huge_page_size - 1) & ~uintptr_t(huge_page_size - 1);
+    if( aligned != first )
+        munmap(raw, aligned - first);
+    if( aligned + length != first + padded )
+        munmap(reinterpret_cast<void *>(aligned + length), first + padded - aligned - length);
+    char *block = reinterpret_cast<char *>(aligned);
+    if( huge_pages_enabled().load(std::memory_order_relaxed) ) {
+        #if defined(MADV_HUGEPAGE)
+        madvise(block, length, MADV_HUGEPAGE);
+        #endif
+        // Only the pages of the requested bytes are faulted in, the tail of the last huge page is
+        // left to the kernel. A call nested into another parallel one faults the pages in by
+        // itself, an outer one shares them with the helpers available at the moment. This isn't a
+        // call of its own, so it leaves the statistics, the tracing and the partitioner of the
+        // current one be.
+        Prefault prefault{block, (bytes + prefault_stride - 1) / prefault_stride, 1};
+        if( nesting_depth() == 0 ) {
+            Admission admission{max_workers() - 1};
+            prefault.pieces = admission.granted() + 1;
+            if( prefault.pieces > 1 )
+                dispatch_apply_uncapped(prefault.pieces, &prefault, Prefault::run);
         }
+        if( prefault.pieces == 1 )
+            Prefault::run(&prefault, 0);
     }
-    return ::std::lexicographical_compare(first1, last1, first2, last2, cmp);
+    return block;
+    #else
+    return ::operator new(
+        bytes, std::align_val_t{hardware_destructive_interference_size}, std::nothrow);
+    #endif
 }
 
-template <class FwdIt1, class FwdIt2>
-bool lexicographical_compare(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2, FwdIt2 last2) noexcept
+PSTLD_INTERNAL_IMPL void unmap_block(void *block, size_t bytes) noexcept
 {
-    return ::pstld::lexicographical_compare(first1, last1, first2, last2, std::less<>{});
+    #if defined(__APPLE__) || defined(__linux__)
+    munmap(block, (bytes + huge_page_size - 1) & ~(huge_page_size - 1));
+    #else
+    (void)bytes;
+    ::operator delete(block, std::align_val_t{hardware_destructive_interference_size});
+    #endif
 }
 
-//--------------------------------------------------------------------------------------------------
-// uninitialized_construct
-//--------------------------------------------------------------------------------------------------
+// The smaller scratch blocks are rounded up to powers of two, the released ones are kept in a free
+// list per size class, linked through their first word. The cache is plain thread-local data, so
+// it stays usable while the other thread-local objects are destroyed at the thread exit. A reaper
+// created along with the first cached block frees the blocks then and closes the cache, the later
+// releases go straight to the heap.
+struct ScratchCache {
+    static constexpr size_t min_log_size = 6;
+    static constexpr size_t classes = 64;
 
-namespace internal {
+    void *free_lists[classes];
+    size_t cached_bytes;
+    size_t hits;
+    size_t misses;
+    bool armed;
+    bool closed;
 
-template <class It, bool Value>
-struct UninitializedConstruct : Dispatchable<UninitializedConstruct<It, Value>> {
-    Partition<It> m_partition;
+    static size_t class_of(size_t bytes) noexcept
+    {
+        size_t log_size = min_log_size;
+        while( (static_cast<size_t>(1) << log_size) < bytes )
+            ++log_size;
+        return log_size;
+    }
 
-    UninitializedConstruct(size_t count, size_t chunks, It first)
-        : m_partition(first, count, chunks)
+    void release() noexcept
     {
+        for( size_t cls = 0; cls != classes; ++cls )
+            while( void *block = free_lists[cls] ) {
+                free_lists[cls] = *static_cast<void **>(block);
+                ::operator delete(block, std::align_val_t{hardware_destructive_interference_size});
+            }
+        cached_bytes = 0;
     }
+};
 
-    void run(size_t ind) noexcept
+PSTLD_INTERNAL_IMPL ScratchCache &scratch_cache() noexcept
+{
+    static thread_local ScratchCache cache;
+    return cache;
+}
+
+struct ScratchReaper {
+    ~ScratchReaper()
     {
-        auto p = m_partition.at(ind);
-        if constexpr( Value )
-            std::uninitialized_value_construct(p.first, p.last);
-        else
-            std::uninitialized_default_construct(p.first, p.last);
+        auto &cache = scratch_cache();
+        cache.release();
+        cache.closed = true;
     }
 };
 
-} // namespace internal
+PSTLD_INTERNAL_IMPL void *scratch_allocate(size_t bytes) noexcept
+{
+    auto &cache = scratch_cache();
+    if( bytes >= huge_page_threshold ) {
+        ++cache.misses;
+        return map_block(bytes);
+    }
+    const size_t cls = ScratchCache::class_of(bytes);
+    bytes = static_cast<size_t>(1) << cls;
+    if( void *block = cache.free_lists[cls] ) {
+        ++cache.hits;
+        cache.cached_bytes -= bytes;
+        cache.free_lists[cls] = *static_cast<void **>(block);
+        return block;
+    }
+    ++cache.misses;
+    return ::operator new(
+        bytes, std::align_val_t{hardware_destructive_interference_size}, std::nothrow);
+}
 
-template <class FwdIt>
-void uninitialized_default_construct(FwdIt first, FwdIt last) noexcept
+PSTLD_INTERNAL_IMPL void scratch_deallocate(void *ptr, size_t bytes) noexcept
 {
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::UninitializedConstruct<FwdIt, false> op{
-                static_cast<size_t>(count), chunks, first};
-            op.dispatch_apply(chunks);
-            return;
-        } catch( const internal::parallelism_exception & ) {
+    if( bytes >= huge_page_threshold ) {
+        unmap_block(ptr, bytes);
+        return;
+    }
+    auto &cache = scratch_cache();
+    const size_t cls = ScratchCache::class_of(bytes);
+    bytes = static_cast<size_t>(1) << cls;
+    if( !cache.closed && cache.cached_bytes + bytes <= scratch_cache_limit ) {
+        if( !cache.armed ) {
+            static thread_local ScratchReaper reaper;
+            cache.armed = true;
         }
+        *static_cast<void **>(ptr) = cache.free_lists[cls];
+        cache.free_lists[cls] = ptr;
+        cache.cached_bytes += bytes;
+        return;
     }
-    return std::uninitialized_default_construct(first, last);
+    ::operator delete(ptr, std::align_val_t{hardware_destructive_interference_size});
 }
 
-template <class FwdIt, class Size>
-FwdIt uninitialized_default_construct_n(FwdIt first, Size count) noexcept
+struct AdmissionControl {
+    std::atomic<size_t> busy{0};
+    std::atomic<size_t> requests{0};
+    std::atomic<size_t> granted{0};
+    std::atomic<size_t> reduced{0};
+    std::atomic<size_t> serialized{0};
+};
+
+PSTLD_INTERNAL_IMPL AdmissionControl &admission_control() noexcept
 {
-    if( count < 1 )
-        return first;
+    static AdmissionControl control;
+    return control;
+}
 
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::UninitializedConstruct<FwdIt, false> op{
-                static_cast<size_t>(count), chunks, first};
-            op.dispatch_apply(chunks);
-            return op.m_partition.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::uninitialized_default_construct_n(first, count);
+PSTLD_INTERNAL_IMPL size_t admission_budget() noexcept
+{
+    return max_hw_threads() - 1;
 }
 
-template <class FwdIt>
-void uninitialized_value_construct(FwdIt first, FwdIt last) noexcept
+PSTLD_INTERNAL_IMPL size_t admit(size_t helpers) noexcept
 {
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::UninitializedConstruct<FwdIt, true> op{
-                static_cast<size_t>(count), chunks, first};
-            op.dispatch_apply(chunks);
-            return;
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::uninitialized_value_construct(first, last);
+    if( helpers == 0 )
+        return 0;
+    auto &control = admission_control();
+    const size_t budget = admission_budget();
+    size_t busy = control.busy.load(std::memory_order_relaxed);
+    size_t granted = 0;
+    do {
+        granted = std::min(helpers, busy < budget ? budget - busy : 0);
+    } while( granted != 0 &&
+             !control.busy.compare_exchange_weak(busy, busy + granted, std::memory_order_relaxed) );
+    control.requests.fetch_add(1, std::memory_order_relaxed);
+    auto &outcome = granted == helpers ? control.granted
+                    : granted == 0     ? control.serialized
+                                       : control.reduced;
+    outcome.fetch_add(1, std::memory_order_relaxed);
+    return granted;
 }
 
-template <class FwdIt, class Size>
-FwdIt uninitialized_value_construct_n(FwdIt first, Size count) noexcept
+PSTLD_INTERNAL_IMPL void dismiss(size_t helpers) noexcept
 {
-    if( count < 1 )
-        return first;
+    if( helpers != 0 )
+        admission_control().busy.fetch_sub(helpers, std::memory_order_relaxed);
+}
 
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::UninitializedConstruct<FwdIt, true> op{
-                static_cast<size_t>(count), chunks, first};
-            op.dispatch_apply(chunks);
-            return op.m_partition.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
+PSTLD_INTERNAL_IMPL size_t admissible_workers(size_t workers) noexcept
+{
+    if( workers < 2 || current_executor() != nullptr )
+        return workers;
+    auto &control = admission_control();
+    const size_t budget = admission_budget();
+    const size_t busy = control.busy.load(std::memory_order_relaxed);
+    if( busy >= budget ) {
+        control.requests.fetch_add(1, std::memory_order_relaxed);
+        control.serialized.fetch_add(1, std::memory_order_relaxed);
+        return 1;
     }
-    return std::uninitialized_value_construct_n(first, count);
+    return std::min(workers, budget - busy + 1);
 }
 
-//--------------------------------------------------------------------------------------------------
-// uninitialized_copy, uninitialized_move
-//--------------------------------------------------------------------------------------------------
-
-namespace internal {
+PSTLD_INTERNAL_IMPL void
+dispatch_apply(size_t iterations, void *ctx, void (*function)(void *, size_t)) noexcept
+{
+    if( iterations == 0 )
+        return;
+    const size_t limit = worker_limit();
+    const size_t wanted = std::min(iterations, max_workers());
+    Admission admission{wanted - 1};
+    const size_t granted = admission.granted() + 1;
+    mark_parallel();
+    #if defined(PSTLD_TRACING)
+    trace_workers(current_trace_call(), granted);
+    #endif
+    const CallOptions *options = call_options();
+    const size_t flags_size = iterations * sizeof(std::atomic<bool>);
+    if( void *flags = options && options->affinity ? scratch_allocate(flags_size) : nullptr ) {
+        auto claimed = static_cast<std::atomic<bool> *>(flags);
+        std::uninitialized_fill_n(claimed, iterations, false);
+        AffinityLanes lanes{ctx, function, iterations, limit, *options->affinity, claimed};
+        if( granted == 1 )
+            AffinityLanes::run(&lanes, 0);
+        else
+            dispatch_apply_uncapped(granted, &lanes, AffinityLanes::run);
+        scratch_deallocate(flags, flags_size);
+        return;
+    }
+    Lanes lanes{ctx, function, iterations, limit};
+    if( granted == wanted && limit == std::numeric_limits<size_t>::max() )
+        dispatch_apply_uncapped(iterations, &lanes, Lanes::run_one);
+    else if( granted == 1 )
+        Lanes::run(&lanes, 0);
+    else
+        dispatch_apply_uncapped(granted, &lanes, Lanes::run);
+}
 
-template <class It1, class It2, bool Copy>
-struct UninitializedCopyMove : Dispatchable<UninitializedCopyMove<It1, It2, Copy>> {
-    Partition<It1> m_partition1;
-    Partition<It2> m_partition2;
+PSTLD_INTERNAL_IMPL void dispatch_async(void *ctx, void (*function)(void *)) noexcept
+{
+    if( const executor *e = current_executor() )
+        e->async(e->context, ctx, function);
+    else
+        backend_dispatch_async(ctx, function);
+}
 
-    UninitializedCopyMove(size_t count, size_t chunks, It1 first1, It2 first2)
-        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks)
-    {
-    }
+struct DispatchGroup::ExecutorTask {
+    DispatchGroup *group;
+    void *ctx;
+    void (*function)(void *);
 
-    void run(size_t ind) noexcept
+    static void run(void *me_ptr) noexcept
     {
-        auto p1 = m_partition1.at(ind);
-        auto p2 = m_partition2.at(ind);
-        if constexpr( Copy )
-            std::uninitialized_copy(p1.first, p1.last, p2.first);
-        else
-            std::uninitialized_move(p1.first, p1.last, p2.first);
+        auto me = static_cast<ExecutorTask *>(me_ptr);
+        auto group = me->group;
+        me->function(me->ctx);
+        scratch_deallocate(me, sizeof(ExecutorTask));
+        // decremented under the lock, otherwise the waiter could observe zero, return and destroy
+        // the group before it's notified
+        std::lock_guard lock{group->m_executor_mut};
+        if( group->m_pending.fetch_sub(1) == 1 )
+            group->m_executor_cv.notify_all();
     }
 };
 
-} // namespace internal
-
-template <class FwdIt1, class FwdIt2>
-FwdIt2 uninitialized_copy(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+PSTLD_INTERNAL_IMPL void DispatchGroup::dispatch_executor(void *ctx,
+                                                          void (*function)(void *)) noexcept
 {
-    const auto count = std::distance(first1, last1);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::UninitializedCopyMove<FwdIt1, FwdIt2, true> op{
-                static_cast<size_t>(count), chunks, first1, first2};
-            op.dispatch_apply(chunks);
-            return op.m_partition2.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
+    void *buffer = scratch_allocate(sizeof(ExecutorTask));
+    if( buffer == nullptr ) {
+        // can't allocate a trampoline - execute in-place instead
+        function(ctx);
+        return;
     }
-    return std::uninitialized_copy(first1, last1, first2);
+    auto task = ::new(buffer) ExecutorTask{this, ctx, function};
+    m_pending.fetch_add(1);
+    m_executor->async(m_executor->context, task, ExecutorTask::run);
 }
 
-template <class FwdIt1, class Size, class FwdIt2>
-FwdIt2 uninitialized_copy_n(FwdIt1 first1, Size count, FwdIt2 first2) noexcept
+PSTLD_INTERNAL_IMPL void DispatchGroup::wait_executor() noexcept
 {
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::UninitializedCopyMove<FwdIt1, FwdIt2, true> op{
-                static_cast<size_t>(count), chunks, first1, first2};
-            op.dispatch_apply(chunks);
-            return op.m_partition2.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::uninitialized_copy_n(first1, count, first2);
+    std::unique_lock lock{m_executor_mut};
+    m_executor_cv.wait(lock, [this] { return m_pending.load() == 0; });
 }
 
-template <class FwdIt1, class FwdIt2>
-FwdIt2 uninitialized_move(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
-{
-    const auto count = std::distance(first1, last1);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::UninitializedCopyMove<FwdIt1, FwdIt2, false> op{
-                static_cast<size_t>(count), chunks, first1, first2};
-            op.dispatch_apply(chunks);
-            return op.m_partition2.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
+struct TaskTeam {
+    struct Task {
+        void (*function)(void *);
+        void *ctx;
+        task_group *group;
+    };
+
+    WorkStealingTeam<Task> team{max_workers()};
+    DispatchGroup dg;
+    std::optional<Admission> admission; // the helpers taken for the current round, until wait()
+
+    void execute(const Task &task) noexcept
+    {
+        task.function(task.ctx);
+        // the group can be gone right after the decrement, but the team is still alive since
+        // its root group waits for all workers to leave
+        if( task.group->m_pending.fetch_sub(1) == 1 )
+            team.notify_all();
     }
-    return std::uninitialized_move(first1, last1, first2);
+
+    static void dispatch(void *ctx) noexcept;
+};
+
+// The team the current thread works for and its index in that team, if any.
+struct TaskWorker {
+    TaskTeam *team = nullptr;
+    size_t index = 0;
+};
+
+PSTLD_INTERNAL_IMPL TaskWorker &current_task_worker() noexcept
+{
+    static thread_local TaskWorker worker;
+    return worker;
 }
 
-template <class FwdIt1, class Size, class FwdIt2>
-std::pair<FwdIt1, FwdIt2> uninitialized_move_n(FwdIt1 first1, Size count, FwdIt2 first2) noexcept
+PSTLD_INTERNAL_IMPL void TaskTeam::dispatch(void *ctx) noexcept
 {
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::UninitializedCopyMove<FwdIt1, FwdIt2, false> op{
-                static_cast<size_t>(count), chunks, first1, first2};
-            op.dispatch_apply(chunks);
-            return {op.m_partition1.end(), op.m_partition2.end()};
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::uninitialized_move_n(first1, count, first2);
+    auto me = static_cast<TaskTeam *>(ctx);
+    const TaskWorker outer = current_task_worker();
+    // A thread waiting for something inside one of the team's tasks can pick up a helper which
+    // hasn't started yet. It's a member of the team already and must not block on the team's
+    // completion, which depends on the very task it's waiting in.
+    if( outer.team == me )
+        return;
+    const size_t index = me->team.next_worker_index();
+    current_task_worker() = {me, index};
+    me->team.work(
+        index, [me](const Task &task) { me->execute(task); }, [] { return false; });
+    current_task_worker() = outer;
 }
 
-//--------------------------------------------------------------------------------------------------
-// uninitialized_fill
-//--------------------------------------------------------------------------------------------------
+struct alignas(hardware_destructive_interference_size) EpochSlot {
+    static constexpr size_t unpinned = std::numeric_limits<size_t>::max();
 
-namespace internal {
+    std::atomic<size_t> epoch{unpinned};
+    std::atomic<bool> in_use{true};
+    size_t depth = 0; // only touched by the owning thread
+    EpochSlot *next = nullptr;
+};
 
-template <class It, class T>
-struct UninitializedFill : Dispatchable<UninitializedFill<It, T>> {
-    Partition<It> m_partition;
-    const T &m_val;
+struct EpochDomain {
+    std::atomic<size_t> epoch{0};
+    std::atomic<EpochSlot *> slots{nullptr}; // never shrinks, slots of exited threads get reused
+    std::atomic<size_t> retired_count{0};    // allows to skip locking when nothing was retired
+    std::mutex retired_mut;
+    EpochRetired *retired = nullptr;
 
-    UninitializedFill(size_t count, size_t chunks, It first, const T &val)
-        : m_partition(first, count, chunks), m_val(val)
+    EpochSlot *acquire_slot()
     {
+        for( EpochSlot *slot = slots.load(std::memory_order_acquire); slot; slot = slot->next ) {
+            bool in_use = false;
+            if( slot->in_use.compare_exchange_strong(in_use, true) )
+                return slot;
+        }
+        auto slot = new EpochSlot;
+        slot->next = slots.load(std::memory_order_relaxed);
+        while( !slots.compare_exchange_weak(slot->next, slot) )
+            ;
+        return slot;
     }
 
-    void run(size_t ind) noexcept
+    // Moves the global epoch forward if every pinned thread has already observed the current one.
+    bool try_advance() noexcept
     {
-        auto p = m_partition.at(ind);
-        std::uninitialized_fill(p.first, p.last, m_val);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        size_t current = epoch.load(std::memory_order_relaxed);
+        for( EpochSlot *slot = slots.load(std::memory_order_acquire); slot; slot = slot->next ) {
+            const size_t pinned = slot->epoch.load(std::memory_order_relaxed);
+            if( pinned != EpochSlot::unpinned && pinned != current )
+                return false;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return epoch.compare_exchange_strong(current, current + 1);
+    }
+
+    // Must be called with retired_mut held.
+    void reclaim() noexcept
+    {
+        for( int advances = 0; advances != 2 && try_advance(); ++advances )
+            ;
+        const size_t current = epoch.load();
+        EpochRetired **link = &retired;
+        while( *link != nullptr ) {
+            EpochRetired *node = *link;
+            if( node->retired_epoch + 2 <= current ) {
+                *link = node->retired_next;
+                node->deleter(node);
+                retired_count.fetch_sub(1, std::memory_order_relaxed);
+            }
+            else {
+                link = &node->retired_next;
+            }
+        }
     }
 };
 
-} // namespace internal
-
-template <class FwdIt, class T>
-void uninitialized_fill(FwdIt first, FwdIt last, const T &val) noexcept
+PSTLD_INTERNAL_IMPL EpochDomain &epoch_domain() noexcept
 {
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::UninitializedFill<FwdIt, T> op{
-                static_cast<size_t>(count), chunks, first, val};
-            op.dispatch_apply(chunks);
-            return;
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::uninitialized_fill(first, last, val);
+    // intentionally leaked - pool workers may still be stealing while static destructors run
+    static EpochDomain *const domain = new EpochDomain;
+    return *domain;
 }
 
-template <class FwdIt, class Size, class T>
-FwdIt uninitialized_fill_n(FwdIt first, Size count, const T &val) noexcept
+PSTLD_INTERNAL_IMPL EpochSlot &epoch_slot() noexcept
 {
-    if( count < 1 )
-        return first;
+    struct Owner {
+        EpochSlot *slot = epoch_domain().acquire_slot();
+        ~Owner() { slot->in_use.store(false, std::memory_order_release); }
+    };
+    static thread_local Owner owner;
+    return *owner.slot;
+}
 
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::UninitializedFill<FwdIt, T> op{
-                static_cast<size_t>(count), chunks, first, val};
-            op.dispatch_apply(chunks);
-            return op.m_partition.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
+PSTLD_INTERNAL_IMPL EpochPin::EpochPin() noexcept : m_slot(&epoch_slot())
+{
+    if( m_slot->depth++ == 0 ) {
+        m_slot->epoch.store(epoch_domain().epoch.load(std::memory_order_relaxed),
+                            std::memory_order_relaxed);
+        // the pin must be visible before the protected pointer is read
+        std::atomic_thread_fence(std::memory_order_seq_cst);
     }
-    return std::uninitialized_fill_n(first, count, val);
 }
 
-//--------------------------------------------------------------------------------------------------
-// destroy
-//--------------------------------------------------------------------------------------------------
+PSTLD_INTERNAL_IMPL EpochPin::~EpochPin()
+{
+    if( --m_slot->depth == 0 )
+        m_slot->epoch.store(EpochSlot::unpinned, std::memory_order_release);
+}
 
-namespace internal {
+PSTLD_INTERNAL_IMPL void epoch_retire(EpochRetired *retired) noexcept
+{
+    auto &domain = epoch_domain();
+    std::lock_guard lock{domain.retired_mut};
+    retired->retired_epoch = domain.epoch.load();
+    retired->retired_next = domain.retired;
+    domain.retired = retired;
+    domain.retired_count.fetch_add(1, std::memory_order_relaxed);
+    domain.reclaim();
+}
 
-template <class It>
-struct Destroy : Dispatchable<Destroy<It>> {
-    Partition<It> m_partition;
+PSTLD_INTERNAL_IMPL void epoch_collect() noexcept
+{
+    auto &domain = epoch_domain();
+    if( domain.retired_count.load(std::memory_order_relaxed) == 0 )
+        return;
+    std::lock_guard lock{domain.retired_mut};
+    domain.reclaim();
+}
+
+// The memory of the flags which an affinity partitioner needs to hand out 'chunks' chunks.
+PSTLD_INTERNAL_IMPL size_t affinity_bytes(size_t chunks) noexcept
+{
+    const CallOptions *options = call_options();
+    return options != nullptr && options->affinity != nullptr ? chunks * sizeof(std::atomic<bool>)
+                                                              : 0;
+}
+
+// A call which splits the range into chunks upfront and keeps 'result_bytes' per chunk.
+PSTLD_INTERNAL_IMPL plan
+explain_chunks(size_t count, size_t min_chunk, size_t cost, size_t result_bytes) noexcept
+{
+    plan p;
+    const size_t workers = max_workers();
+    const size_t chunks = worth_parallel(count, cost) ? split_chunks(count, min_chunk, workers) : 0;
+    if( chunks < 2 )
+        return p;
+    p.parallel = true;
+    p.chunks = chunks;
+    p.chunk_min = count / chunks;
+    p.chunk_max = p.chunk_min + (count % chunks != 0);
+    p.workers = std::min(chunks, workers);
+    p.scratch_bytes = chunks * result_bytes + affinity_bytes(chunks);
+    return p;
+}
+
+// A call bounded by a deadline, which runs its chunks one after another if it isn't parallel.
+PSTLD_INTERNAL_IMPL plan
+explain_bounded(size_t count, size_t min_chunk, size_t result_bytes) noexcept
+{
+    plan p = explain_chunks(count, min_chunk, cost_invoke, result_bytes);
+    if( p.parallel ) {
+        p.scratch_bytes += p.chunks; // the flags of the started chunks
+        return p;
+    }
+    p.chunks = bounded_chunks(count, min_chunk, 0);
+    if( p.chunks == 0 )
+        return p;
+    p.chunk_min = count / p.chunks;
+    p.chunk_max = p.chunk_min + (count % p.chunks != 0);
+    p.scratch_bytes = p.chunks * (1 + result_bytes);
+    return p;
+}
+
+// A call which splits the range as it goes by a team of workers stealing the work from each other.
+template <class Work>
+plan explain_team(bool parallel) noexcept
+{
+    plan p;
+    if( !parallel || max_workers() < 2 ) // runs inline without helpers
+        return p;
+    p.parallel = true;
+    p.workers = max_workers();
+    const size_t array_bytes = CircularArray<Work>::bytes(CircularArray<Work>::default_log_size);
+    p.scratch_bytes =
+        p.workers * (sizeof(CircularWorkStealingDeque<Work>) + array_bytes + sizeof(WorkCounter));
+    return p;
+}
+
+PSTLD_INTERNAL_IMPL plan
+explain_call(algorithm a, size_t count, size_t value_size, size_t value_align) noexcept
+{
+    using SortWork = Sort<char *, std::less<>>::Work;
+    using MergeWork = Merge<char *, char *, char *, std::less<>>::Work;
+    switch( a ) {
+        case algorithm::adjacent_difference:
+            return count > 2 ? explain_chunks(count - 1, 1, cost_invoke, 0) : plan{};
+        case algorithm::adjacent_find:
+            return count > 1 ? explain_chunks(count - 1, 1, cost_compare, 0) : plan{};
+        case algorithm::is_sorted:
+        case algorithm::is_sorted_until:
+            return count > 2 ? explain_chunks(count - 1, 1, cost_compare, 0) : plan{};
+        case algorithm::reverse:
+            return count > 3 ? explain_chunks(count / 2, 1, cost_copy, 0) : plan{};
+        case algorithm::all_of:
+        case algorithm::any_of:
+        case algorithm::count_if:
+        case algorithm::find_if:
+        case algorithm::for_each:
+        case algorithm::for_each_n:
+        case algorithm::generate:
+        case algorithm::generate_n:
+        case algorithm::is_partitioned:
+        case algorithm::none_of:
+        case algorithm::transform:
+            return explain_chunks(count, 1, cost_invoke, 0);
+        case algorithm::equal:
+        case algorithm::find_end:
+        case algorithm::lexicographical_compare:
+        case algorithm::mismatch:
+        case algorithm::search:
+        case algorithm::search_n:
+            return explain_chunks(count, 1, cost_compare, 0);
+        case algorithm::copy:
+        case algorithm::copy_n:
+        case algorithm::destroy:
+        case algorithm::destroy_n:
+        case algorithm::fill:
+        case algorithm::fill_n:
+        case algorithm::move:
+        case algorithm::swap_ranges:
+        case algorithm::uninitialized_copy:
+        case algorithm::uninitialized_copy_n:
+        case algorithm::uninitialized_default_construct:
+        case algorithm::uninitialized_default_construct_n:
+        case algorithm::uninitialized_fill:
+        case algorithm::uninitialized_fill_n:
+        case algorithm::uninitialized_move:
+        case algorithm::uninitialized_move_n:
+        case algorithm::uninitialized_value_construct:
+        case algorithm::uninitialized_value_construct_n:
+            return explain_chunks(count, 1, cost_copy, 0);
+        case algorithm::min_element:
+        case algorithm::max_element:
+            return explain_chunks(count, 2, cost_compare, sizeof(char *));
+        case algorithm::minmax_element:
+            return explain_chunks(count, 2, cost_compare, 2 * sizeof(char *));
+        case algorithm::transform_reduce:
+        case algorithm::transform_inclusive_scan:
+        case algorithm::transform_exclusive_scan:
+            return explain_chunks(count, 2, cost_invoke, value_size);
+        case algorithm::copy_if: {
+            // the chunks keep their counts of matches, their positions in the output and their
+            // words of the bitmask
+            plan p = explain_chunks(count, 2, cost_invoke, sizeof(size_t) + sizeof(char *));
+            if( p.parallel )
+                p.scratch_bytes += p.chunks * sizeof(uint64_t) *
+                                   CopyIf<char *, char *, no_op>::words(count, p.chunks);
+            return p;
+        }
+        case algorithm::bounded_count_if:
+        case algorithm::bounded_find_if:
+            return explain_bounded(count, 1, 0);
+        case algorithm::bounded_transform_reduce:
+            // the results are kept as std::optional<T>
+            return explain_bounded(count, 2, value_size + value_align);
+        case algorithm::sort:
+            return explain_team<SortWork>(count > insertion_sort_limit &&
+                                          worth_parallel(count, cost_sort_level * log2(count)));
+        case algorithm::merge:
+            return explain_team<MergeWork>(count > merge_parallel_limit &&
+                                           worth_parallel(count, cost_compare));
+        case algorithm::stable_sort: {
+            plan p;
+            if( count <= insertion_sort_limit * 4 ||
+                !worth_parallel(count, cost_sort_level * log2(count)) || max_workers() < 2 )
+                return p;
+            p.parallel = true;
+            p.tree_height = stable_sort_tree_height(count);
+            p.chunks = size_t(1) << p.tree_height;
+            p.chunk_min = count / p.chunks;
+            p.chunk_max = p.chunk_min + (count % p.chunks != 0);
+            p.workers = max_workers();
+            p.scratch_bytes = count * value_size + p.chunks * sizeof(std::atomic<bool>);
+            return p;
+        }
+    }
+    return {};
+}
 
-    Destroy(size_t count, size_t chunks, It first) : m_partition(first, count, chunks) {}
+PSTLD_INTERNAL_IMPL const char *parallelism_exception::what() const noexcept
+{
+    return "Failed to acquire resources to perform parallel computation";
+}
 
-    void run(size_t ind) noexcept
-    {
-        auto p = m_partition.at(ind);
-        std::destroy(p.first, p.last);
-    }
+PSTLD_INTERNAL_IMPL void parallelism_exception::raise()
+{
+    throw parallelism_exception{};
 };
 
 } // namespace internal
 
-template <class FwdIt>
-void destroy(FwdIt first, FwdIt last) noexcept
+PSTLD_INTERNAL_IMPL task_group::~task_group()
 {
-    const auto count = std::distance(first, last);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
+    wait();
+    delete m_own_team;
+}
+
+PSTLD_INTERNAL_IMPL bool task_group::start_team() noexcept
+{
+    if( m_own_team == nullptr ) {
         try {
-            internal::Destroy<FwdIt> op{static_cast<size_t>(count), chunks, first};
-            op.dispatch_apply(chunks);
-            return;
+            m_own_team = new(std::nothrow) internal::TaskTeam;
         } catch( const internal::parallelism_exception & ) {
         }
+        if( m_own_team == nullptr )
+            return false;
     }
-    return std::destroy(first, last);
+    else {
+        m_own_team->team.reset();
+    }
+
+    m_team = m_own_team;
+    const size_t workers = std::min(internal::max_workers(), m_team->team.workers());
+    const size_t helpers = m_team->admission.emplace(workers - 1).granted();
+    internal::current_task_worker() = {m_team, 0};
+    for( size_t i = 0; i != helpers; ++i )
+        m_team->dg.dispatch(static_cast<void *>(m_team), internal::TaskTeam::dispatch);
+    return true;
 }
 
-template <class FwdIt, class Size>
-FwdIt destroy_n(FwdIt first, Size count) noexcept
+PSTLD_INTERNAL_IMPL void task_group::spawn(void *ctx, void (*function)(void *)) noexcept
 {
-    if( count < 1 )
-        return first;
-
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Destroy<FwdIt> op{static_cast<size_t>(count), chunks, first};
-            op.dispatch_apply(chunks);
-            return op.m_partition.end();
-        } catch( const internal::parallelism_exception & ) {
+    const internal::TaskWorker current = internal::current_task_worker();
+    if( m_team == nullptr ) {
+        if( current.team != nullptr ) {
+            // nested into a task or into another group of this thread - join its team
+            m_team = current.team;
+        }
+        else if( !start_team() ) {
+            function(ctx);
+            return;
         }
     }
-    return std::destroy_n(first, count);
-}
 
-//--------------------------------------------------------------------------------------------------
-// move
-//--------------------------------------------------------------------------------------------------
+    const internal::TaskWorker worker = internal::current_task_worker();
+    if( worker.team != m_team ) {
+        // the calling thread doesn't work for the team and can't queue anything - execute in-place
+        function(ctx);
+        return;
+    }
 
-namespace internal {
+    m_pending.fetch_add(1);
+    if( !m_team->team.fork(worker.index, {function, ctx, this}) ) {
+        m_pending.fetch_sub(1);
+        function(ctx);
+    }
+}
 
-template <class It1, class It2>
-struct Move : Dispatchable<Move<It1, It2>> {
-    Partition<It1> m_partition1;
-    Partition<It2> m_partition2;
+PSTLD_INTERNAL_IMPL void task_group::wait() noexcept
+{
+    if( m_team == nullptr )
+        return;
 
-    Move(size_t count, size_t chunks, It1 first1, It2 first2)
-        : m_partition1(first1, count, chunks), m_partition2(first2, count, chunks)
-    {
+    const internal::TaskWorker worker = internal::current_task_worker();
+    if( worker.team == m_team ) {
+        internal::TaskTeam *team = m_team;
+        team->team.work(
+            worker.index,
+            [team](const internal::TaskTeam::Task &task) { team->execute(task); },
+            [this] { return m_pending.load() == 0; });
+    }
+    else {
+        while( m_pending.load() != 0 ) {
+            internal::count_yield();
+            std::this_thread::yield();
+        }
     }
 
-    void run(size_t ind) noexcept
-    {
-        auto p1 = m_partition1.at(ind);
-        auto p2 = m_partition2.at(ind);
-        std::move(p1.first, p1.last, p2.first);
+    if( m_team == m_own_team ) {
+        // the root group of the team - release the helpers
+        m_team->team.finish();
+        m_team->dg.wait();
+        m_team->admission.reset();
+        if( worker.team == m_team )
+            internal::current_task_worker() = {};
     }
-};
+    m_team = nullptr;
+}
 
-} // namespace internal
+PSTLD_INTERNAL_IMPL arena::scope::scope(const arena &a) noexcept
+    : m_previous(internal::arena_limit())
+{
+    internal::arena_limit() = std::min(m_previous, a.workers());
+}
 
-template <class FwdIt1, class FwdIt2>
-FwdIt2 move(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2) noexcept
+PSTLD_INTERNAL_IMPL arena::scope::~scope()
 {
-    const auto count = std::distance(first1, last1);
-    const auto chunks = internal::work_chunks_min_fraction_1(count);
-    if( chunks > 1 ) {
-        try {
-            internal::Move<FwdIt1, FwdIt2> op{static_cast<size_t>(count), chunks, first1, first2};
-            op.dispatch_apply(chunks);
-            return op.m_partition2.end();
-        } catch( const internal::parallelism_exception & ) {
-        }
-    }
-    return std::move(first1, last1, first2);
+    internal::arena_limit() = m_previous;
 }
 
-#if defined(PSTLD_INTERNAL_ARC)
-} // inline namespace arc
-#endif
+PSTLD_INTERNAL_IMPL void set_default_executor(const executor *e) noexcept
+{
+    internal::default_executor_storage().store(e, std::memory_order_release);
+}
 
-} // namespace pstld
+PSTLD_INTERNAL_IMPL const executor *default_executor() noexcept
+{
+    return internal::default_executor_storage().load(std::memory_order_acquire);
+}
 
-//--------------------------------------------------------------------------------------------------
-//
-// System-specific implementation details
-//
-//--------------------------------------------------------------------------------------------------
+PSTLD_INTERNAL_IMPL cpu_topology topology() noexcept
+{
+    auto &cache = internal::topology_cache();
+    std::lock_guard lock{cache.mutex};
+    return cache.topology;
+}
 
-#if defined(PSTLD_INTERNAL_HEADER_ONLY) || defined(PSTLD_INTERNAL_IMPLEMENTATION_FILE)
+PSTLD_INTERNAL_IMPL cpu_topology refresh_topology() noexcept
+{
+    const cpu_topology topology = internal::discover_topology();
+    auto &cache = internal::topology_cache();
+    std::lock_guard lock{cache.mutex};
+    cache.topology = topology;
+    cache.workers.store(topology.workers, std::memory_order_relaxed);
+    return topology;
+}
 
-    #include <sys/types.h>
-    #include <sys/sysctl.h>
-    #include <dispatch/dispatch.h>
+PSTLD_INTERNAL_IMPL cost_profile current_cost_profile() noexcept
+{
+    cost_profile profile;
+    profile.fork_join_ns = internal::fork_join_overhead_ns();
+    return profile;
+}
 
-namespace pstld {
+PSTLD_INTERNAL_IMPL void set_cost_profile(const cost_profile &profile) noexcept
+{
+    internal::install_cost_profile(profile, false);
+}
 
-    #if defined(PSTLD_INTERNAL_ARC)
-inline namespace arc {
-    #endif
+PSTLD_INTERNAL_IMPL cost_profile calibrate_cost_profile() noexcept
+{
+    cost_profile profile;
+    profile.fork_join_ns = internal::measure_fork_join_ns();
+    internal::install_cost_profile(profile, false);
+    return profile;
+}
 
-namespace internal {
+PSTLD_INTERNAL_IMPL bool save_cost_profile(const char *path) noexcept
+{
+    return internal::write_cost_profile(path, current_cost_profile(), false);
+}
 
-PSTLD_INTERNAL_IMPL size_t max_hw_threads() noexcept
+PSTLD_INTERNAL_IMPL bool load_cost_profile(const char *path) noexcept
 {
-    static const size_t threads = [] {
-        int count;
-        size_t count_len = sizeof(count);
-        sysctlbyname("hw.physicalcpu_max", &count, &count_len, nullptr, 0);
-        return static_cast<size_t>(count);
-    }();
-    return threads;
+    cost_profile profile;
+    if( !internal::read_cost_profile(path, profile) )
+        return false;
+    set_cost_profile(profile);
+    return true;
 }
 
-PSTLD_INTERNAL_IMPL void
-dispatch_apply(size_t iterations, void *ctx, void (*function)(void *, size_t)) noexcept
+PSTLD_INTERNAL_IMPL scratch_counters scratch_stats() noexcept
 {
-    #pragma clang diagnostic push
-    #pragma clang diagnostic ignored "-Wnullability-extension"
-    #if DISPATCH_APPLY_AUTO_AVAILABLE
-        ::dispatch_apply_f(iterations, DISPATCH_APPLY_AUTO, ctx, function);
-    #else
-        ::dispatch_apply_f(iterations, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ctx, function);
-    #endif
-    #pragma clang diagnostic pop
+    const auto &cache = internal::scratch_cache();
+    scratch_counters counters;
+    counters.hits = cache.hits;
+    counters.misses = cache.misses;
+    counters.cached_bytes = cache.cached_bytes;
+    return counters;
 }
 
-PSTLD_INTERNAL_IMPL void dispatch_async(void *ctx, void (*function)(void *)) noexcept
+PSTLD_INTERNAL_IMPL void release_scratch() noexcept
 {
-    ::dispatch_async_f(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ctx, function);
+    internal::scratch_cache().release();
 }
 
-PSTLD_INTERNAL_IMPL DispatchGroup::DispatchGroup() noexcept
-    : m_group(dispatch_group_create()), m_queue(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0))
+PSTLD_INTERNAL_IMPL affinity_partitioner::affinity_partitioner()
+    : m_map(std::make_shared<internal::AffinityMap>())
 {
 }
 
-PSTLD_INTERNAL_IMPL DispatchGroup::~DispatchGroup()
+PSTLD_INTERNAL_IMPL void affinity_partitioner::clear() noexcept
 {
-    #if !defined(PSTLD_INTERNAL_ARC)
-    ::dispatch_release(static_cast<dispatch_group_t>(m_group));
-    #endif
+    m_map->clear();
 }
 
-PSTLD_INTERNAL_IMPL void DispatchGroup::dispatch(void *ctx, void (*function)(void *)) noexcept
+PSTLD_INTERNAL_IMPL void set_huge_pages(bool enabled) noexcept
 {
-    ::dispatch_group_async_f(static_cast<dispatch_group_t>(m_group),
-                             static_cast<dispatch_queue_t>(m_queue),
-                             ctx,
-                             function);
+    internal::huge_pages_enabled().store(enabled, std::memory_order_relaxed);
 }
 
-PSTLD_INTERNAL_IMPL void DispatchGroup::wait() noexcept
+    #if defined(PSTLD_TRACING)
+
+PSTLD_INTERNAL_IMPL void trace::set_hooks(const hooks *h) noexcept
 {
-    ::dispatch_group_wait(static_cast<dispatch_group_t>(m_group), DISPATCH_TIME_FOREVER);
+    internal::trace_hooks_storage().store(h, std::memory_order_release);
 }
 
-PSTLD_INTERNAL_IMPL const char *parallelism_exception::what() const noexcept
+PSTLD_INTERNAL_IMPL void trace::start_recording() noexcept
 {
-    return "Failed to acquire resources to perform parallel computation";
+    internal::trace_recorder().recording.store(true, std::memory_order_relaxed);
 }
 
-PSTLD_INTERNAL_IMPL void parallelism_exception::raise()
+PSTLD_INTERNAL_IMPL void trace::stop_recording() noexcept
 {
-    throw parallelism_exception{};
-};
+    internal::trace_recorder().recording.store(false, std::memory_order_relaxed);
+}
 
-} // namespace internal
+PSTLD_INTERNAL_IMPL bool trace::flush_recording(const char *path) noexcept
+{
+    auto &recorder = internal::trace_recorder();
+    std::lock_guard lock{recorder.flush_mutex};
+    FILE *file = std::fopen(path, "a");
+    if( file == nullptr )
+        return false;
+    std::fseek(file, 0, SEEK_END);
+    // the closing bracket of the array is optional in this format, which lets flushes append
+    bool first = std::ftell(file) == 0;
+    if( first )
+        std::fputs("[\n", file);
+    for( auto ring = recorder.rings.load(std::memory_order_acquire); ring; ring = ring->next ) {
+        const size_t head = ring->head.load(std::memory_order_acquire);
+        for( size_t i = ring->tail.load(std::memory_order_relaxed); i != head; ++i ) {
+            const auto &event = ring->events[i % internal::TraceRing::capacity];
+            const auto us = std::chrono::duration<double, std::micro>(event.time - recorder.origin);
+            std::fprintf(file,
+                         "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%zu,"
+                         "\"args\":{\"%s\":%zu}}",
+                         first ? "" : ",\n",
+                         event.name,
+                         event.phase,
+                         us.count(),
+                         static_cast<size_t>(event.tid),
+                         event.arg_name,
+                         event.arg);
+            first = false;
+        }
+        ring->tail.store(head, std::memory_order_release);
+    }
+    if( const size_t dropped = recorder.dropped.exchange(0, std::memory_order_relaxed) ) {
+        const auto us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() -
+                                                                  recorder.origin);
+        std::fprintf(file,
+                     "%s{\"name\":\"dropped\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,"
+                     "\"tid\":0,\"args\":{\"events\":%zu}}",
+                     first ? "" : ",\n",
+                     us.count(),
+                     dropped);
+    }
+    const bool written = !std::ferror(file);
+    return std::fclose(file) == 0 && written;
+}
+
+    #endif
+
+PSTLD_INTERNAL_IMPL admission_counters admission_stats() noexcept
+{
+    const auto &control = internal::admission_control();
+    admission_counters counters;
+    counters.requests = control.requests.load(std::memory_order_relaxed);
+    counters.granted = control.granted.load(std::memory_order_relaxed);
+    counters.reduced = control.reduced.load(std::memory_order_relaxed);
+    counters.serialized = control.serialized.load(std::memory_order_relaxed);
+    counters.busy_helpers = control.busy.load(std::memory_order_relaxed);
+    counters.budget = internal::admission_budget();
+    return counters;
+}
+
+PSTLD_INTERNAL_IMPL runtime_counters stats() noexcept
+{
+    runtime_counters counters;
+    for( size_t i = 0; i != internal::algorithms_count; ++i )
+        counters.algorithms[i].algorithm = internal::algorithm_names[i];
+    const auto add = [&counters](const internal::StatsBlock &block) {
+        for( size_t i = 0; i != internal::algorithms_count; ++i ) {
+            const auto &from = block.algorithms[i];
+            auto &to = counters.algorithms[i];
+            to.parallel += from.parallel.load(std::memory_order_relaxed);
+            to.serial += from.serial.load(std::memory_order_relaxed);
+            to.fallbacks += from.fallbacks.load(std::memory_order_relaxed);
+            for( size_t j = 0; j != latency_buckets; ++j )
+                to.latency[j] += from.latency[j].load(std::memory_order_relaxed);
+        }
+        counters.steals += block.steals.load(std::memory_order_relaxed);
+        counters.failed_steals += block.failed_steals.load(std::memory_order_relaxed);
+        counters.yields += block.yields.load(std::memory_order_relaxed);
+    };
+    auto &registry = internal::stats_registry();
+    add(registry.shared);
+    for( auto block = registry.blocks.load(std::memory_order_acquire); block != nullptr;
+         block = block->next )
+        add(*block);
+    counters.admission = admission_stats();
+    return counters;
+}
 
     #if defined(PSTLD_INTERNAL_ARC)
 } // inline namespace arc
@@ -3817,23 +9902,15 @@ namespace execution {
 
 class sequenced_policy
 {
-public:
-    static constexpr bool __pstld_enabled = false;
 };
 class parallel_policy
 {
-public:
-    static constexpr bool __pstld_enabled = true;
 };
 class parallel_unsequenced_policy
 {
-public:
-    static constexpr bool __pstld_enabled = true;
 };
 class unsequenced_policy
 {
-public:
-    static constexpr bool __pstld_enabled = false;
 };
 
 inline constexpr sequenced_policy seq;
@@ -3856,16 +9933,37 @@ struct is_execution_policy<parallel_unsequenced_policy> : std::true_type {
 template <>
 struct is_execution_policy<unsequenced_policy> : std::true_type {
 };
+template <class... Properties>
+struct is_execution_policy<::pstld::execution::parallel_policy<Properties...>> : std::true_type {
+};
 
 template <class T>
 inline constexpr bool is_execution_policy_v = is_execution_policy<T>::value;
 
+} // namespace execution
+
+} // namespace std
+
+// The standard parallel policies are accepted by pstld as-is, with no per-call properties
+template <>
+struct pstld::execution::is_execution_policy<std::execution::parallel_policy> : std::true_type {
+};
+template <>
+struct pstld::execution::is_execution_policy<std::execution::parallel_unsequenced_policy>
+    : std::true_type {
+};
+
+namespace std {
+
+namespace execution {
+
 template <class ExPo, class T>
 using __enable_if_execution_policy =
     typename std::enable_if<is_execution_policy<typename std::decay<ExPo>::type>::value, T>::type;
 
 template <class ExPo>
-inline constexpr bool __pstld_enabled = std::remove_reference_t<ExPo>::__pstld_enabled;
+inline constexpr bool __pstld_enabled =
+    ::pstld::execution::is_execution_policy_v<typename std::decay<ExPo>::type>;
 
 } // namespace execution
 
@@ -3873,10 +9971,10 @@ inline constexpr bool __pstld_enabled = std::remove_reference_t<ExPo>::__pstld_e
 
 template <class ExPo, class It, class UnPred>
 execution::__enable_if_execution_policy<ExPo, bool>
-all_of(ExPo &&, It first, It last, UnPred p) noexcept
+all_of(ExPo &&policy, It first, It last, UnPred p) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::all_of(first, last, p);
+        return ::pstld::all_of(policy, first, last, p);
     else
         return ::std::all_of(first, last, p);
 }
@@ -3885,10 +9983,10 @@ all_of(ExPo &&, It first, It last, UnPred p) noexcept
 
 template <class ExPo, class It, class UnPred>
 execution::__enable_if_execution_policy<ExPo, bool>
-any_of(ExPo &&, It first, It last, UnPred p) noexcept
+any_of(ExPo &&policy, It first, It last, UnPred p) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::any_of(first, last, p);
+        return ::pstld::any_of(policy, first, last, p);
     else
         return ::std::any_of(first, last, p);
 }
@@ -3897,10 +9995,10 @@ any_of(ExPo &&, It first, It last, UnPred p) noexcept
 
 template <class ExPo, class It, class UnPred>
 execution::__enable_if_execution_policy<ExPo, bool>
-none_of(ExPo &&, It first, It last, UnPred p) noexcept
+none_of(ExPo &&policy, It first, It last, UnPred p) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::none_of(first, last, p);
+        return ::pstld::none_of(policy, first, last, p);
     else
         return ::std::none_of(first, last, p);
 }
@@ -3909,20 +10007,20 @@ none_of(ExPo &&, It first, It last, UnPred p) noexcept
 
 template <class ExPo, class It, class Func>
 execution::__enable_if_execution_policy<ExPo, void>
-for_each(ExPo &&, It first, It last, Func f) noexcept
+for_each(ExPo &&policy, It first, It last, Func f) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        ::pstld::for_each(first, last, f);
+        ::pstld::for_each(policy, first, last, f);
     else
         ::std::for_each(first, last, f);
 }
 
 template <class ExPo, class It, class Size, class Func>
 execution::__enable_if_execution_policy<ExPo, It>
-for_each_n(ExPo &&, It first, Size count, Func f) noexcept
+for_each_n(ExPo &&policy, It first, Size count, Func f) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::for_each_n(first, count, f);
+        return ::pstld::for_each_n(policy, first, count, f);
     else
         return ::std::for_each_n(first, count, f);
 }
@@ -3931,30 +10029,30 @@ for_each_n(ExPo &&, It first, Size count, Func f) noexcept
 
 template <class ExPo, class It, class T>
 execution::__enable_if_execution_policy<ExPo, It>
-find(ExPo &&, It first, It last, const T &value) noexcept
+find(ExPo &&policy, It first, It last, const T &value) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::find(first, last, value);
+        return ::pstld::find(policy, first, last, value);
     else
         return ::std::find(first, last, value);
 }
 
 template <class ExPo, class It, class Pred>
 execution::__enable_if_execution_policy<ExPo, It>
-find_if(ExPo &&, It first, It last, Pred pred) noexcept
+find_if(ExPo &&policy, It first, It last, Pred pred) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::find_if(first, last, pred);
+        return ::pstld::find_if(policy, first, last, pred);
     else
         return ::std::find_if(first, last, pred);
 }
 
 template <class ExPo, class It, class Pred>
 execution::__enable_if_execution_policy<ExPo, It>
-find_if_not(ExPo &&, It first, It last, Pred pred) noexcept
+find_if_not(ExPo &&policy, It first, It last, Pred pred) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::find_if_not(first, last, pred);
+        return ::pstld::find_if_not(policy, first, last, pred);
     else
         return ::std::find_if_not(first, last, pred);
 }
@@ -3963,20 +10061,20 @@ find_if_not(ExPo &&, It first, It last, Pred pred) noexcept
 
 template <class ExPo, class It1, class It2>
 execution::__enable_if_execution_policy<ExPo, It1>
-find_end(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2)
+find_end(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::find_end(first1, last1, first2, last2);
+        return ::pstld::find_end(policy, first1, last1, first2, last2);
     else
         return ::std::find_end(first1, last1, first2, last2);
 }
 
 template <class ExPo, class It1, class It2, class Pred>
 execution::__enable_if_execution_policy<ExPo, It1>
-find_end(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2, Pred pred)
+find_end(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2, Pred pred)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::find_end(first1, last1, first2, last2, pred);
+        return ::pstld::find_end(policy, first1, last1, first2, last2, pred);
     else
         return ::std::find_end(first1, last1, first2, last2, pred);
 }
@@ -3985,20 +10083,20 @@ find_end(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2, Pred pred)
 
 template <class ExPo, class It1, class It2>
 execution::__enable_if_execution_policy<ExPo, It1>
-find_first_of(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2) noexcept
+find_first_of(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::find_first_of(first1, last1, first2, last2);
+        return ::pstld::find_first_of(policy, first1, last1, first2, last2);
     else
         return ::std::find_first_of(first1, last1, first2, last2);
 }
 
 template <class ExPo, class It1, class It2, class Pred>
 execution::__enable_if_execution_policy<ExPo, It1>
-find_first_of(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2, Pred pred) noexcept
+find_first_of(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2, Pred pred) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::find_first_of(first1, last1, first2, last2, pred);
+        return ::pstld::find_first_of(policy, first1, last1, first2, last2, pred);
     else
         return ::std::find_first_of(first1, last1, first2, last2, pred);
 }
@@ -4006,20 +10104,21 @@ find_first_of(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2, Pred pred)
 // 25.6.8 - adjacent_find //////////////////////////////////////////////////////////////////////////
 
 template <class ExPo, class It>
-execution::__enable_if_execution_policy<ExPo, It> adjacent_find(ExPo &&, It first, It last) noexcept
+execution::__enable_if_execution_policy<ExPo, It>
+adjacent_find(ExPo &&policy, It first, It last) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::adjacent_find(first, last);
+        return ::pstld::adjacent_find(policy, first, last);
     else
         return ::std::adjacent_find(first, last);
 }
 
 template <class ExPo, class It, class Pred>
 execution::__enable_if_execution_policy<ExPo, It>
-adjacent_find(ExPo &&, It first, It last, Pred pred) noexcept
+adjacent_find(ExPo &&policy, It first, It last, Pred pred) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::adjacent_find(first, last, pred);
+        return ::pstld::adjacent_find(policy, first, last, pred);
     else
         return ::std::adjacent_find(first, last, pred);
 }
@@ -4028,20 +10127,20 @@ adjacent_find(ExPo &&, It first, It last, Pred pred) noexcept
 
 template <class ExPo, class It, class T>
 execution::__enable_if_execution_policy<ExPo, typename std::iterator_traits<It>::difference_type>
-count(ExPo &&, It first, It last, const T &value) noexcept
+count(ExPo &&policy, It first, It last, const T &value) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::count(first, last, value);
+        return ::pstld::count(policy, first, last, value);
     else
         return ::std::count(first, last, value);
 }
 
 template <class ExPo, class It, class Pred>
 execution::__enable_if_execution_policy<ExPo, typename std::iterator_traits<It>::difference_type>
-count_if(ExPo &&, It first, It last, Pred pred) noexcept
+count_if(ExPo &&policy, It first, It last, Pred pred) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::count_if(first, last, pred);
+        return ::pstld::count_if(policy, first, last, pred);
     else
         return ::std::count_if(first, last, pred);
 }
@@ -4050,40 +10149,40 @@ count_if(ExPo &&, It first, It last, Pred pred) noexcept
 
 template <class ExPo, class It1, class It2>
 execution::__enable_if_execution_policy<ExPo, std::pair<It1, It2>>
-mismatch(ExPo &&, It1 first1, It1 last1, It2 first2) noexcept
+mismatch(ExPo &&policy, It1 first1, It1 last1, It2 first2) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::mismatch(first1, last1, first2);
+        return ::pstld::mismatch(policy, first1, last1, first2);
     else
         return ::std::mismatch(first1, last1, first2);
 }
 
 template <class ExPo, class It1, class It2, class Cmp>
 execution::__enable_if_execution_policy<ExPo, std::pair<It1, It2>>
-mismatch(ExPo &&, It1 first1, It1 last1, It2 first2, Cmp cmp) noexcept
+mismatch(ExPo &&policy, It1 first1, It1 last1, It2 first2, Cmp cmp) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::mismatch(first1, last1, first2, cmp);
+        return ::pstld::mismatch(policy, first1, last1, first2, cmp);
     else
         return ::std::mismatch(first1, last1, first2, cmp);
 }
 
 template <class ExPo, class It1, class It2>
 execution::__enable_if_execution_policy<ExPo, std::pair<It1, It2>>
-mismatch(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2) noexcept
+mismatch(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::mismatch(first1, last1, first2, last2);
+        return ::pstld::mismatch(policy, first1, last1, first2, last2);
     else
         return ::std::mismatch(first1, last1, first2, last2);
 }
 
 template <class ExPo, class It1, class It2, class Cmp>
 execution::__enable_if_execution_policy<ExPo, std::pair<It1, It2>>
-mismatch(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2, Cmp cmp) noexcept
+mismatch(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2, Cmp cmp) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::mismatch(first1, last1, first2, last2, cmp);
+        return ::pstld::mismatch(policy, first1, last1, first2, last2, cmp);
     else
         return ::std::mismatch(first1, last1, first2, last2, cmp);
 }
@@ -4092,40 +10191,40 @@ mismatch(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2, Cmp cmp) noexcep
 
 template <class ExPo, class It1, class It2>
 execution::__enable_if_execution_policy<ExPo, bool>
-equal(ExPo &&, It1 first1, It1 last1, It2 first2) noexcept
+equal(ExPo &&policy, It1 first1, It1 last1, It2 first2) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::equal(first1, last1, first2);
+        return ::pstld::equal(policy, first1, last1, first2);
     else
         return ::std::equal(first1, last1, first2);
 }
 
 template <class ExPo, class It1, class It2, class Eq>
 execution::__enable_if_execution_policy<ExPo, bool>
-equal(ExPo &&, It1 first1, It1 last1, It2 first2, Eq eq) noexcept
+equal(ExPo &&policy, It1 first1, It1 last1, It2 first2, Eq eq) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::equal(first1, last1, first2, eq);
+        return ::pstld::equal(policy, first1, last1, first2, eq);
     else
         return ::std::equal(first1, last1, first2, eq);
 }
 
 template <class ExPo, class It1, class It2>
 execution::__enable_if_execution_policy<ExPo, bool>
-equal(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2) noexcept
+equal(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::equal(first1, last1, first2, last2);
+        return ::pstld::equal(policy, first1, last1, first2, last2);
     else
         return ::std::equal(first1, last1, first2, last2);
 }
 
 template <class ExPo, class It1, class It2, class Eq>
 execution::__enable_if_execution_policy<ExPo, bool>
-equal(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2, Eq eq) noexcept
+equal(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2, Eq eq) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::equal(first1, last1, first2, last2, eq);
+        return ::pstld::equal(policy, first1, last1, first2, last2, eq);
     else
         return ::std::equal(first1, last1, first2, last2, eq);
 }
@@ -4134,40 +10233,40 @@ equal(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2, Eq eq) noexcept
 
 template <class ExPo, class It1, class It2>
 execution::__enable_if_execution_policy<ExPo, It1>
-search(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2) noexcept
+search(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::search(first1, last1, first2, last2);
+        return ::pstld::search(policy, first1, last1, first2, last2);
     else
         return ::std::search(first1, last1, first2, last2);
 }
 
 template <class ExPo, class It1, class It2, class Pred>
 execution::__enable_if_execution_policy<ExPo, It1>
-search(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2, Pred pred) noexcept
+search(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2, Pred pred) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::search(first1, last1, first2, last2, pred);
+        return ::pstld::search(policy, first1, last1, first2, last2, pred);
     else
         return ::std::search(first1, last1, first2, last2, pred);
 }
 
 template <class ExPo, class It, class Size, class T>
 execution::__enable_if_execution_policy<ExPo, It>
-search_n(ExPo &&, It first, It last, Size count, const T &value) noexcept
+search_n(ExPo &&policy, It first, It last, Size count, const T &value) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::search_n(first, last, count, value);
+        return ::pstld::search_n(policy, first, last, count, value);
     else
         return ::std::search_n(first, last, count, value);
 }
 
 template <class ExPo, class It, class Size, class T, class Pred>
 execution::__enable_if_execution_policy<ExPo, It>
-search_n(ExPo &&, It first, It last, Size count, const T &value, Pred pred) noexcept
+search_n(ExPo &&policy, It first, It last, Size count, const T &value, Pred pred) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::search_n(first, last, count, value, pred);
+        return ::pstld::search_n(policy, first, last, count, value, pred);
     else
         return ::std::search_n(first, last, count, value, pred);
 }
@@ -4176,39 +10275,42 @@ search_n(ExPo &&, It first, It last, Size count, const T &value, Pred pred) noex
 
 template <class ExPo, class It1, class It2>
 execution::__enable_if_execution_policy<ExPo, It2>
-copy(ExPo &&, It1 first, It1 last, It2 result) noexcept
+copy(ExPo &&policy, It1 first, It1 last, It2 result) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::copy(first, last, result);
+        return ::pstld::copy(policy, first, last, result);
     else
         return ::std::copy(first, last, result);
 }
 
 template <class ExPo, class It1, class Size, class It2>
 execution::__enable_if_execution_policy<ExPo, It2>
-copy_n(ExPo &&, It1 first, Size count, It2 result) noexcept
+copy_n(ExPo &&policy, It1 first, Size count, It2 result) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::copy_n(first, count, result);
+        return ::pstld::copy_n(policy, first, count, result);
     else
         return ::std::copy_n(first, count, result);
 }
 
 template <class ExPo, class It1, class It2, class Pred>
 execution::__enable_if_execution_policy<ExPo, It2>
-copy_if(ExPo &&, It1 first, It1 last, It2 result, Pred pred) noexcept
+copy_if(ExPo &&policy, It1 first, It1 last, It2 result, Pred pred) noexcept
 {
-    return ::std::copy_if(first, last, result, pred); // stub only
+    if constexpr( execution::__pstld_enabled<ExPo> )
+        return ::pstld::copy_if(policy, first, last, result, pred);
+    else
+        return ::std::copy_if(first, last, result, pred);
 }
 
 // 25.7.2 - move ///////////////////////////////////////////////////////////////////////////////////
 
 template <class ExPo, class It1, class It2>
 execution::__enable_if_execution_policy<ExPo, It2>
-move(ExPo &&, It1 first, It1 last, It2 result) noexcept
+move(ExPo &&policy, It1 first, It1 last, It2 result) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::move(first, last, result);
+        return ::pstld::move(policy, first, last, result);
     else
         return ::std::move(first, last, result);
 }
@@ -4217,10 +10319,10 @@ move(ExPo &&, It1 first, It1 last, It2 result) noexcept
 
 template <class ExPo, class It1, class It2>
 execution::__enable_if_execution_policy<ExPo, It2>
-swap_ranges(ExPo &&, It1 first, It1 last, It2 result) noexcept
+swap_ranges(ExPo &&policy, It1 first, It1 last, It2 result) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::swap_ranges(first, last, result);
+        return ::pstld::swap_ranges(policy, first, last, result);
     else
         return ::std::swap_ranges(first, last, result);
 }
@@ -4229,20 +10331,20 @@ swap_ranges(ExPo &&, It1 first, It1 last, It2 result) noexcept
 
 template <class ExPo, class It1, class It2, class UnOp>
 execution::__enable_if_execution_policy<ExPo, It2>
-transform(ExPo &&, It1 first1, It1 last1, It2 first2, UnOp op) noexcept
+transform(ExPo &&policy, It1 first1, It1 last1, It2 first2, UnOp op) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::transform(first1, last1, first2, op);
+        return ::pstld::transform(policy, first1, last1, first2, op);
     else
         return ::std::transform(first1, last1, first2, op);
 }
 
 template <class ExPo, class It1, class It2, class It3, class UnOp>
 execution::__enable_if_execution_policy<ExPo, It3>
-transform(ExPo &&, It1 first1, It1 last1, It2 first2, It3 first3, UnOp op) noexcept
+transform(ExPo &&policy, It1 first1, It1 last1, It2 first2, It3 first3, UnOp op) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::transform(first1, last1, first2, first3, op);
+        return ::pstld::transform(policy, first1, last1, first2, first3, op);
     else
         return ::std::transform(first1, last1, first2, first3, op);
 }
@@ -4251,20 +10353,20 @@ transform(ExPo &&, It1 first1, It1 last1, It2 first2, It3 first3, UnOp op) noexc
 
 template <class ExPo, class It, class T>
 execution::__enable_if_execution_policy<ExPo, void>
-replace(ExPo &&, It first, It last, const T &old_val, const T &new_val) noexcept
+replace(ExPo &&policy, It first, It last, const T &old_val, const T &new_val) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        ::pstld::replace(first, last, old_val, new_val);
+        ::pstld::replace(policy, first, last, old_val, new_val);
     else
         ::std::replace(first, last, old_val, new_val);
 }
 
 template <class ExPo, class It, class Pred, class T>
 execution::__enable_if_execution_policy<ExPo, void>
-replace_if(ExPo &&, It first, It last, Pred pred, const T &new_val) noexcept
+replace_if(ExPo &&policy, It first, It last, Pred pred, const T &new_val) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        ::pstld::replace_if(first, last, pred, new_val);
+        ::pstld::replace_if(policy, first, last, pred, new_val);
     else
         ::std::replace_if(first, last, pred, new_val);
 }
@@ -4289,20 +10391,20 @@ replace_copy_if(ExPo &&, It1 first, It1 last, It2 result, Pred pred, const T &ne
 
 template <class ExPo, class It, class T>
 execution::__enable_if_execution_policy<ExPo, void>
-fill(ExPo &&, It first, It last, const T &value) noexcept
+fill(ExPo &&policy, It first, It last, const T &value) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        ::pstld::fill(first, last, value);
+        ::pstld::fill(policy, first, last, value);
     else
         ::std::fill(first, last, value);
 }
 
 template <class ExPo, class It, class Size, class T>
 execution::__enable_if_execution_policy<ExPo, It>
-fill_n(ExPo &&, It first, Size count, const T &value) noexcept
+fill_n(ExPo &&policy, It first, Size count, const T &value) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::fill_n(first, count, value);
+        return ::pstld::fill_n(policy, first, count, value);
     else
         return ::std::fill_n(first, count, value);
 }
@@ -4310,19 +10412,21 @@ fill_n(ExPo &&, It first, Size count, const T &value) noexcept
 // 25.7.7 - generate, generate_n ///////////////////////////////////////////////////////////////////
 
 template <class ExPo, class It, class Gen>
-execution::__enable_if_execution_policy<ExPo, void> generate(ExPo &&, It first, It last, Gen gen)
+execution::__enable_if_execution_policy<ExPo, void>
+generate(ExPo &&policy, It first, It last, Gen gen)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        ::pstld::generate(first, last, gen);
+        ::pstld::generate(policy, first, last, gen);
     else
         ::std::generate(first, last, gen);
 }
 
 template <class ExPo, class It, class Size, class Gen>
-execution::__enable_if_execution_policy<ExPo, It> generate_n(ExPo &&, It first, Size count, Gen gen)
+execution::__enable_if_execution_policy<ExPo, It>
+generate_n(ExPo &&policy, It first, Size count, Gen gen)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::generate_n(first, count, gen);
+        return ::pstld::generate_n(policy, first, count, gen);
     else
         return ::std::generate_n(first, count, gen);
 }
@@ -4330,10 +10434,10 @@ execution::__enable_if_execution_policy<ExPo, It> generate_n(ExPo &&, It first,
 // 25.7.10 - reverse ///////////////////////////////////////////////////////////////////////////////
 
 template <class ExPo, class It>
-execution::__enable_if_execution_policy<ExPo, void> reverse(ExPo &&, It first, It last)
+execution::__enable_if_execution_policy<ExPo, void> reverse(ExPo &&policy, It first, It last)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        ::pstld::reverse(first, last);
+        ::pstld::reverse(policy, first, last);
     else
         ::std::reverse(first, last);
 }
@@ -4341,19 +10445,19 @@ execution::__enable_if_execution_policy<ExPo, void> reverse(ExPo &&, It first, I
 // 25.8.2.1 - sort /////////////////////////////////////////////////////////////////////////////////
 
 template <class ExPo, class It>
-execution::__enable_if_execution_policy<ExPo, void> sort(ExPo &&, It first, It last)
+execution::__enable_if_execution_policy<ExPo, void> sort(ExPo &&policy, It first, It last)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        ::pstld::sort(first, last);
+        ::pstld::sort(policy, first, last);
     else
         ::std::sort(first, last);
 }
 
 template <class ExPo, class It, class Cmp>
-execution::__enable_if_execution_policy<ExPo, void> sort(ExPo &&, It first, It last, Cmp cmp)
+execution::__enable_if_execution_policy<ExPo, void> sort(ExPo &&policy, It first, It last, Cmp cmp)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        ::pstld::sort(first, last, cmp);
+        ::pstld::sort(policy, first, last, cmp);
     else
         ::std::sort(first, last, cmp);
 }
@@ -4361,19 +10465,20 @@ execution::__enable_if_execution_policy<ExPo, void> sort(ExPo &&, It first, It l
 // 25.8.2.2 - stable_sort //////////////////////////////////////////////////////////////////////////
 
 template <class ExPo, class It>
-execution::__enable_if_execution_policy<ExPo, void> stable_sort(ExPo &&, It first, It last)
+execution::__enable_if_execution_policy<ExPo, void> stable_sort(ExPo &&policy, It first, It last)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        ::pstld::stable_sort(first, last);
+        ::pstld::stable_sort(policy, first, last);
     else
         ::std::stable_sort(first, last);
 }
 
 template <class ExPo, class It, class Cmp>
-execution::__enable_if_execution_policy<ExPo, void> stable_sort(ExPo &&, It first, It last, Cmp cmp)
+execution::__enable_if_execution_policy<ExPo, void>
+stable_sort(ExPo &&policy, It first, It last, Cmp cmp)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        ::pstld::stable_sort(first, last, cmp);
+        ::pstld::stable_sort(policy, first, last, cmp);
     else
         ::std::stable_sort(first, last, cmp);
 }
@@ -4381,38 +10486,39 @@ execution::__enable_if_execution_policy<ExPo, void> stable_sort(ExPo &&, It firs
 // 25.8.2.5 - is_sorted, is_sorted_until ///////////////////////////////////////////////////////////
 
 template <class ExPo, class It>
-execution::__enable_if_execution_policy<ExPo, bool> is_sorted(ExPo &&, It first, It last)
+execution::__enable_if_execution_policy<ExPo, bool> is_sorted(ExPo &&policy, It first, It last)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::is_sorted(first, last);
+        return ::pstld::is_sorted(policy, first, last);
     else
         return ::std::is_sorted(first, last);
 }
 
 template <class ExPo, class It, class Cmp>
-execution::__enable_if_execution_policy<ExPo, bool> is_sorted(ExPo &&, It first, It last, Cmp cmp)
+execution::__enable_if_execution_policy<ExPo, bool>
+is_sorted(ExPo &&policy, It first, It last, Cmp cmp)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::is_sorted(first, last, cmp);
+        return ::pstld::is_sorted(policy, first, last, cmp);
     else
         return ::std::is_sorted(first, last, cmp);
 }
 
 template <class ExPo, class It>
-execution::__enable_if_execution_policy<ExPo, It> is_sorted_until(ExPo &&, It first, It last)
+execution::__enable_if_execution_policy<ExPo, It> is_sorted_until(ExPo &&policy, It first, It last)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::is_sorted_until(first, last);
+        return ::pstld::is_sorted_until(policy, first, last);
     else
         return ::std::is_sorted_until(first, last);
 }
 
 template <class ExPo, class It, class Cmp>
 execution::__enable_if_execution_policy<ExPo, It>
-is_sorted_until(ExPo &&, It first, It last, Cmp cmp)
+is_sorted_until(ExPo &&policy, It first, It last, Cmp cmp)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::is_sorted_until(first, last, cmp);
+        return ::pstld::is_sorted_until(policy, first, last, cmp);
     else
         return ::std::is_sorted_until(first, last, cmp);
 }
@@ -4421,10 +10527,10 @@ is_sorted_until(ExPo &&, It first, It last, Cmp cmp)
 
 template <class ExPo, class It, class Pred>
 execution::__enable_if_execution_policy<ExPo, bool>
-is_partitioned(ExPo &&, It first, It last, Pred pred)
+is_partitioned(ExPo &&policy, It first, It last, Pred pred)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::is_partitioned(first, last, pred);
+        return ::pstld::is_partitioned(policy, first, last, pred);
     else
         return ::std::is_partitioned(first, last, pred);
 }
@@ -4433,20 +10539,20 @@ is_partitioned(ExPo &&, It first, It last, Pred pred)
 
 template <class ExPo, class It1, class It2, class It3>
 execution::__enable_if_execution_policy<ExPo, It3>
-merge(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2, It3 first3)
+merge(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2, It3 first3)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::merge(first1, last1, first2, last2, first3);
+        return ::pstld::merge(policy, first1, last1, first2, last2, first3);
     else
         return ::std::merge(first1, last1, first2, last2, first3);
 }
 
 template <class ExPo, class It1, class It2, class It3, class Cmp>
 execution::__enable_if_execution_policy<ExPo, It3>
-merge(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2, It3 first3, Cmp cmp)
+merge(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2, It3 first3, Cmp cmp)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::merge(first1, last1, first2, last2, first3, cmp);
+        return ::pstld::merge(policy, first1, last1, first2, last2, first3, cmp);
     else
         return ::std::merge(first1, last1, first2, last2, first3, cmp);
 }
@@ -4454,57 +10560,59 @@ merge(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2, It3 first3, Cmp cmp
 // 25.8.9 - min_element, max_element, minmax_element ///////////////////////////////////////////////
 
 template <class ExPo, class It>
-execution::__enable_if_execution_policy<ExPo, It> min_element(ExPo &&, It first, It last)
+execution::__enable_if_execution_policy<ExPo, It> min_element(ExPo &&policy, It first, It last)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::min_element(first, last);
+        return ::pstld::min_element(policy, first, last);
     else
         return ::std::min_element(first, last);
 }
 
 template <class ExPo, class It, class Cmp>
-execution::__enable_if_execution_policy<ExPo, It> min_element(ExPo &&, It first, It last, Cmp cmp)
+execution::__enable_if_execution_policy<ExPo, It>
+min_element(ExPo &&policy, It first, It last, Cmp cmp)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::min_element(first, last, cmp);
+        return ::pstld::min_element(policy, first, last, cmp);
     else
         return ::std::min_element(first, last, cmp);
 }
 
 template <class ExPo, class It>
-execution::__enable_if_execution_policy<ExPo, It> max_element(ExPo &&, It first, It last)
+execution::__enable_if_execution_policy<ExPo, It> max_element(ExPo &&policy, It first, It last)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::max_element(first, last);
+        return ::pstld::max_element(policy, first, last);
     else
         return ::std::max_element(first, last);
 }
 
 template <class ExPo, class It, class Cmp>
-execution::__enable_if_execution_policy<ExPo, It> max_element(ExPo &&, It first, It last, Cmp cmp)
+execution::__enable_if_execution_policy<ExPo, It>
+max_element(ExPo &&policy, It first, It last, Cmp cmp)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::max_element(first, last, cmp);
+        return ::pstld::max_element(policy, first, last, cmp);
     else
         return ::std::max_element(first, last, cmp);
 }
 
 template <class ExPo, class It>
 execution::__enable_if_execution_policy<ExPo, std::pair<It, It>>
-minmax_element(ExPo &&, It first, It last)
+minmax_element(ExPo &&policy, It first, It last)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::minmax_element(first, last);
+        return ::pstld::minmax_element(policy, first, last);
     else
         return ::std::minmax_element(first, last);
 }
 
 template <class ExPo, class It, class Cmp>
 execution::__enable_if_execution_policy<ExPo, std::pair<It, It>>
-minmax_element(ExPo &&, It first, It last, Cmp cmp)
+minmax_element(ExPo &&policy, It first, It last, Cmp cmp)
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::minmax_element(first, last, cmp);
+        return ::pstld::minmax_element(policy, first, last, cmp);
     else
         return ::std::minmax_element(first, last, cmp);
 }
@@ -4513,20 +10621,24 @@ minmax_element(ExPo &&, It first, It last, Cmp cmp)
 
 template <class ExPo, class It1, class It2>
 execution::__enable_if_execution_policy<ExPo, bool>
-lexicographical_compare(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2) noexcept
+lexicographical_compare(ExPo &&policy, It1 first1, It1 last1, It2 first2, It2 last2) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::lexicographical_compare(first1, last1, first2, last2);
+        return ::pstld::lexicographical_compare(policy, first1, last1, first2, last2);
     else
         return ::std::lexicographical_compare(first1, last1, first2, last2);
 }
 
 template <class ExPo, class It1, class It2, class Cmp>
-execution::__enable_if_execution_policy<ExPo, bool>
-lexicographical_compare(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2, Cmp cmp) noexcept
+execution::__enable_if_execution_policy<ExPo, bool> lexicographical_compare(ExPo &&policy,
+                                                                            It1 first1,
+                                                                            It1 last1,
+                                                                            It2 first2,
+                                                                            It2 last2,
+                                                                            Cmp cmp) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::lexicographical_compare(first1, last1, first2, last2, cmp);
+        return ::pstld::lexicographical_compare(policy, first1, last1, first2, last2, cmp);
     else
         return ::std::lexicographical_compare(first1, last1, first2, last2, cmp);
 }
@@ -4535,29 +10647,30 @@ lexicographical_compare(ExPo &&, It1 first1, It1 last1, It2 first2, It2 last2, C
 
 template <class ExPo, class It>
 execution::__enable_if_execution_policy<ExPo, typename iterator_traits<It>::value_type>
-reduce(ExPo &&, It first, It last) noexcept
+reduce(ExPo &&policy, It first, It last) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::reduce(first, last);
+        return ::pstld::reduce(policy, first, last);
     else
         return ::std::reduce(first, last);
 }
 
 template <class ExPo, class It, class T>
-execution::__enable_if_execution_policy<ExPo, T> reduce(ExPo &&, It first, It last, T val) noexcept
+execution::__enable_if_execution_policy<ExPo, T>
+reduce(ExPo &&policy, It first, It last, T val) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::reduce(first, last, std::move(val));
+        return ::pstld::reduce(policy, first, last, std::move(val));
     else
         return ::pstld::internal::move_reduce(first, last, std::move(val), std::plus<>{});
 }
 
 template <class ExPo, class It, class T, class BinOp>
 execution::__enable_if_execution_policy<ExPo, T>
-reduce(ExPo &&, It first, It last, T val, BinOp op) noexcept
+reduce(ExPo &&policy, It first, It last, T val, BinOp op) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::reduce(first, last, std::move(val), op);
+        return ::pstld::reduce(policy, first, last, std::move(val), op);
     else
         return ::pstld::internal::move_reduce(first, last, std::move(val), op);
 }
@@ -4566,17 +10679,17 @@ reduce(ExPo &&, It first, It last, T val, BinOp op) noexcept
 
 template <class ExPo, class It1, class It2, class T>
 execution::__enable_if_execution_policy<ExPo, T>
-transform_reduce(ExPo &&, It1 first1, It1 last1, It2 first2, T val) noexcept
+transform_reduce(ExPo &&policy, It1 first1, It1 last1, It2 first2, T val) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::transform_reduce(first1, last1, first2, std::move(val));
+        return ::pstld::transform_reduce(policy, first1, last1, first2, std::move(val));
     else
         return ::pstld::internal::move_transform_reduce(
             first1, last1, first2, std::move(val), std::plus<>{}, std::multiplies<>{});
 }
 
 template <class ExPo, class It1, class It2, class T, class BinRedOp, class BinTrOp>
-execution::__enable_if_execution_policy<ExPo, T> transform_reduce(ExPo &&,
+execution::__enable_if_execution_policy<ExPo, T> transform_reduce(ExPo &&policy,
                                                                   It1 first1,
                                                                   It1 last1,
                                                                   It2 first2,
@@ -4585,7 +10698,8 @@ execution::__enable_if_execution_policy<ExPo, T> transform_reduce(ExPo &&,
                                                                   BinTrOp trop) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::transform_reduce(first1, last1, first2, std::move(val), redop, trop);
+        return ::pstld::transform_reduce(
+            policy, first1, last1, first2, std::move(val), redop, trop);
     else
         return ::pstld::internal::move_transform_reduce(
             first1, last1, first2, std::move(val), redop, trop);
@@ -4593,10 +10707,10 @@ execution::__enable_if_execution_policy<ExPo, T> transform_reduce(ExPo &&,
 
 template <class ExPo, class It, class T, class BinOp, class UnOp>
 execution::__enable_if_execution_policy<ExPo, T>
-transform_reduce(ExPo &&, It first, It last, T val, BinOp bop, UnOp uop) noexcept
+transform_reduce(ExPo &&policy, It first, It last, T val, BinOp bop, UnOp uop) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::transform_reduce(first, last, std::move(val), bop, uop);
+        return ::pstld::transform_reduce(policy, first, last, std::move(val), bop, uop);
     else
         return ::pstld::internal::move_transform_reduce(first, last, std::move(val), bop, uop);
 }
@@ -4605,20 +10719,20 @@ transform_reduce(ExPo &&, It first, It last, T val, BinOp bop, UnOp uop) noexcep
 
 template <class ExPo, class It1, class It2, class T>
 execution::__enable_if_execution_policy<ExPo, It2>
-exclusive_scan(ExPo &&, It1 first1, It1 last1, It2 first2, T val) noexcept
+exclusive_scan(ExPo &&policy, It1 first1, It1 last1, It2 first2, T val) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::exclusive_scan(first1, last1, first2, std::move(val));
+        return ::pstld::exclusive_scan(policy, first1, last1, first2, std::move(val));
     else
         return ::std::exclusive_scan(first1, last1, first2, std::move(val));
 }
 
 template <class ExPo, class It1, class It2, class T, class BinOp>
 execution::__enable_if_execution_policy<ExPo, It2>
-exclusive_scan(ExPo &&, It1 first1, It1 last1, It2 first2, T val, BinOp bop) noexcept
+exclusive_scan(ExPo &&policy, It1 first1, It1 last1, It2 first2, T val, BinOp bop) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::exclusive_scan(first1, last1, first2, std::move(val), bop);
+        return ::pstld::exclusive_scan(policy, first1, last1, first2, std::move(val), bop);
     else
         return ::std::exclusive_scan(first1, last1, first2, std::move(val), bop);
 }
@@ -4627,30 +10741,30 @@ exclusive_scan(ExPo &&, It1 first1, It1 last1, It2 first2, T val, BinOp bop) noe
 
 template <class ExPo, class It1, class It2, class BinOp, class T>
 execution::__enable_if_execution_policy<ExPo, It2>
-inclusive_scan(ExPo &&, It1 first1, It1 last1, It2 first2, BinOp bop, T val) noexcept
+inclusive_scan(ExPo &&policy, It1 first1, It1 last1, It2 first2, BinOp bop, T val) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::inclusive_scan(first1, last1, first2, bop, std::move(val));
+        return ::pstld::inclusive_scan(policy, first1, last1, first2, bop, std::move(val));
     else
         return ::std::inclusive_scan(first1, last1, first2, bop, std::move(val));
 }
 
 template <class ExPo, class It1, class It2, class BinOp>
 execution::__enable_if_execution_policy<ExPo, It2>
-inclusive_scan(ExPo &&, It1 first1, It1 last1, It2 first2, BinOp bop) noexcept
+inclusive_scan(ExPo &&policy, It1 first1, It1 last1, It2 first2, BinOp bop) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::inclusive_scan(first1, last1, first2, bop);
+        return ::pstld::inclusive_scan(policy, first1, last1, first2, bop);
     else
         return ::std::inclusive_scan(first1, last1, first2, bop);
 }
 
 template <class ExPo, class It1, class It2>
 execution::__enable_if_execution_policy<ExPo, It2>
-inclusive_scan(ExPo &&, It1 first1, It1 last1, It2 first2) noexcept
+inclusive_scan(ExPo &&policy, It1 first1, It1 last1, It2 first2) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::inclusive_scan(first1, last1, first2);
+        return ::pstld::inclusive_scan(policy, first1, last1, first2);
     else
         return ::std::inclusive_scan(first1, last1, first2);
 }
@@ -4658,7 +10772,7 @@ inclusive_scan(ExPo &&, It1 first1, It1 last1, It2 first2) noexcept
 // 25.10.10 - transform_exclusive_scan /////////////////////////////////////////////////////////////
 
 template <class ExPo, class It1, class It2, class T, class BinOp, class UnOp>
-execution::__enable_if_execution_policy<ExPo, It2> transform_exclusive_scan(ExPo &&,
+execution::__enable_if_execution_policy<ExPo, It2> transform_exclusive_scan(ExPo &&policy,
                                                                             It1 first1,
                                                                             It1 last1,
                                                                             It2 first2,
@@ -4667,7 +10781,8 @@ execution::__enable_if_execution_policy<ExPo, It2> transform_exclusive_scan(ExPo
                                                                             UnOp uop) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::transform_exclusive_scan(first1, last1, first2, std::move(val), bop, uop);
+        return ::pstld::transform_exclusive_scan(
+            policy, first1, last1, first2, std::move(val), bop, uop);
     else
         return ::pstld::internal::transform_exclusive_scan_serial(
             first1, last1, first2, std::move(val), bop, uop);
@@ -4676,7 +10791,7 @@ execution::__enable_if_execution_policy<ExPo, It2> transform_exclusive_scan(ExPo
 // 25.10.11 - transform_inclusive_scan /////////////////////////////////////////////////////////////
 
 template <class ExPo, class It1, class It2, class BinOp, class UnOp, class T>
-execution::__enable_if_execution_policy<ExPo, It2> transform_inclusive_scan(ExPo &&,
+execution::__enable_if_execution_policy<ExPo, It2> transform_inclusive_scan(ExPo &&policy,
                                                                             It1 first1,
                                                                             It1 last1,
                                                                             It2 first2,
@@ -4685,17 +10800,22 @@ execution::__enable_if_execution_policy<ExPo, It2> transform_inclusive_scan(ExPo
                                                                             T val) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::transform_inclusive_scan(first1, last1, first2, bop, uop, std::move(val));
+        return ::pstld::transform_inclusive_scan(
+            policy, first1, last1, first2, bop, uop, std::move(val));
     else
         return ::std::transform_inclusive_scan(first1, last1, first2, bop, uop, std::move(val));
 }
 
 template <class ExPo, class It1, class It2, class BinOp, class UnOp>
-execution::__enable_if_execution_policy<ExPo, It2>
-transform_inclusive_scan(ExPo &&, It1 first1, It1 last1, It2 first2, BinOp bop, UnOp uop) noexcept
+execution::__enable_if_execution_policy<ExPo, It2> transform_inclusive_scan(ExPo &&policy,
+                                                                            It1 first1,
+                                                                            It1 last1,
+                                                                            It2 first2,
+                                                                            BinOp bop,
+                                                                            UnOp uop) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::transform_inclusive_scan(first1, last1, first2, bop, uop);
+        return ::pstld::transform_inclusive_scan(policy, first1, last1, first2, bop, uop);
     else
         return ::std::transform_inclusive_scan(first1, last1, first2, bop, uop);
 }
@@ -4704,20 +10824,20 @@ transform_inclusive_scan(ExPo &&, It1 first1, It1 last1, It2 first2, BinOp bop,
 
 template <class ExPo, class It1, class It2>
 execution::__enable_if_execution_policy<ExPo, It2>
-adjacent_difference(ExPo &&, It1 first1, It1 last1, It2 first2) noexcept
+adjacent_difference(ExPo &&policy, It1 first1, It1 last1, It2 first2) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::adjacent_difference(first1, last1, first2);
+        return ::pstld::adjacent_difference(policy, first1, last1, first2);
     else
         return ::std::adjacent_difference(first1, last1, first2);
 }
 
 template <class ExPo, class It1, class It2, class BinOp>
 execution::__enable_if_execution_policy<ExPo, It2>
-adjacent_difference(ExPo &&, It1 first1, It1 last1, It2 first2, BinOp op) noexcept
+adjacent_difference(ExPo &&policy, It1 first1, It1 last1, It2 first2, BinOp op) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::adjacent_difference(first1, last1, first2, op);
+        return ::pstld::adjacent_difference(policy, first1, last1, first2, op);
     else
         return ::std::adjacent_difference(first1, last1, first2, op);
 }
@@ -4726,20 +10846,20 @@ adjacent_difference(ExPo &&, It1 first1, It1 last1, It2 first2, BinOp op) noexce
 
 template <class ExPo, class It>
 execution::__enable_if_execution_policy<ExPo, void>
-uninitialized_default_construct(ExPo &&, It first, It last) noexcept
+uninitialized_default_construct(ExPo &&policy, It first, It last) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        ::pstld::uninitialized_default_construct(first, last);
+        ::pstld::uninitialized_default_construct(policy, first, last);
     else
         ::std::uninitialized_default_construct(first, last);
 }
 
 template <class ExPo, class It, class Size>
 execution::__enable_if_execution_policy<ExPo, It>
-uninitialized_default_construct_n(ExPo &&, It first, Size count) noexcept
+uninitialized_default_construct_n(ExPo &&policy, It first, Size count) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::uninitialized_default_construct_n(first, count);
+        return ::pstld::uninitialized_default_construct_n(policy, first, count);
     else
         return ::std::uninitialized_default_construct_n(first, count);
 }
@@ -4748,20 +10868,20 @@ uninitialized_default_construct_n(ExPo &&, It first, Size count) noexcept
 
 template <class ExPo, class It>
 execution::__enable_if_execution_policy<ExPo, void>
-uninitialized_value_construct(ExPo &&, It first, It last) noexcept
+uninitialized_value_construct(ExPo &&policy, It first, It last) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        ::pstld::uninitialized_value_construct(first, last);
+        ::pstld::uninitialized_value_construct(policy, first, last);
     else
         ::std::uninitialized_value_construct(first, last);
 }
 
 template <class ExPo, class It, class Size>
 execution::__enable_if_execution_policy<ExPo, It>
-uninitialized_value_construct_n(ExPo &&, It first, Size count) noexcept
+uninitialized_value_construct_n(ExPo &&policy, It first, Size count) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::uninitialized_value_construct_n(first, count);
+        return ::pstld::uninitialized_value_construct_n(policy, first, count);
     else
         return ::std::uninitialized_value_construct_n(first, count);
 }
@@ -4770,20 +10890,20 @@ uninitialized_value_construct_n(ExPo &&, It first, Size count) noexcept
 
 template <class ExPo, class It1, class It2>
 execution::__enable_if_execution_policy<ExPo, It2>
-uninitialized_copy(ExPo &&, It1 first, It1 last, It2 result) noexcept
+uninitialized_copy(ExPo &&policy, It1 first, It1 last, It2 result) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::uninitialized_copy(first, last, result);
+        return ::pstld::uninitialized_copy(policy, first, last, result);
     else
         return ::std::uninitialized_copy(first, last, result);
 }
 
 template <class ExPo, class It1, class Size, class It2>
 execution::__enable_if_execution_policy<ExPo, It2>
-uninitialized_copy_n(ExPo &&, It1 first, Size count, It2 result) noexcept
+uninitialized_copy_n(ExPo &&policy, It1 first, Size count, It2 result) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::uninitialized_copy_n(first, count, result);
+        return ::pstld::uninitialized_copy_n(policy, first, count, result);
     else
         return ::std::uninitialized_copy_n(first, count, result);
 }
@@ -4792,20 +10912,20 @@ uninitialized_copy_n(ExPo &&, It1 first, Size count, It2 result) noexcept
 
 template <class ExPo, class It1, class It2>
 execution::__enable_if_execution_policy<ExPo, It2>
-uninitialized_move(ExPo &&, It1 first, It1 last, It2 result) noexcept
+uninitialized_move(ExPo &&policy, It1 first, It1 last, It2 result) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::uninitialized_move(first, last, result);
+        return ::pstld::uninitialized_move(policy, first, last, result);
     else
         return ::std::uninitialized_move(first, last, result);
 }
 
 template <class ExPo, class It1, class Size, class It2>
 execution::__enable_if_execution_policy<ExPo, std::pair<It1, It2>>
-uninitialized_move_n(ExPo &&, It1 first, Size count, It2 result) noexcept
+uninitialized_move_n(ExPo &&policy, It1 first, Size count, It2 result) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::uninitialized_move_n(first, count, result);
+        return ::pstld::uninitialized_move_n(policy, first, count, result);
     else
         return ::std::uninitialized_move_n(first, count, result);
 }
@@ -4814,20 +10934,20 @@ uninitialized_move_n(ExPo &&, It1 first, Size count, It2 result) noexcept
 
 template <class ExPo, class It, class T>
 execution::__enable_if_execution_policy<ExPo, void>
-uninitialized_fill(ExPo &&, It first, It last, const T &value) noexcept
+uninitialized_fill(ExPo &&policy, It first, It last, const T &value) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        ::pstld::uninitialized_fill(first, last, value);
+        ::pstld::uninitialized_fill(policy, first, last, value);
     else
         ::std::uninitialized_fill(first, last, value);
 }
 
 template <class ExPo, class It, class Size, class T>
 execution::__enable_if_execution_policy<ExPo, It>
-uninitialized_fill_n(ExPo &&, It first, Size count, const T &value) noexcept
+uninitialized_fill_n(ExPo &&policy, It first, Size count, const T &value) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::uninitialized_fill_n(first, count, value);
+        return ::pstld::uninitialized_fill_n(policy, first, count, value);
     else
         return ::std::uninitialized_fill_n(first, count, value);
 }
@@ -4835,19 +10955,21 @@ uninitialized_fill_n(ExPo &&, It first, Size count, const T &value) noexcept
 // 25.11.9 - destroy, destroy_n ////////////////////////////////////////////////////////////////////
 
 template <class ExPo, class It>
-execution::__enable_if_execution_policy<ExPo, void> destroy(ExPo &&, It first, It last) noexcept
+execution::__enable_if_execution_policy<ExPo, void>
+destroy(ExPo &&policy, It first, It last) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        ::pstld::destroy(first, last);
+        ::pstld::destroy(policy, first, last);
     else
         ::std::destroy(first, last);
 }
 
 template <class ExPo, class It, class Size>
-execution::__enable_if_execution_policy<ExPo, It> destroy_n(ExPo &&, It first, Size count) noexcept
+execution::__enable_if_execution_policy<ExPo, It>
+destroy_n(ExPo &&policy, It first, Size count) noexcept
 {
     if constexpr( execution::__pstld_enabled<ExPo> )
-        return ::pstld::destroy_n(first, count);
+        return ::pstld::destroy_n(policy, first, count);
     else
         return ::std::destroy_n(first, count);
 }
@@ -0,0 +1,76 @@
+#include <pstld/pstld.h>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+int main()
+{
+    using namespace pstld::execution;
+    const auto eager = par.with(serial_below{0});
+
+    const pstld::admission_counters initial = pstld::admission_stats();
+    if( initial.budget != pstld::topology().workers - 1 || initial.busy_helpers != 0 )
+        return 1;
+
+    std::vector<int> v(100'000);
+    std::iota(v.begin(), v.end(), 0);
+    const long expected = std::accumulate(v.begin(), v.end(), 0L);
+    if( pstld::reduce(eager, v.begin(), v.end(), 0L) != expected )
+        return 1;
+
+    // a task group keeps its team between the rounds, but hands the helpers back on each wait()
+    {
+        pstld::task_group group;
+        for( int round = 0; round != 2; ++round ) {
+            std::atomic<size_t> busy_inside{0};
+            for( int i = 0; i != 4; ++i )
+                group.run([&] { busy_inside = pstld::admission_stats().busy_helpers; });
+            group.wait();
+            if( (initial.budget != 0 && busy_inside == 0) ||
+                pstld::admission_stats().busy_helpers != 0 )
+                return 1;
+        }
+    }
+
+    if( initial.budget == 0 )
+        return pstld::admission_stats().busy_helpers == 0 ? 0 : 1;
+
+    // a call which holds on to all its helpers until released
+    std::atomic<bool> release{false};
+    std::vector<int> blockers(1'000);
+    std::thread holder([&] {
+        pstld::for_each(eager, blockers.begin(), blockers.end(), [&](int) {
+            while( !release )
+                std::this_thread::yield();
+        });
+    });
+    while( pstld::admission_stats().busy_helpers != initial.budget )
+        std::this_thread::yield();
+
+    // the machine is saturated, so the next call runs inline
+    const pstld::admission_counters before = pstld::admission_stats();
+    if( pstld::reduce(eager, v.begin(), v.end(), 0L) != expected )
+        return 1;
+    const pstld::admission_counters after = pstld::admission_stats();
+    if( after.serialized == before.serialized || after.requests == before.requests )
+        return 1;
+
+    // so do the sorts and the merge, which don't even build their teams then
+    std::vector<int> w(v.rbegin(), v.rend()), merged(v.size() * 2);
+    pstld::sort(eager, w.begin(), w.end());
+    pstld::stable_sort(eager, w.rbegin(), w.rend());
+    pstld::merge(eager, v.begin(), v.end(), v.begin(), v.end(), merged.begin());
+    const pstld::admission_counters sorted = pstld::admission_stats();
+    if( sorted.serialized != after.serialized + 3 || sorted.granted != after.granted )
+        return 1;
+    if( !std::is_sorted(w.rbegin(), w.rend()) || !std::is_sorted(merged.begin(), merged.end()) )
+        return 1;
+
+    release = true;
+    holder.join();
+
+    const pstld::admission_counters last = pstld::admission_stats();
+    return last.busy_helpers == 0 && last.granted > initial.granted ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+#include <pstld/pstld.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// Runs lane 0 on the calling thread and lane 1 on a helper thread kept for the whole test, so that
+// both threads are recognized by the partitioner from one call to another. The lanes run either
+// concurrently or one after another, lane 0 first.
+struct TwoThreads {
+    std::mutex mutex;
+    std::condition_variable cv;
+    void *ctx = nullptr;
+    void (*fn)(void *, size_t) = nullptr;
+    bool posted = false;
+    bool quit = false;
+    bool concurrent = true;
+    std::thread helper{[this] {
+        std::unique_lock lock{mutex};
+        while( true ) {
+            cv.wait(lock, [&] { return posted || quit; });
+            if( quit )
+                return;
+            lock.unlock();
+            fn(ctx, 1);
+            lock.lock();
+            posted = false;
+            cv.notify_all();
+        }
+    }};
+
+    ~TwoThreads()
+    {
+        {
+            std::lock_guard lock{mutex};
+            quit = true;
+        }
+        cv.notify_all();
+        helper.join();
+    }
+
+    void bulk_execute(size_t n, void *c, void (*f)(void *, size_t)) noexcept
+    {
+        if( n == 1 ) {
+            f(c, 0);
+            return;
+        }
+        if( !concurrent )
+            f(c, 0);
+        {
+            std::lock_guard lock{mutex};
+            ctx = c;
+            fn = f;
+            posted = true;
+        }
+        cv.notify_all();
+        if( concurrent )
+            f(c, 0);
+        std::unique_lock lock{mutex};
+        cv.wait(lock, [&] { return !posted; });
+    }
+
+    void async(void *c, void (*f)(void *)) noexcept { std::thread(f, c).detach(); }
+
+    size_t concurrency() const noexcept { return 2; }
+};
+
+int main()
+{
+    using namespace pstld::execution;
+
+    TwoThreads pool;
+    const pstld::executor exec = pstld::make_executor(pool);
+    pstld::affinity_partitioner partitioner;
+    const auto policy = par.on(exec).with(serial_below{0}, partitioner);
+
+    std::vector<int> v(10'000);
+    std::vector<std::thread::id> first(v.size());
+    std::vector<std::thread::id> second(v.size());
+    std::vector<size_t> order(v.size());
+
+    // the threads share the range in whatever way they happen to
+    pstld::for_each(policy, v.begin(), v.end(), [&](int &x) {
+        first[&x - v.data()] = std::this_thread::get_id();
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+    });
+
+    // lane 0 runs alone and takes the chunks its thread had processed before the others
+    pool.concurrent = false;
+    std::atomic<size_t> position{0};
+    pstld::for_each(policy, v.begin(), v.end(), [&](int &x) {
+        second[&x - v.data()] = std::this_thread::get_id();
+        order[&x - v.data()] = position++;
+    });
+    const auto mine = std::this_thread::get_id();
+    size_t last_mine = 0;
+    size_t first_other = v.size();
+    for( size_t i = 0; i != v.size(); ++i ) {
+        if( second[i] != mine )
+            return 1;
+        if( first[i] == mine )
+            last_mine = std::max(last_mine, order[i]);
+        else
+            first_other = std::min(first_other, order[i]);
+    }
+    if( first_other != v.size() && last_mine > first_other )
+        return 1;
+
+    // the parts are matched by their position, whatever the number of chunks
+    pstld::affinity_partitioner coarse;
+    std::iota(v.begin(), v.end(), 0);
+    for( size_t chunks : {size_t(1), size_t(3), size_t(64)} ) {
+        const auto p = par.on(exec).with(serial_below{0}, chunks_per_cpu{chunks}, coarse);
+        pool.concurrent = chunks != 3;
+        if( pstld::reduce(p, v.begin(), v.end(), 0L) != std::accumulate(v.begin(), v.end(), 0L) )
+            return 1;
+        auto w = v;
+        std::reverse(w.begin(), w.end());
+        pstld::sort(p, w.begin(), w.end());
+        if( w != v )
+            return 1;
+        std::vector<long> sums(v.size());
+        pstld::inclusive_scan(p, v.begin(), v.end(), sums.begin());
+        if( sums.back() != std::accumulate(v.begin(), v.end(), 0L) )
+            return 1;
+    }
+    coarse.clear();
+
+    // the built-in backend
+    pstld::fill(par.with(partitioner), v.begin(), v.end(), 1);
+    pstld::affinity_partitioner copy = partitioner;
+    if( pstld::reduce(par.with(copy), v.begin(), v.end(), 0L) != long(v.size()) )
+        return 1;
+}
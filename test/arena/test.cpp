@@ -0,0 +1,63 @@
+#include <pstld/pstld.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <vector>
+#include "../inline_pool.h"
+
+int main()
+{
+    using namespace pstld::execution;
+
+    InlinePool pool;
+    const pstld::executor exec = pstld::make_executor(pool);
+    const auto on_pool = par.on(exec);
+
+    std::vector<int> v(100'000);
+    std::iota(v.begin(), v.end(), 0);
+    const long expected = std::accumulate(v.begin(), v.end(), 0L);
+
+    // a per-call arena caps the lanes
+    if( pstld::reduce(on_pool.with(pstld::arena{2}), v.begin(), v.end(), 0L) != expected ||
+        pool.last_n != 2 )
+        return 1;
+
+    {
+        // an arena entered by the thread caps every call, nested scopes can't loosen it
+        pstld::arena::scope outer{pstld::arena{3}};
+        if( pstld::reduce(on_pool, v.begin(), v.end(), 0L) != expected || pool.last_n != 3 )
+            return 1;
+        {
+            pstld::arena::scope inner{pstld::arena{8}};
+            if( pstld::reduce(on_pool, v.begin(), v.end(), 0L) != expected || pool.last_n != 3 )
+                return 1;
+        }
+        // the tighter of the limits wins
+        if( pstld::reduce(on_pool.with(pstld::arena{2}), v.begin(), v.end(), 0L) != expected ||
+            pool.last_n != 2 )
+            return 1;
+    }
+
+    // the default is restored once the scope is left
+    if( pstld::reduce(on_pool, v.begin(), v.end(), 0L) != expected || pool.last_n != 32 )
+        return 1;
+
+    // a single worker doesn't get any helpers
+    std::vector<int> w(v.rbegin(), v.rend());
+    pstld::sort(on_pool.with(pstld::arena{1}), w.begin(), w.end());
+    if( w != v || pool.asyncs != 0 )
+        return 1;
+
+    // the built-in backend doesn't occupy more threads than allowed
+    std::mutex mut;
+    std::set<std::thread::id> threads;
+    pstld::arena::scope scope{pstld::arena{2}};
+    pstld::for_each(par.with(serial_below{0}), v.begin(), v.end(), [&](int) {
+        std::lock_guard lock{mut};
+        threads.insert(std::this_thread::get_id());
+    });
+    return threads.size() <= 2 ? 0 : 1;
+}
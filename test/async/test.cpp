@@ -0,0 +1,55 @@
+#include <pstld/pstld.h>
+#include <numeric>
+#include <vector>
+
+int main()
+{
+    std::vector<int> v(1'000'000);
+    std::iota(v.rbegin(), v.rend(), 0);
+
+    // void results
+    auto sorting = pstld::async::sort(v.begin(), v.end());
+    if( !sorting.valid() )
+        return 1;
+    sorting.wait();
+    if( !sorting.ready() || !std::is_sorted(v.begin(), v.end()) )
+        return 1;
+    sorting.get();
+    if( sorting.valid() || sorting.ready() )
+        return 1;
+
+    // values, with and without a policy
+    auto sum = pstld::async::reduce(v.begin(), v.end(), 0L);
+    auto squares = pstld::async::transform_reduce(
+        pstld::execution::par, v.begin(), v.end(), 0L, std::plus<>{}, [](int x) {
+            return long(x % 10) * (x % 10);
+        });
+    auto found = pstld::async::find(v.begin(), v.end(), 500'000);
+    if( sum.get() != std::accumulate(v.begin(), v.end(), 0L) )
+        return 1;
+    if( squares.get() != 28'500'000 )
+        return 1;
+    if( found.get() != v.begin() + 500'000 )
+        return 1;
+
+    // several algorithms in flight on disjoint data, handles can be moved around
+    std::vector<int> a(v.rbegin(), v.rend());
+    std::vector<int> b(v.rbegin(), v.rend());
+    std::vector<pstld::async::handle<void>> handles;
+    handles.push_back(pstld::async::sort(a.begin(), a.end()));
+    handles.push_back(pstld::async::stable_sort(b.begin(), b.end(), std::less<>{}));
+    for( auto &h : handles )
+        h.wait();
+    if( !std::is_sorted(a.begin(), a.end()) || !std::is_sorted(b.begin(), b.end()) )
+        return 1;
+
+    // the destructor waits
+    {
+        auto filling = pstld::async::fill(a.begin(), a.end(), 7);
+    }
+    if( std::count(a.begin(), a.end(), 7) != static_cast<long>(a.size()) )
+        return 1;
+
+    pstld::async::handle<int> empty;
+    return empty.valid() || empty.ready() ? 1 : 0;
+}
@@ -0,0 +1,69 @@
+#include <pstld/pstld.h>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "../inline_pool.h"
+
+int main()
+{
+    using namespace pstld::execution;
+
+    InlinePool pool;
+    const pstld::executor exec = pstld::make_executor(pool);
+    const auto policy = par.on(exec).with(serial_below{0});
+
+    std::vector<int> v(100'000);
+    std::iota(v.rbegin(), v.rend(), 0);
+
+    // a token nobody stops changes nothing
+    pstld::stop_source idle;
+    if( idle.stop_requested() || !idle.get_token().stop_possible() ||
+        pstld::stop_token{}.stop_possible() )
+        return 1;
+    if( pstld::reduce(policy.with(idle.get_token()), v.begin(), v.end(), 0L) !=
+        std::accumulate(v.begin(), v.end(), 0L) )
+        return 1;
+
+    // the chunks following the stop request are skipped
+    {
+        pstld::stop_source source;
+        std::atomic<size_t> visited{0};
+        pstld::for_each(policy.with(source.get_token()), v.begin(), v.end(), [&](int) {
+            if( ++visited == 1 && !source.request_stop() )
+                ++visited;
+        });
+        if( !source.stop_requested() || source.request_stop() || visited == 0 ||
+            visited >= v.size() )
+            return 1;
+    }
+
+    // sorted ranges keep their elements
+    for( int stable = 0; stable != 2; ++stable ) {
+        pstld::stop_source source;
+        source.request_stop();
+        auto w = v;
+        if( stable )
+            pstld::stable_sort(policy.with(source.get_token()), w.begin(), w.end());
+        else
+            pstld::sort(policy.with(source.get_token()), w.begin(), w.end());
+        std::sort(w.begin(), w.end());
+        if( !std::equal(w.begin(), w.end(), v.rbegin(), v.rend()) )
+            return 1;
+    }
+
+    // stopped reductions and scans leave no half-built values behind
+    {
+        pstld::stop_source source;
+        source.request_stop();
+        const auto stopped = policy.with(source.get_token());
+        std::vector<std::string> s(10'000, "a");
+        pstld::reduce(stopped, s.begin(), s.end(), std::string{});
+        pstld::inclusive_scan(stopped, s.begin(), s.end(), s.begin());
+        pstld::exclusive_scan(stopped, s.begin(), s.end(), s.begin(), std::string{});
+        pstld::minmax_element(stopped, v.begin(), v.end());
+    }
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include <pstld/pstld.h>
+#include <algorithm>
+#include <forward_list>
+#include <numeric>
+#include <vector>
+#include "../inline_pool.h"
+
+int main()
+{
+    using namespace pstld::execution;
+    using pstld::algorithm;
+
+    InlinePool pool;
+    const pstld::executor exec = pstld::make_executor(pool);
+    const auto eager = par.on(exec).with(serial_below{0});
+
+    // chunks right below, at and right above a word of the bitmask, and spanning several words
+    for( const size_t chunk : {63, 64, 65, 129} ) {
+        const auto policy = eager.with(grain{chunk});
+        std::vector<int> v(5 * chunk);
+        std::iota(v.begin(), v.end(), 0);
+        const size_t n = v.size();
+
+        const auto p = pstld::explain<int>(algorithm::copy_if, n, policy);
+        if( !p.parallel || p.chunks != 5 || p.chunk_min != chunk || p.chunk_max != chunk ||
+            p.scratch_bytes == 0 )
+            return 1;
+
+        // none, every other and all of the elements selected
+        for( const int every : {0, 2, 1} ) {
+            const auto pred = [every](int x) { return every != 0 && x % every == 0; };
+            std::vector<int> expected(n, -1);
+            const auto expected_end = std::copy_if(v.begin(), v.end(), expected.begin(), pred);
+
+            std::vector<int> out(n, -1);
+            pool.last_n = 0;
+            const auto end = pstld::copy_if(policy, v.begin(), v.end(), out.begin(), pred);
+            if( pool.last_n != p.chunks || out != expected ||
+                end - out.begin() != expected_end - expected.begin() )
+                return 1;
+
+            // an output which can only be walked forwards
+            std::forward_list<int> list(n, -1);
+            pool.last_n = 0;
+            const auto list_end = pstld::copy_if(policy, v.begin(), v.end(), list.begin(), pred);
+            if( pool.last_n != p.chunks ||
+                !std::equal(list.begin(), list.end(), expected.begin()) ||
+                std::distance(list.begin(), list_end) != expected_end - expected.begin() )
+                return 1;
+        }
+    }
+    return 0;
+}
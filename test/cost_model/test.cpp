@@ -0,0 +1,80 @@
+#include <pstld/pstld.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+int main()
+{
+    // the first use hands the probe over to a worker and returns meanwhile, a profile file which
+    // fails to parse is neither used nor overwritten
+    const char *garbage = "pstld-cost-profile-garbage.txt";
+    const char contents[] = "not a profile\n";
+    std::FILE *file = std::fopen(garbage, "w");
+    if( file == nullptr || std::fputs(contents, file) < 0 || std::fclose(file) != 0 )
+        return 1;
+    setenv("PSTLD_COST_PROFILE", garbage, 1);
+    const double assumed = pstld::current_cost_profile().fork_join_ns;
+    for( int i = 0; i != 10'000 && pstld::current_cost_profile().fork_join_ns == assumed; ++i )
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    char read[sizeof(contents)] = {};
+    file = std::fopen(garbage, "r");
+    if( file == nullptr || std::fread(read, 1, sizeof(read) - 1, file) != sizeof(read) - 1 ||
+        std::strcmp(read, contents) != 0 )
+        return 1;
+    std::fclose(file);
+    std::remove(garbage);
+
+    const pstld::cost_profile measured = pstld::calibrate_cost_profile();
+    if( !(measured.fork_join_ns >= 0.) )
+        return 1;
+    if( pstld::current_cost_profile().fork_join_ns != measured.fork_join_ns )
+        return 1;
+
+    // a profile survives a round trip through a file
+    const char *path = "pstld-cost-profile.txt";
+    pstld::set_cost_profile({1234.5});
+    if( !pstld::save_cost_profile(path) )
+        return 1;
+    pstld::set_cost_profile({1.});
+    if( !pstld::load_cost_profile(path) || pstld::current_cost_profile().fork_join_ns != 1234.5 )
+        return 1;
+    std::remove(path);
+    if( pstld::load_cost_profile(path) || pstld::current_cost_profile().fork_join_ns != 1234.5 )
+        return 1;
+
+    // with a prohibitive overhead everything runs inline on the calling thread
+    pstld::set_cost_profile({1e15});
+    const auto caller = std::this_thread::get_id();
+    std::vector<std::thread::id> ids(1'000'000);
+    pstld::for_each(pstld::execution::par, ids.begin(), ids.end(), [](std::thread::id &id) {
+        id = std::this_thread::get_id();
+    });
+    for( const auto &id : ids )
+        if( id != caller )
+            return 1;
+
+    // including the searches, which split their input differently
+    std::vector<int> w(1'000, 0);
+    w[500] = 1;
+    const std::vector<int> needle = {0, 1};
+    if( pstld::search(w.begin(), w.end(), needle.begin(), needle.end()) != w.begin() + 499 ||
+        pstld::find_end(w.begin(), w.end(), needle.begin(), needle.end()) != w.begin() + 499 ||
+        pstld::search_n(w.begin(), w.end(), 2, 1) != w.end() )
+        return 1;
+    pstld::reverse(w.begin(), w.end());
+    std::vector<int> diff(w.size());
+    pstld::adjacent_difference(w.begin(), w.end(), diff.begin());
+    if( w[499] != 1 || diff[499] != 1 || diff[500] != -1 )
+        return 1;
+
+    // an explicit serial_below overrides the model, the results are the same either way
+    std::vector<int> v(100'000, 1);
+    const auto eager = pstld::execution::par.with(pstld::execution::serial_below{0});
+    if( pstld::reduce(eager, v.begin(), v.end(), 0) != 100'000 )
+        return 1;
+
+    return 0;
+}
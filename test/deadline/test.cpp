@@ -0,0 +1,81 @@
+#include <pstld/pstld.h>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include "../inline_pool.h"
+
+int main()
+{
+    using namespace pstld::execution;
+    using clock = std::chrono::steady_clock;
+
+    InlinePool pool;
+    const pstld::executor exec = pstld::make_executor(pool);
+    const auto policy = par.on(exec).with(serial_below{0});
+    const auto later = clock::now() + std::chrono::hours(1);
+    const auto past = clock::now();
+
+    std::vector<int> v(100'000);
+    std::iota(v.begin(), v.end(), 0);
+    const size_t total = v.size();
+    const auto even = [](int i) { return i % 2 == 0; };
+
+    // enough time gives the exact answers
+    {
+        auto c = pstld::bounded_count_if(policy, later, v.begin(), v.end(), even);
+        auto f = pstld::bounded_find(policy, later, v.begin(), v.end(), 77'777);
+        auto r = pstld::bounded_reduce(policy, later, v.begin(), v.end(), 0L);
+        if( !c.complete() || c.value != 50'000 || c.total != total )
+            return 1;
+        if( !f.complete() || f.value != v.begin() + 77'777 )
+            return 1;
+        if( !r.complete() || r.value != std::accumulate(v.begin(), v.end(), 0L) )
+            return 1;
+    }
+
+    // an expired deadline gives empty answers, whether parallel or not
+    {
+        auto c = pstld::bounded_count_if(policy, past, v.begin(), v.end(), even);
+        auto f = pstld::bounded_find(past, v.begin(), v.end(), 77'777);
+        auto r = pstld::bounded_transform_reduce(
+            past, v.begin(), v.end(), 5L, std::plus<>{}, [](int i) { return long(i); });
+        if( c.covered != 0 || c.value != 0 || c.complete() )
+            return 1;
+        if( f.covered != 0 || f.value != v.end() )
+            return 1;
+        if( r.covered != 0 || r.value != 5 )
+            return 1;
+    }
+
+    // the answer accounts for exactly the covered elements
+    {
+        const auto slow = [](int) {
+            std::this_thread::sleep_for(std::chrono::microseconds(10));
+            return true;
+        };
+        auto c = pstld::bounded_count_if(
+            policy, clock::now() + std::chrono::milliseconds(20), v.begin(), v.end(), slow);
+        if( c.complete() || c.covered == 0 || static_cast<size_t>(c.value) != c.covered )
+            return 1;
+    }
+
+    // a chunk started before the deadline runs to its end, the following ones are skipped
+    {
+        size_t calls = 0;
+        const auto first_chunk_expires = [&](int i) {
+            if( calls++ == 0 )
+                std::this_thread::sleep_for(std::chrono::milliseconds(30));
+            return i == 99'999;
+        };
+        auto f = pstld::bounded_find_if(policy,
+                                        clock::now() + std::chrono::milliseconds(10),
+                                        v.begin(),
+                                        v.end(),
+                                        first_chunk_expires);
+        if( f.complete() || f.value != v.end() || f.covered == 0 )
+            return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <pstld/pstld.h>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include "../inline_pool.h"
+
+// A deliberately naive executor which spawns a thread per request and counts its usage
+struct CountingPool {
+    std::atomic<size_t> bulks{0};
+    std::atomic<size_t> asyncs{0};
+
+    void bulk_execute(size_t n, void *ctx, void (*fn)(void *, size_t)) noexcept
+    {
+        ++bulks;
+        std::atomic<size_t> next{0};
+        auto body = [&] {
+            for( size_t i = next++; i < n; i = next++ )
+                fn(ctx, i);
+        };
+        std::vector<std::thread> threads;
+        for( size_t i = 1; i < std::min(n, concurrency()); ++i )
+            threads.emplace_back(body);
+        body();
+        for( auto &t : threads )
+            t.join();
+    }
+
+    void async(void *ctx, void (*fn)(void *)) noexcept
+    {
+        ++asyncs;
+        std::thread([=] { fn(ctx); }).detach();
+    }
+
+    size_t concurrency() const noexcept { return 3; }
+};
+
+static std::vector<int> make_input()
+{
+    std::vector<int> v(100'000);
+    for( size_t i = 0; i < v.size(); ++i )
+        v[i] = static_cast<int>((i * 7919) % v.size());
+    return v;
+}
+
+template <class Pool>
+static bool run_all(Pool &pool, const pstld::executor &exec, bool per_call)
+{
+    auto v = make_input();
+    const size_t bulks = pool.bulks;
+    const size_t asyncs = pool.asyncs;
+
+    long sum;
+    if( per_call )
+        sum = pstld::reduce(pstld::execution::par.on(exec), v.begin(), v.end(), 0L);
+    else
+        sum = pstld::reduce(v.begin(), v.end(), 0L);
+    if( sum != std::accumulate(v.begin(), v.end(), 0L) || pool.bulks == bulks )
+        return false;
+
+    if( per_call )
+        pstld::sort(pstld::execution::par.on(exec), v.begin(), v.end());
+    else
+        pstld::sort(v.begin(), v.end());
+    if( !std::is_sorted(v.begin(), v.end()) || pool.asyncs == asyncs )
+        return false;
+
+    if( per_call )
+        pstld::stable_sort(pstld::execution::par.on(exec), v.begin(), v.end(), std::greater<>{});
+    else
+        pstld::stable_sort(v.begin(), v.end(), std::greater<>{});
+    if( !std::is_sorted(v.begin(), v.end(), std::greater<>{}) )
+        return false;
+
+    std::vector<int> a(v.begin(), v.begin() + v.size() / 2);
+    std::vector<int> b(v.begin() + v.size() / 2, v.end());
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    std::vector<int> merged(v.size());
+    if( per_call )
+        pstld::merge(pstld::execution::par.on(exec),
+                     a.begin(),
+                     a.end(),
+                     b.begin(),
+                     b.end(),
+                     merged.begin());
+    else
+        pstld::merge(a.begin(), a.end(), b.begin(), b.end(), merged.begin());
+    return std::is_sorted(merged.begin(), merged.end());
+}
+
+int main()
+{
+    CountingPool pool;
+    const pstld::executor exec = pstld::make_executor(pool);
+
+    // passed per call
+    if( !run_all(pool, exec, true) )
+        return 1;
+
+    // the built-in backend is still used by calls without an executor
+    const size_t bulks = pool.bulks;
+    auto v = make_input();
+    pstld::for_each(v.begin(), v.end(), [](int &x) { ++x; });
+    if( pool.bulks != bulks )
+        return 1;
+
+    // installed globally
+    pstld::set_default_executor(&exec);
+    if( pstld::default_executor() != &exec || !run_all(pool, exec, false) )
+        return 1;
+    pstld::set_default_executor(nullptr);
+
+    // an executor which runs everything on the calling thread, the helpers of sort and merge
+    // included
+    InlinePool inline_pool;
+    const pstld::executor inline_exec = pstld::make_executor(inline_pool);
+    if( !run_all(inline_pool, inline_exec, true) )
+        return 1;
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include <pstld/pstld.h>
+#include <numeric>
+#include <vector>
+#include "../inline_pool.h"
+
+// The last call as seen by the tracing hooks
+static pstld::trace::call g_last;
+
+static const pstld::trace::hooks g_hooks{
+    nullptr,
+    nullptr,
+    [](void *, const pstld::trace::call &c) noexcept { g_last = c; },
+    nullptr,
+    nullptr};
+
+// Whether the plan matches the call which has just been made
+static bool matches(const pstld::plan &p)
+{
+    if( !p.parallel )
+        return g_last.workers == 0 && p.workers == 1 && p.chunks == 0 && p.scratch_bytes == 0;
+    return g_last.workers == p.workers && (p.chunks == 0 || g_last.chunks == p.chunks) &&
+           p.chunk_min <= p.chunk_max && p.chunk_max - p.chunk_min <= 1;
+}
+
+int main()
+{
+    using namespace pstld::execution;
+    using pstld::algorithm;
+
+    InlinePool pool;
+    const pstld::executor exec = pstld::make_executor(pool);
+    const auto eager = par.on(exec).with(serial_below{0});
+    const auto lazy = par.on(exec).with(serial_below{1'000'000});
+    pstld::trace::set_hooks(&g_hooks);
+
+    std::vector<int> v(100'000);
+    std::iota(v.rbegin(), v.rend(), 0);
+    const size_t n = v.size();
+
+    auto p = pstld::explain<long>(algorithm::transform_reduce, n, eager);
+    pstld::reduce(eager, v.begin(), v.end(), 0L);
+    if( !p.parallel || !matches(p) || p.chunks * p.chunk_min > n || p.scratch_bytes == 0 )
+        return 1;
+
+    p = pstld::explain<long>(algorithm::transform_reduce, n, lazy);
+    pstld::reduce(lazy, v.begin(), v.end(), 0L);
+    if( p.parallel || !matches(p) )
+        return 1;
+
+    p = pstld::explain<int>(algorithm::fill, n, eager.with(grain{30'000}));
+    pstld::fill(eager.with(grain{30'000}), v.begin(), v.end(), 1);
+    if( !matches(p) || p.chunks != 3 || p.chunk_min != 33'333 || p.chunk_max != 33'334 )
+        return 1;
+
+    p = pstld::explain<int>(algorithm::reverse, n, eager);
+    pstld::reverse(eager, v.begin(), v.end());
+    if( !matches(p) || p.chunk_max * p.chunks < n / 2 )
+        return 1;
+
+    p = pstld::explain<int>(algorithm::min_element, n, eager);
+    pstld::min_element(eager, v.begin(), v.end());
+    if( !matches(p) || p.scratch_bytes != p.chunks * sizeof(int *) )
+        return 1;
+
+    p = pstld::explain<int>(algorithm::sort, n, eager);
+    pstld::sort(eager, v.begin(), v.end());
+    if( !p.parallel || !matches(p) || p.chunks != 0 || p.scratch_bytes == 0 )
+        return 1;
+
+    // stable_sort splits the range by a balanced merge tree and needs a buffer as large as the range
+    p = pstld::explain<int>(algorithm::stable_sort, n, eager);
+    pstld::stable_sort(eager, v.begin(), v.end());
+    if( !matches(p) || p.tree_height == 0 || p.chunks != size_t(1) << p.tree_height ||
+        p.tree_height % 2 != 0 || p.scratch_bytes < n * sizeof(int) )
+        return 1;
+
+    // a deadline-bounded call runs its chunks one after another when it's not worth going parallel
+    p = pstld::explain<int>(algorithm::bounded_count_if, n, lazy);
+    if( p.parallel || p.workers != 1 || p.chunks < 2 )
+        return 1;
+
+    // calls nested into a parallel one run inline
+    std::vector<pstld::plan> nested(4);
+    pstld::for_each(par.on(exec), nested.begin(), nested.end(), [](pstld::plan &np) {
+        np = pstld::explain<int>(algorithm::for_each, 1'000'000);
+    });
+    for( const auto &np : nested )
+        if( np.parallel )
+            return 1;
+
+    return 0;
+}
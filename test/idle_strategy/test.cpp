@@ -0,0 +1,80 @@
+#include <pstld/pstld.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// An executor backed by real threads: a bulk request runs on up to concurrency() threads and each
+// async task gets a thread of its own, so the helpers of sort and merge run side by side and do go
+// idle while the others finish their pieces
+struct ThreadedPool {
+    std::mutex mutex;
+    std::vector<std::thread> tasks;
+
+    ~ThreadedPool()
+    {
+        for( auto &t : tasks )
+            t.join();
+    }
+
+    void bulk_execute(size_t n, void *ctx, void (*fn)(void *, size_t)) noexcept
+    {
+        std::atomic<size_t> next{0};
+        auto body = [&] {
+            for( size_t i = next++; i < n; i = next++ )
+                fn(ctx, i);
+        };
+        std::vector<std::thread> threads;
+        for( size_t i = 1; i < std::min(n, concurrency()); ++i )
+            threads.emplace_back(body);
+        body();
+        for( auto &t : threads )
+            t.join();
+    }
+
+    void async(void *ctx, void (*fn)(void *)) noexcept
+    {
+        std::lock_guard lock{mutex};
+        tasks.emplace_back([=] { fn(ctx); });
+    }
+
+    size_t concurrency() const noexcept { return 4; }
+};
+
+int main()
+{
+    using pstld::execution::idle_strategy;
+
+    std::vector<int> input(1'000'000);
+    for( size_t i = 0; i < input.size(); ++i )
+        input[i] = static_cast<int>((i * 7919) % input.size());
+    std::vector<int> sorted = input;
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<int> merged(sorted.size() * 2);
+    std::merge(sorted.begin(), sorted.end(), sorted.begin(), sorted.end(), merged.begin());
+
+    // parking right away, the default backoff, and spinning or yielding without ever parking
+    const idle_strategy strategies[] = {{0, 0, true}, {}, {SIZE_MAX, 0, false}, {0, 0, false}};
+    for( const auto &idle : strategies ) {
+        ThreadedPool pool;
+        const pstld::executor exec = pstld::make_executor(pool);
+        const auto policy = pstld::execution::par.on(exec).with(idle);
+        for( int round = 0; round != 3; ++round ) {
+            std::vector<int> v = input;
+            pstld::sort(policy, v.begin(), v.end());
+            if( v != sorted )
+                return 1;
+            std::vector<int> w(merged.size());
+            pstld::merge(
+                policy, sorted.begin(), sorted.end(), sorted.begin(), sorted.end(), w.begin());
+            if( w != merged )
+                return 1;
+        }
+        // the helpers did run on threads of their own
+        if( pool.tasks.empty() )
+            return 1;
+    }
+    return 0;
+}
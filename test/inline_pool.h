@@ -0,0 +1,27 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// An executor for the custom tests which runs everything on the calling thread, one chunk after
+// another, and counts what it was asked to do
+struct InlinePool {
+    std::atomic<size_t> bulks{0};
+    std::atomic<size_t> asyncs{0};
+    std::atomic<size_t> last_n{0}; // the number of chunks of the last bulk_execute()
+
+    void bulk_execute(size_t n, void *ctx, void (*fn)(void *, size_t)) noexcept
+    {
+        ++bulks;
+        last_n = n;
+        for( size_t i = 0; i != n; ++i )
+            fn(ctx, i);
+    }
+
+    void async(void *ctx, void (*fn)(void *)) noexcept
+    {
+        ++asyncs;
+        fn(ctx);
+    }
+
+    size_t concurrency() const noexcept { return 4; }
+};
@@ -0,0 +1,52 @@
+#include <pstld/pstld.h>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+#include "../inline_pool.h"
+
+int main()
+{
+    using namespace pstld::execution;
+
+    InlinePool outer_pool;
+    InlinePool inner_pool;
+    const pstld::executor outer_exec = pstld::make_executor(outer_pool);
+    const pstld::executor inner_exec = pstld::make_executor(inner_pool);
+    const auto outer = par.on(outer_exec);
+    const auto inner = par.on(inner_exec);
+
+    std::vector<std::vector<int>> rows(64, std::vector<int>(10'000));
+    for( auto &row : rows )
+        std::iota(row.rbegin(), row.rend(), 0);
+    const long row_sum = std::accumulate(rows[0].begin(), rows[0].end(), 0L);
+
+    // the calls made from within the chunks of another call run inline
+    std::atomic<size_t> bad_sums{0};
+    pstld::for_each(outer, rows.begin(), rows.end(), [&](std::vector<int> &row) {
+        pstld::sort(inner, row.begin(), row.end());
+        if( pstld::reduce(inner, row.begin(), row.end(), 0L) != row_sum )
+            ++bad_sums;
+    });
+    if( outer_pool.bulks != 1 || inner_pool.bulks != 0 || inner_pool.asyncs != 0 || bad_sums != 0 )
+        return 1;
+    for( const auto &row : rows )
+        if( !std::is_sorted(row.begin(), row.end()) )
+            return 1;
+
+    // unless explicitly asked to go parallel
+    pstld::for_each(outer, rows.begin(), rows.end(), [&](std::vector<int> &row) {
+        if( pstld::reduce(inner.with(serial_below{0}), row.begin(), row.end(), 0L) != row_sum )
+            ++bad_sums;
+    });
+    if( inner_pool.bulks != rows.size() || bad_sums != 0 )
+        return 1;
+
+    // the nesting ends with the outer call
+    const size_t bulks = inner_pool.bulks;
+    if( pstld::reduce(inner, rows[0].begin(), rows[0].end(), 0L) != row_sum ||
+        inner_pool.bulks != bulks + 1 )
+        return 1;
+
+    return 0;
+}
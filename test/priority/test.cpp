@@ -0,0 +1,59 @@
+#include <pstld/pstld.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+#if defined(__linux__) && defined(PSTLD_INTERNAL_BACKEND_THREADS)
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+
+// The niceness of the calling thread, the thread pool sets it for the background workers
+static int niceness() noexcept
+{
+    return getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+}
+#endif
+
+template <class ExPo>
+static bool works(const ExPo &policy)
+{
+    std::vector<int> v(1'000'000);
+    std::iota(v.rbegin(), v.rend(), 0);
+    pstld::sort(policy, v.begin(), v.end());
+    if( !std::is_sorted(v.begin(), v.end()) )
+        return false;
+    const long expected = long(v.size()) * long(v.size() - 1) / 2;
+    if( pstld::reduce(policy, v.begin(), v.end(), 0L) != expected )
+        return false;
+    return pstld::async::reduce(policy, v.begin(), v.end(), 0L).get() == expected;
+}
+
+int main()
+{
+    using namespace pstld::execution;
+
+    if( !works(par_background) || !works(par_utility) || !works(par_user_initiated) ||
+        !works(par_user_interactive) || !works(par.with(priority::normal)) )
+        return 1;
+
+#if defined(__linux__) && defined(PSTLD_INTERNAL_BACKEND_THREADS)
+    // the helpers of background calls run with a lowered priority
+    const auto caller = std::this_thread::get_id();
+    const int caller_niceness = niceness();
+    std::atomic<bool> not_lowered{false};
+    std::vector<int> v(1'000);
+    pstld::for_each(par_background.with(serial_below{0}), v.begin(), v.end(), [&](int) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100)); // let the helpers join
+        if( std::this_thread::get_id() != caller && niceness() <= caller_niceness &&
+            caller_niceness < 19 )
+            not_lowered = true;
+    });
+    if( not_lowered )
+        return 1;
+#endif
+
+    return 0;
+}
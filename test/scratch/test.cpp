@@ -0,0 +1,163 @@
+#include <pstld/pstld.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <numeric>
+#include <vector>
+#include "../inline_pool.h"
+
+static std::atomic<size_t> g_allocations{0};
+
+void *operator new(size_t size)
+{
+    ++g_allocations;
+    if( void *ptr = std::malloc(size == 0 ? 1 : size) )
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    ++g_allocations;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new(size_t size, std::align_val_t align)
+{
+    if( void *ptr = operator new(size, align, std::nothrow) )
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void *operator new(size_t size, std::align_val_t align, const std::nothrow_t &) noexcept
+{
+    ++g_allocations;
+    const size_t alignment = static_cast<size_t>(align);
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+int main()
+{
+    using namespace pstld::execution;
+
+    InlinePool pool;
+    const pstld::executor exec = pstld::make_executor(pool);
+    const auto policy = par.on(exec).with(serial_below{0});
+
+    std::vector<double> v(100'000);
+    std::vector<double> out(v.size());
+    const auto calls = [&] {
+        std::iota(v.rbegin(), v.rend(), 0.);
+        pstld::sort(policy, v.begin(), v.end());
+        std::iota(v.rbegin(), v.rend(), 0.);
+        pstld::stable_sort(policy, v.begin(), v.end());
+        pstld::reduce(policy, v.begin(), v.end(), 0.);
+        pstld::minmax_element(policy, v.begin(), v.end());
+        pstld::inclusive_scan(policy, v.begin(), v.end(), out.begin());
+        const auto mid = v.begin() + 50'000;
+        pstld::merge(policy, v.begin(), mid, mid, v.end(), out.begin());
+    };
+
+    // the first round fills the cache, the next ones don't touch the heap
+    calls();
+    const auto warm = pstld::scratch_stats();
+    const size_t allocations = g_allocations;
+    for( int i = 0; i != 3; ++i )
+        calls();
+    const auto steady = pstld::scratch_stats();
+    if( g_allocations != allocations || steady.misses != warm.misses || steady.hits <= warm.hits ||
+        steady.cached_bytes == 0 || steady.cached_bytes > pstld::scratch_cache_limit )
+        return 1;
+
+    pstld::release_scratch();
+    if( pstld::scratch_stats().cached_bytes != 0 )
+        return 1;
+
+    // stable_sort takes its O(n) buffer from the caller, whether it runs in parallel or not, so
+    // it doesn't allocate once the scratch cache is warm again
+    struct Item {
+        int key;
+        int order;
+    };
+    std::vector<Item> items(100'000);
+    std::vector<Item> buffer(items.size());
+    const auto by_key = [](const Item &a, const Item &b) { return a.key < b.key; };
+    const auto stable = [&] {
+        for( size_t i = 0; i != items.size(); ++i )
+            if( i != 0 && items[i - 1].key == items[i].key && items[i - 1].order > items[i].order )
+                return false;
+        return std::is_sorted(items.begin(), items.end(), by_key);
+    };
+    for( size_t cutoff : {size_t(0), std::numeric_limits<size_t>::max()} ) {
+        const auto p = par.on(exec).with(serial_below{cutoff});
+        for( int round = 0; round != 2; ++round ) {
+            for( size_t i = 0; i != items.size(); ++i )
+                items[i] = {int(items.size() - i) % 1000, int(i)};
+            const size_t before = g_allocations;
+            pstld::stable_sort(p, items.begin(), items.end(), by_key, buffer);
+            if( (round != 0 && g_allocations != before) || !stable() )
+                return 1;
+        }
+    }
+
+    // a smaller buffer is ignored
+    std::vector<Item> small(10);
+    for( size_t i = 0; i != items.size(); ++i )
+        items[i] = {int(items.size() - i) % 1000, int(i)};
+    pstld::stable_sort(policy, items.begin(), items.end(), by_key, small);
+    if( !stable() )
+        return 1;
+
+    // the blocks of huge_page_threshold bytes and more are mapped directly, with or without the
+    // huge page advice and the prefaulting, and go back to the OS instead of the cache
+    v.resize(pstld::huge_page_threshold / sizeof(double));
+    for( bool huge_pages : {true, false} ) {
+        pstld::set_huge_pages(huge_pages);
+        std::iota(v.rbegin(), v.rend(), 0.);
+        pstld::stable_sort(policy, v.begin(), v.end());
+        if( !std::is_sorted(v.begin(), v.end()) ||
+            pstld::scratch_stats().cached_bytes >= pstld::huge_page_threshold )
+            return 1;
+        pstld::release_scratch();
+    }
+    pstld::set_huge_pages(true);
+
+    // a call nested into another parallel one faults the pages of such a block in by itself
+    // instead of forking from within the outer call's chunk
+    std::vector<int> outer(2);
+    const size_t bulks = pool.bulks;
+    pstld::for_each(policy, outer.begin(), outer.end(), [&](int &sorted) {
+        if( &sorted != &outer.front() )
+            return;
+        std::iota(v.rbegin(), v.rend(), 0.);
+        pstld::stable_sort(policy, v.begin(), v.end());
+        sorted = std::is_sorted(v.begin(), v.end());
+    });
+    if( outer.front() != 1 || pool.bulks != bulks + 1 )
+        return 1;
+    pstld::release_scratch();
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <pstld/pstld.h>
+#include <numeric>
+#include <vector>
+
+int main()
+{
+    namespace ps = pstld::senders;
+    const pstld::scheduler sched;
+
+    // schedule() completes on the backend, then() chains on the same thread
+    auto hello = ps::then(sched.schedule(), [] { return 42; });
+    if( std::get<0>(ps::sync_wait(hello).value()) != 42 )
+        return 1;
+
+    // bulk runs through the parallel loop of the backend
+    std::vector<int> squares(1000);
+    auto fill = ps::bulk(ps::just(7), squares.size(), [&](size_t i, int add) {
+        squares[i] = static_cast<int>(i * i) + add;
+    });
+    if( std::get<0>(ps::sync_wait(fill).value()) != 7 )
+        return 1;
+    for( size_t i = 0; i != squares.size(); ++i )
+        if( squares[i] != static_cast<int>(i * i) + 7 )
+            return 1;
+
+    // algorithm stages chained without joining in between
+    std::vector<long> v(1'000'000);
+    std::iota(v.rbegin(), v.rend(), 0);
+    std::vector<long> prefix(v.size());
+    auto sorted = ps::sort(sched.schedule(), v.begin(), v.end());
+    auto scanned =
+        ps::inclusive_scan(sorted, v.begin(), v.end(), prefix.begin(), std::plus<long>{});
+    auto total =
+        ps::then(scanned, [&](auto last) { return last == prefix.end() ? prefix.back() : -1; });
+    const long expected = long(v.size()) * long(v.size() - 1) / 2;
+    if( std::get<0>(ps::sync_wait(total).value()) != expected )
+        return 1;
+    if( !std::is_sorted(v.begin(), v.end()) )
+        return 1;
+
+    // independent stages in parallel, their values are concatenated
+    std::vector<double> a(100'000, 0.5);
+    std::vector<double> b(100'000);
+    auto both = ps::when_all(ps::reduce(sched.schedule(), a.begin(), a.end(), 0.),
+                             ps::transform(sched.schedule(),
+                                           a.begin(),
+                                           a.end(),
+                                           b.begin(),
+                                           [](double x) { return x * 4; }),
+                             sched.schedule());
+    auto [sum, last] = ps::sync_wait(both).value();
+    if( sum != 50'000. || last != b.end() || b.front() != 2. || b.back() != 2. )
+        return 1;
+
+    return pstld::scheduler{} == sched ? 0 : 1;
+}
@@ -0,0 +1,2 @@
+#include "f.h"
+// this file is here to check there's no linker errors caused by duplicate symbols
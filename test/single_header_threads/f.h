@@ -0,0 +1,5 @@
+#pragma once
+#define PSTLD_HEADER_ONLY
+#define PSTLD_HACK_INTO_STD
+#define PSTLD_BACKEND_THREADS
+#include <pstld/pstld.h>
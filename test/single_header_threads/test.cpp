@@ -0,0 +1,31 @@
+#include "f.h"
+#include <numeric>
+#include <vector>
+
+int main()
+{
+    std::vector<int> v(100'000);
+    for( size_t i = 0; i < v.size(); ++i )
+        v[i] = static_cast<int>((i * 7919) % v.size());
+
+    std::sort(std::execution::par, v.begin(), v.end());
+    if( !std::is_sorted(v.begin(), v.end()) )
+        return 1;
+
+    std::stable_sort(std::execution::par, v.begin(), v.end(), std::greater<>{});
+    if( !std::is_sorted(v.begin(), v.end(), std::greater<>{}) )
+        return 1;
+
+    const long sum = std::reduce(std::execution::par, v.begin(), v.end(), 0L);
+    if( sum != std::accumulate(v.begin(), v.end(), 0L) )
+        return 1;
+
+    // nested parallel calls must not deadlock the pool
+    std::vector<std::vector<int>> vv(16, v);
+    std::for_each(std::execution::par, vv.begin(), vv.end(), [](std::vector<int> &w) {
+        std::sort(std::execution::par, w.begin(), w.end());
+    });
+    return !std::all_of(vv.begin(), vv.end(), [](const std::vector<int> &w) {
+        return std::is_sorted(w.begin(), w.end());
+    });
+}
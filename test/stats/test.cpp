@@ -0,0 +1,128 @@
+#include <pstld/pstld.h>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include "../inline_pool.h"
+
+// Fails the aligned allocations of the scratch memory while set
+static std::atomic<bool> g_fail_allocations{false};
+
+void *operator new(size_t size, std::align_val_t align, const std::nothrow_t &) noexcept
+{
+    if( g_fail_allocations )
+        return nullptr;
+    try {
+        return ::operator new(size, align);
+    } catch( ... ) {
+        return nullptr;
+    }
+}
+
+static pstld::algorithm_counters of(const pstld::runtime_counters &s, const char *algorithm)
+{
+    for( const auto &a : s.algorithms )
+        if( std::strcmp(a.algorithm, algorithm) == 0 )
+            return a;
+    return {};
+}
+
+// The difference in the calls of 'algorithm' between two snapshots, only the parallel calls are
+// timed
+static bool counted(const pstld::runtime_counters &before,
+                    const pstld::runtime_counters &after,
+                    const char *algorithm,
+                    size_t parallel,
+                    size_t serial,
+                    size_t fallbacks)
+{
+    const auto b = of(before, algorithm);
+    const auto a = of(after, algorithm);
+    size_t latency = 0;
+    for( size_t i = 0; i != pstld::latency_buckets; ++i )
+        latency += a.latency[i] - b.latency[i];
+    return a.parallel - b.parallel == parallel && a.serial - b.serial == serial &&
+           a.fallbacks - b.fallbacks == fallbacks && latency == parallel;
+}
+
+int main()
+{
+    using namespace pstld::execution;
+
+    InlinePool pool;
+    const pstld::executor exec = pstld::make_executor(pool);
+    const auto policy = par.on(exec).with(serial_below{0});
+
+    const auto initial = pstld::stats();
+    for( const auto &a : initial.algorithms )
+        if( a.algorithm == nullptr )
+            return 1;
+    if( of(initial, "sort").algorithm == nullptr )
+        return 1;
+
+    std::vector<int> v(100'000);
+    std::iota(v.begin(), v.end(), 0);
+
+    // a parallel call
+    auto before = pstld::stats();
+    pstld::reduce(policy, v.begin(), v.end(), 0L);
+    auto after = pstld::stats();
+    if( !counted(before, after, "transform_reduce", 1, 0, 0) )
+        return 1;
+
+    // a call too small to go parallel
+    before = after;
+    pstld::fill(par.on(exec).with(serial_below{1'000}), v.begin(), v.begin() + 10, 1);
+    after = pstld::stats();
+    if( !counted(before, after, "fill", 0, 1, 0) ||
+        !counted(before, after, "transform_reduce", 0, 0, 0) )
+        return 1;
+
+    // so is a call which returns before even looking at its elements
+    before = after;
+    pstld::search(policy, v.begin(), v.end(), v.begin(), v.begin());
+    pstld::search_n(policy, v.begin(), v.end(), 0, 1);
+    pstld::find_end(policy, v.begin(), v.begin(), v.begin(), v.end());
+    after = pstld::stats();
+    if( !counted(before, after, "search", 0, 1, 0) || !counted(before, after, "search_n", 0, 1, 0) ||
+        !counted(before, after, "find_end", 0, 1, 0) )
+        return 1;
+
+    // a call which couldn't allocate its scratch memory falls back to the serial path
+    before = after;
+    pstld::release_scratch();
+    g_fail_allocations = true;
+    const long sum = pstld::reduce(policy, v.begin(), v.end(), 0L);
+    g_fail_allocations = false;
+    after = pstld::stats();
+    if( sum != std::accumulate(v.begin(), v.end(), 0L) ||
+        !counted(before, after, "transform_reduce", 0, 1, 1) )
+        return 1;
+
+    // a serial call made from within a parallel one is counted as serial
+    before = after;
+    std::vector<int> outer(4);
+    pstld::for_each(policy, outer.begin(), outer.end(), [&](int &) {
+        pstld::fill(par.on(exec).with(serial_below{1'000}), v.begin(), v.begin() + 10, 1);
+    });
+    after = pstld::stats();
+    if( !counted(before, after, "for_each", 1, 0, 0) || !counted(before, after, "fill", 0, 4, 0) )
+        return 1;
+
+    // the counts of the threads which have exited are kept
+    before = after;
+    std::thread([&] { pstld::reduce(policy, v.begin(), v.end(), 0L); }).join();
+    after = pstld::stats();
+    if( !counted(before, after, "transform_reduce", 1, 0, 0) )
+        return 1;
+
+    // the counters of the work-stealing and of the idle workers only grow
+    std::iota(v.rbegin(), v.rend(), 0);
+    before = after;
+    pstld::sort(par, v.begin(), v.end());
+    after = pstld::stats();
+    return after.steals < before.steals || after.failed_steals < before.failed_steals ||
+           after.yields < before.yields;
+}
@@ -0,0 +1,179 @@
+#include <pstld/pstld.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// An executor with a single thread of its own which claims to run more. A thread waiting for its
+// bulk to complete executes the queued requests meanwhile, the way a work-stealing pool does, so it
+// can pick up a helper of a team which hasn't started yet.
+struct HelpingPool {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::function<void()>> queue;
+    bool quit = false;
+    std::thread thread{[this] {
+        std::unique_lock lock{mutex};
+        while( true ) {
+            cv.wait(lock, [&] { return !queue.empty() || quit; });
+            if( queue.empty() )
+                return;
+            auto job = std::move(queue.front());
+            queue.pop_front();
+            lock.unlock();
+            job();
+            lock.lock();
+        }
+    }};
+
+    ~HelpingPool()
+    {
+        {
+            std::lock_guard lock{mutex};
+            quit = true;
+        }
+        cv.notify_all();
+        thread.join();
+    }
+
+    void post(std::function<void()> job)
+    {
+        {
+            std::lock_guard lock{mutex};
+            queue.push_back(std::move(job));
+        }
+        cv.notify_one();
+    }
+
+    bool run_one()
+    {
+        std::unique_lock lock{mutex};
+        if( queue.empty() )
+            return false;
+        auto job = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        job();
+        return true;
+    }
+
+    void bulk_execute(size_t n, void *ctx, void (*fn)(void *, size_t)) noexcept
+    {
+        std::atomic<size_t> left{n};
+        for( size_t i = 0; i != n; ++i )
+            post([&left, ctx, fn, i] {
+                fn(ctx, i);
+                --left;
+            });
+        while( left != 0 )
+            if( !run_one() )
+                std::this_thread::yield();
+    }
+
+    void async(void *ctx, void (*fn)(void *)) noexcept
+    {
+        post([ctx, fn] { fn(ctx); });
+    }
+
+    size_t concurrency() const noexcept { return 4; }
+};
+
+static long fib(int n)
+{
+    if( n < 2 )
+        return n;
+    if( n < 16 )
+        return fib(n - 1) + fib(n - 2);
+    long a = 0;
+    long b = 0;
+    pstld::parallel_invoke([&] { a = fib(n - 1); }, [&] { b = fib(n - 2); });
+    return a + b;
+}
+
+// Recursive divide-and-conquer with a group per level, the way a tree build would do it
+static void build(std::vector<int> &v, size_t first, size_t last, std::atomic<size_t> &leaves)
+{
+    if( last - first <= 64 ) {
+        for( size_t i = first; i != last; ++i )
+            v[i] = static_cast<int>(i);
+        ++leaves;
+        return;
+    }
+    const size_t mid = first + (last - first) / 2;
+    pstld::task_group group;
+    group.run([&] { build(v, first, mid, leaves); });
+    group.run([&] { build(v, mid, last, leaves); });
+    group.wait();
+}
+
+int main()
+{
+    if( fib(27) != 196418 )
+        return 1;
+
+    // three-way invoke
+    int x = 0;
+    int y = 0;
+    int z = 0;
+    pstld::parallel_invoke([&] { x = 1; }, [&] { y = 2; }, [&] { z = 3; });
+    if( x + y + z != 6 )
+        return 1;
+
+    std::vector<int> v(100'000, -1);
+    std::atomic<size_t> leaves{0};
+    build(v, 0, v.size(), leaves);
+    for( size_t i = 0; i != v.size(); ++i )
+        if( v[i] != static_cast<int>(i) )
+            return 1;
+    if( leaves == 0 )
+        return 1;
+
+    // tasks spawning more tasks into the same group, the group is reused after wait()
+    pstld::task_group group;
+    for( int round = 0; round != 3; ++round ) {
+        std::atomic<size_t> done{0};
+        for( int i = 0; i != 100; ++i )
+            group.run([&] {
+                for( int j = 0; j != 10; ++j )
+                    group.run([&] { ++done; });
+                ++done;
+            });
+        group.wait();
+        if( done != 1100 )
+            return 1;
+    }
+
+    // algorithms called from within tasks
+    std::vector<int> a(50'000);
+    std::vector<int> b(50'000);
+    std::iota(a.rbegin(), a.rend(), 0);
+    std::iota(b.rbegin(), b.rend(), 0);
+    pstld::parallel_invoke([&] { pstld::sort(a.begin(), a.end()); },
+                           [&] { pstld::sort(b.begin(), b.end()); });
+    if( !std::is_sorted(a.begin(), a.end()) || !std::is_sorted(b.begin(), b.end()) )
+        return 1;
+
+    // a task waiting for a parallel call of its own, while the helpers of its team are still queued
+    // on the executor
+    HelpingPool helping;
+    const pstld::executor exec = pstld::make_executor(helping);
+    pstld::set_default_executor(&exec);
+    for( int round = 0; round != 10; ++round ) {
+        std::vector<int> w(10'000);
+        pstld::task_group outer;
+        outer.run([&] { pstld::for_each(w.begin(), w.end(), [](int &x) { ++x; }); });
+        outer.wait();
+        if( std::count(w.begin(), w.end(), 1) != static_cast<long>(w.size()) )
+            return 1;
+    }
+    pstld::set_default_executor(nullptr);
+
+    // a group which is never run or waited is fine too
+    pstld::task_group empty;
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include <pstld/pstld.h>
+#include <numeric>
+#include <vector>
+#if defined(__linux__)
+    #include <sched.h>
+#endif
+
+static bool is_sane(const pstld::cpu_topology &t)
+{
+    return t.logical_cpus >= 1 && t.usable_cpus >= 1 && t.physical_cores >= 1 &&
+           t.physical_cores <= t.logical_cpus && t.smt_per_core >= 1 && t.numa_nodes >= 1 &&
+           t.cpu_quota >= 0. && t.workers >= 1 && t.workers <= t.logical_cpus;
+}
+
+int main()
+{
+    if( !is_sane(pstld::topology()) || !is_sane(pstld::refresh_topology()) )
+        return 1;
+
+#if defined(__linux__)
+    // pin the process to a single CPU - the refreshed topology must follow
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if( sched_getaffinity(0, sizeof(set), &set) != 0 )
+        return 1;
+    int cpu = 0;
+    while( !CPU_ISSET(cpu, &set) )
+        ++cpu;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if( sched_setaffinity(0, sizeof(set), &set) != 0 )
+        return 1;
+
+    const pstld::cpu_topology pinned = pstld::refresh_topology();
+    if( !is_sane(pinned) || pinned.usable_cpus != 1 || pinned.workers != 1 )
+        return 1;
+    if( pstld::topology().workers != 1 )
+        return 1;
+#endif
+
+    std::vector<int> v(100'000);
+    std::iota(v.rbegin(), v.rend(), 0);
+    pstld::sort(v.begin(), v.end());
+    return !std::is_sorted(v.begin(), v.end()) ||
+           pstld::reduce(v.begin(), v.end(), 0L) != std::accumulate(v.begin(), v.end(), 0L);
+}
@@ -0,0 +1,175 @@
+#include <pstld/pstld.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <vector>
+#include "../inline_pool.h"
+
+struct Recorder {
+    std::mutex mutex;
+    std::vector<pstld::trace::call> calls; // as seen by the end events
+    size_t open = 0;
+    size_t chunk_begins = 0;
+    size_t chunk_ends = 0;
+
+    void reset()
+    {
+        calls.clear();
+        open = chunk_begins = chunk_ends = 0;
+    }
+
+    static Recorder &of(void *context) { return *static_cast<Recorder *>(context); }
+};
+
+static const pstld::trace::hooks g_hooks{
+    nullptr,
+    [](void *context, const pstld::trace::call &c) noexcept {
+        auto &r = Recorder::of(context);
+        std::lock_guard lock{r.mutex};
+        if( c.workers == 0 )
+            ++r.open;
+    },
+    [](void *context, const pstld::trace::call &c) noexcept {
+        auto &r = Recorder::of(context);
+        std::lock_guard lock{r.mutex};
+        --r.open;
+        r.calls.push_back(c);
+    },
+    [](void *context, const pstld::trace::call &, size_t) noexcept {
+        auto &r = Recorder::of(context);
+        std::lock_guard lock{r.mutex};
+        ++r.chunk_begins;
+    },
+    [](void *context, const pstld::trace::call &, size_t) noexcept {
+        auto &r = Recorder::of(context);
+        std::lock_guard lock{r.mutex};
+        ++r.chunk_ends;
+    }};
+
+static std::string slurp(const char *path)
+{
+    std::ifstream in(path);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+static bool traced(Recorder &r, const char *algorithm, size_t elements)
+{
+    return r.open == 0 && r.calls.size() == 1 &&
+           std::strcmp(r.calls[0].algorithm, algorithm) == 0 &&
+           r.calls[0].elements == elements && r.chunk_begins == r.chunk_ends;
+}
+
+int main()
+{
+    using namespace pstld::execution;
+
+    InlinePool pool;
+    const pstld::executor exec = pstld::make_executor(pool);
+    const auto policy = par.on(exec).with(serial_below{0});
+
+    Recorder r;
+    pstld::trace::hooks hooks = g_hooks;
+    hooks.context = &r;
+    pstld::trace::set_hooks(&hooks);
+
+    std::vector<int> v(100'000);
+    std::iota(v.rbegin(), v.rend(), 0);
+
+    // a chunked call reports its chunks and runs each of them once
+    pstld::reduce(policy, v.begin(), v.end(), 0L);
+    if( !traced(r, "transform_reduce", v.size()) || r.calls[0].chunks < 2 ||
+        r.calls[0].workers == 0 || r.chunk_begins != r.calls[0].chunks )
+        return 1;
+
+    // the scans run their chunks twice
+    r.reset();
+    std::vector<long> out(v.size());
+    pstld::inclusive_scan(policy, v.begin(), v.end(), out.begin());
+    if( !traced(r, "transform_inclusive_scan", v.size()) || r.chunk_begins < r.calls[0].chunks )
+        return 1;
+
+    // sort and merge report the pieces they split the work into
+    r.reset();
+    pstld::sort(policy, v.begin(), v.end());
+    if( !traced(r, "sort", v.size()) || r.calls[0].workers == 0 || r.chunk_begins == 0 )
+        return 1;
+
+    r.reset();
+    std::iota(v.rbegin(), v.rend(), 0);
+    pstld::stable_sort(policy, v.begin(), v.end());
+    if( !traced(r, "stable_sort", v.size()) || r.calls[0].chunks < 2 ||
+        r.chunk_begins != r.calls[0].chunks )
+        return 1;
+
+    r.reset();
+    const auto mid = v.begin() + v.size() / 2;
+    pstld::merge(policy, v.begin(), mid, mid, v.end(), out.begin());
+    if( !traced(r, "merge", v.size()) || r.calls[0].workers == 0 || r.chunk_begins == 0 )
+        return 1;
+
+    // a call too small to go parallel is reported as serial
+    r.reset();
+    pstld::fill(par.on(exec).with(serial_below{1'000}), v.begin(), v.begin() + 10, 1);
+    if( !traced(r, "fill", 10) || r.calls[0].workers != 0 || r.chunk_begins != 0 )
+        return 1;
+
+    // nothing is reported without hooks
+    pstld::trace::set_hooks(nullptr);
+    r.reset();
+    pstld::reduce(policy, v.begin(), v.end(), 0L);
+    if( !r.calls.empty() || r.chunk_begins != 0 )
+        return 1;
+
+    // the recorder writes the calls and their chunks as a Chrome trace
+    const char *path = "pstld-tracing-test.json";
+    std::remove(path);
+    pstld::trace::start_recording();
+    std::iota(v.rbegin(), v.rend(), 0);
+    pstld::stable_sort(policy, v.begin(), v.end());
+    if( !pstld::trace::flush_recording(path) )
+        return 1;
+    const std::string first = slurp(path);
+    if( first.rfind("[\n", 0) != 0 || first.find("\"stable_sort\"") == std::string::npos ||
+        first.find("\"merge level\"") == std::string::npos ||
+        first.find("\"chunk\"") == std::string::npos )
+        return 1;
+
+    // a later flush appends to the same array, stopping keeps what was recorded so far
+    pstld::reduce(policy, v.begin(), v.end(), 0L);
+    pstld::trace::stop_recording();
+    pstld::fill(policy, v.begin(), v.end(), 1);
+    if( !pstld::trace::flush_recording(path) )
+        return 1;
+    const std::string second = slurp(path);
+    std::remove(path);
+    if( second.compare(0, first.size(), first) != 0 ||
+        second.find("\"transform_reduce\"") == std::string::npos ||
+        second.find("\"fill\"") != std::string::npos )
+        return 1;
+
+    // a thread which takes over the ring of an exited one gets a timeline of its own
+    pstld::trace::start_recording();
+    for( int i = 0; i != 2; ++i )
+        std::thread([&] { pstld::reduce(policy, v.begin(), v.end(), 0L); }).join();
+    pstld::trace::stop_recording();
+    if( !pstld::trace::flush_recording(path) )
+        return 1;
+    const std::string third = slurp(path);
+    std::remove(path);
+    std::set<std::string> tids;
+    const std::string call = "{\"name\":\"transform_reduce\"";
+    for( size_t pos = third.find(call); pos != std::string::npos; pos = third.find(call, pos + 1) ) {
+        const size_t tid = third.find("\"tid\":", pos) + 6;
+        tids.insert(third.substr(tid, third.find(',', tid) - tid));
+    }
+    if( tids.size() != 2 )
+        return 1;
+
+    return pstld::trace::flush_recording("/nonexistent-pstld-dir/trace.json");
+}
@@ -0,0 +1,64 @@
+#include <pstld/pstld.h>
+#include <atomic>
+#include <numeric>
+#include <vector>
+#include "../inline_pool.h"
+
+int main()
+{
+    using namespace pstld::execution;
+
+    InlinePool pool;
+    const pstld::executor exec = pstld::make_executor(pool);
+    const auto on_pool = par.on(exec);
+
+    std::vector<int> v(100'000);
+    std::iota(v.begin(), v.end(), 0);
+    const long expected = std::accumulate(v.begin(), v.end(), 0L);
+
+    // the defaults: 8 chunks per worker
+    if( pstld::reduce(on_pool, v.begin(), v.end(), 0L) != expected || pool.last_n != 32 )
+        return 1;
+
+    // fewer chunks per worker
+    if( pstld::reduce(on_pool.with(chunks_per_cpu{2}), v.begin(), v.end(), 0L) != expected ||
+        pool.last_n != 8 )
+        return 1;
+
+    // more chunks per worker
+    if( pstld::reduce(on_pool.with(chunks_per_cpu{64}), v.begin(), v.end(), 0L) != expected ||
+        pool.last_n != 256 )
+        return 1;
+
+    // the grain limits the number of chunks
+    if( pstld::reduce(on_pool.with(grain{25'000}), v.begin(), v.end(), 0L) != expected ||
+        pool.last_n != 4 )
+        return 1;
+
+    // below the cutoff nothing gets dispatched, above it the work is parallel again
+    const size_t bulks = pool.bulks;
+    const auto cutoff = on_pool.with(serial_below{200'000});
+    if( pstld::reduce(cutoff, v.begin(), v.end(), 0L) != expected || pool.bulks != bulks )
+        return 1;
+    std::vector<int> w(v.rbegin(), v.rend());
+    pstld::sort(cutoff, w.begin(), w.end());
+    pstld::stable_sort(cutoff, w.begin(), w.end());
+    if( !std::is_sorted(w.begin(), w.end()) || pool.bulks != bulks )
+        return 1;
+    if( pstld::reduce(on_pool.with(serial_below{1'000}), v.begin(), v.end(), 0L) != expected ||
+        pool.bulks == bulks )
+        return 1;
+
+    // sort and merge with a coarse grain still produce the right results
+    std::vector<int> x(v.rbegin(), v.rend());
+    pstld::sort(par.with(grain{10'000}), x.begin(), x.end());
+    if( !std::is_sorted(x.begin(), x.end()) )
+        return 1;
+    std::vector<int> y(v.rbegin(), v.rend());
+    pstld::stable_sort(par.with(grain{10'000}, chunks_per_cpu{1}), y.begin(), y.end());
+    if( y != x )
+        return 1;
+    std::vector<int> merged(x.size() * 2);
+    pstld::merge(par.with(grain{20'000}), x.begin(), x.end(), y.begin(), y.end(), merged.begin());
+    return std::is_sorted(merged.begin(), merged.end()) ? 0 : 1;
+}